@@ -0,0 +1,331 @@
+#include "compressed_bitset.h"
+#include <algorithm>
+#include <bit>
+
+namespace{
+
+using word_type = std::uint64_t;
+
+void set_range(std::vector<word_type>& words, std::uint32_t first, std::uint32_t last){
+    for(std::uint32_t i{first}; i <= last; ++i) // Runs are rarely converted back : keep it simple
+        words[i / 64] |= word_type{1} << (i % 64);
+}
+
+size_t count_words(const std::vector<word_type>& words){
+    size_t total {};
+    for(word_type word : words)
+        total += static_cast<size_t>(std::popcount(word));
+    return total;
+}
+
+bool contains(const Container& container, std::uint16_t low){
+    switch(container.kind){
+    case ContainerKind::array:
+        return std::binary_search(container.values.begin(), container.values.end(), low);
+    case ContainerKind::bitmap:
+        return (container.words[low / 64] >> (low % 64)) & 1;
+    case ContainerKind::runs:{
+        //Last run starting at or before low
+        size_t first {}, count {container.values.size() / 2};
+        while(count > 0){
+            size_t half = count / 2;
+            if(container.values[(first + half) * 2] <= low){
+                first += half + 1;
+                count -= half + 1;
+            }else{
+                count = half;
+            }
+        }
+        return first > 0 && low <= container.values[(first - 1) * 2 + 1];
+    }
+    }
+    return false;
+}
+
+//The same values, as a bitmap's words
+std::vector<word_type> bitmap_words(const Container& container){
+    if(container.kind == ContainerKind::bitmap)
+        return container.words;
+    std::vector<word_type> words(Container::BITMAP_WORDS);
+    if(container.kind == ContainerKind::array){
+        for(std::uint16_t low : container.values)
+            words[low / 64] |= word_type{1} << (low % 64);
+    }else{
+        for(size_t r{}; r < container.values.size(); r += 2)
+            set_range(words, container.values[r], container.values[r + 1]);
+    }
+    return words;
+}
+
+void to_bitmap(Container& container){
+    container.words = bitmap_words(container);
+    container.values = std::vector<std::uint16_t>(); // = {} would keep the capacity
+    container.kind = ContainerKind::bitmap;
+}
+
+void to_array(Container& container){
+    std::vector<std::uint16_t> values;
+    values.reserve(container.cardinality);
+    if(container.kind == ContainerKind::bitmap){
+        for(size_t w{}; w < Container::BITMAP_WORDS; ++w){
+            for(word_type word = container.words[w]; word; word &= word - 1)
+                values.push_back(static_cast<std::uint16_t>(w * 64 + std::countr_zero(word)));
+        }
+    }else if(container.kind == ContainerKind::runs){
+        for(size_t r{}; r < container.values.size(); r += 2){
+            for(std::uint32_t low = container.values[r]; low <= container.values[r + 1]; ++low)
+                values.push_back(static_cast<std::uint16_t>(low));
+        }
+    }else{
+        return;
+    }
+    container.values = std::move(values);
+    container.words = std::vector<word_type>();
+    container.kind = ContainerKind::array;
+}
+
+//Number of runs of consecutive values. In a bitmap, a run starts at every
+//set bit whose lower neighbour is clear : one shift and one popcount per word.
+size_t run_count(const Container& container){
+    switch(container.kind){
+    case ContainerKind::array:{
+        size_t runs {};
+        for(size_t i{}; i < container.values.size(); ++i)
+            if(i == 0 || container.values[i] != container.values[i - 1] + 1)
+                ++runs;
+        return runs;
+    }
+    case ContainerKind::bitmap:{
+        size_t runs {};
+        word_type carry {};
+        for(word_type word : container.words){
+            runs += static_cast<size_t>(std::popcount(word & ~((word << 1) | carry)));
+            carry = word >> 63;
+        }
+        return runs;
+    }
+    case ContainerKind::runs:
+        return container.values.size() / 2;
+    }
+    return 0;
+}
+
+void to_runs(Container& container){
+    if(container.kind == ContainerKind::runs)
+        return;
+    std::vector<std::uint16_t> runs;
+    runs.reserve(run_count(container) * 2);
+    auto append = [&runs](std::uint32_t low){
+        if(!runs.empty() && runs.back() + 1u == low)
+            runs.back() = static_cast<std::uint16_t>(low);
+        else{
+            runs.push_back(static_cast<std::uint16_t>(low));
+            runs.push_back(static_cast<std::uint16_t>(low));
+        }
+    };
+    if(container.kind == ContainerKind::array){
+        for(std::uint16_t low : container.values)
+            append(low);
+    }else{
+        for(size_t w{}; w < Container::BITMAP_WORDS; ++w){
+            for(word_type word = container.words[w]; word; word &= word - 1)
+                append(static_cast<std::uint32_t>(w * 64 + std::countr_zero(word)));
+        }
+    }
+    container.values = std::move(runs);
+    container.words = std::vector<word_type>();
+    container.kind = ContainerKind::runs;
+}
+
+//Smallest kind for the values in container
+void optimize(Container& container){
+    const size_t array_bytes = container.cardinality * sizeof(std::uint16_t);
+    const size_t bitmap_bytes = Container::BITMAP_WORDS * sizeof(word_type);
+    const size_t runs_bytes = run_count(container) * 2 * sizeof(std::uint16_t);
+
+    if(runs_bytes < std::min(array_bytes, bitmap_bytes))
+        to_runs(container);
+    else if(array_bytes <= bitmap_bytes)
+        to_array(container);
+    else
+        to_bitmap(container);
+    container.values.shrink_to_fit();
+}
+
+Container intersect(const Container& left, const Container& right){
+    Container result;
+    result.key = left.key;
+
+    if(left.kind == ContainerKind::array && right.kind == ContainerKind::array){
+        std::set_intersection(left.values.begin(), left.values.end(),
+                              right.values.begin(), right.values.end(),
+                              std::back_inserter(result.values));
+    }else if(left.kind == ContainerKind::array || right.kind == ContainerKind::array){
+        //Look every value of the array up in the other one
+        const Container& array = left.kind == ContainerKind::array ? left : right;
+        const Container& other = left.kind == ContainerKind::array ? right : left;
+        for(std::uint16_t low : array.values)
+            if(contains(other, low))
+                result.values.push_back(low);
+    }else if(left.kind == ContainerKind::runs && right.kind == ContainerKind::runs){
+        //Overlap of two sorted lists of intervals
+        size_t l {}, r {};
+        while(l < left.values.size() && r < right.values.size()){
+            const std::uint16_t start = std::max(left.values[l], right.values[r]);
+            const std::uint16_t last = std::min(left.values[l + 1], right.values[r + 1]);
+            if(start <= last){
+                result.values.push_back(start);
+                result.values.push_back(last);
+                result.cardinality += last - start + 1u;
+            }
+            if(left.values[l + 1] < right.values[r + 1])
+                l += 2;
+            else
+                r += 2;
+        }
+        result.kind = ContainerKind::runs;
+        return result;
+    }else{
+        //Bitmaps, or a bitmap and runs : 1024 ANDs
+        result.words = bitmap_words(left);
+        const std::vector<word_type> other = bitmap_words(right);
+        for(size_t w{}; w < Container::BITMAP_WORDS; ++w)
+            result.words[w] &= other[w];
+        result.kind = ContainerKind::bitmap;
+        result.cardinality = static_cast<std::uint32_t>(count_words(result.words));
+        if(result.cardinality <= Container::ARRAY_MAX)
+            to_array(result);
+        return result;
+    }
+    result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    return result;
+}
+
+} // namespace
+
+
+CompressedBitset CompressedBitset::from_bitset(const dynamic_bitset& bits){
+    //Copy the words of each chunk of 65536 bits straight into a bitmap
+    CompressedBitset result;
+    const auto& words = bits.words();
+    for(size_t first{}; first < words.size(); first += Container::BITMAP_WORDS){
+        const size_t last = std::min(first + Container::BITMAP_WORDS, words.size());
+        Container container;
+        container.key = static_cast<std::uint16_t>(first / Container::BITMAP_WORDS);
+        container.kind = ContainerKind::bitmap;
+        container.words.assign(Container::BITMAP_WORDS, 0);
+        std::copy(words.begin() + static_cast<std::ptrdiff_t>(first),
+                  words.begin() + static_cast<std::ptrdiff_t>(last), container.words.begin());
+        container.cardinality = static_cast<std::uint32_t>(count_words(container.words));
+        if(container.cardinality == 0)
+            continue;
+        ::optimize(container);
+        result.m_containers.push_back(std::move(container));
+    }
+    return result;
+}
+
+dynamic_bitset CompressedBitset::to_bitset(size_t size) const{
+    dynamic_bitset result(size);
+    for_each([&result, size](std::uint32_t value){
+        if(value < size)
+            result.set(value);
+    });
+    return result;
+}
+
+Container* CompressedBitset::find(std::uint16_t key){
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+                               [](const Container& container, std::uint16_t k){ return container.key < k; });
+    return (it != m_containers.end() && it->key == key) ? &*it : nullptr;
+}
+
+const Container* CompressedBitset::find(std::uint16_t key) const{
+    return const_cast<CompressedBitset*>(this)->find(key);
+}
+
+void CompressedBitset::add(std::uint32_t value){
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto low = static_cast<std::uint16_t>(value & 0xFFFF);
+
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+                               [](const Container& container, std::uint16_t k){ return container.key < k; });
+    if(it == m_containers.end() || it->key != key){
+        it = m_containers.insert(it, Container{});
+        it->key = key;
+    }
+    Container& container = *it;
+
+    if(container.kind == ContainerKind::runs){
+        if(::contains(container, low))
+            return;
+        to_bitmap(container); // Inserting into runs means splitting or merging them
+    }
+
+    if(container.kind == ContainerKind::array){
+        auto position = std::lower_bound(container.values.begin(), container.values.end(), low);
+        if(position != container.values.end() && *position == low)
+            return;
+        if(container.cardinality < Container::ARRAY_MAX){
+            container.values.insert(position, low);
+            ++container.cardinality;
+            return;
+        }
+        to_bitmap(container);
+    }
+
+    word_type& word = container.words[low / 64];
+    const word_type bit = word_type{1} << (low % 64);
+    if(!(word & bit)){
+        word |= bit;
+        ++container.cardinality;
+    }
+}
+
+bool CompressedBitset::contains(std::uint32_t value) const{
+    const Container* container = find(static_cast<std::uint16_t>(value >> 16));
+    return container && ::contains(*container, static_cast<std::uint16_t>(value & 0xFFFF));
+}
+
+size_t CompressedBitset::count() const{
+    size_t total {};
+    for(const Container& container : m_containers)
+        total += container.cardinality;
+    return total;
+}
+
+void CompressedBitset::optimize(){
+    for(Container& container : m_containers)
+        ::optimize(container);
+}
+
+CompressedBitset operator&(const CompressedBitset& left, const CompressedBitset& right){
+    //Only chunks present on both sides can have values in common
+    CompressedBitset result;
+    auto l = left.m_containers.begin();
+    auto r = right.m_containers.begin();
+    while(l != left.m_containers.end() && r != right.m_containers.end()){
+        if(l->key < r->key)
+            ++l;
+        else if(r->key < l->key)
+            ++r;
+        else{
+            Container container = intersect(*l++, *r++);
+            if(container.cardinality > 0)
+                result.m_containers.push_back(std::move(container));
+        }
+    }
+    return result;
+}
+
+size_t CompressedBitset::memory_bytes() const{
+    size_t total = m_containers.capacity() * sizeof(Container);
+    for(const Container& container : m_containers)
+        total += container.memory_bytes();
+    return total;
+}
+
+size_t CompressedBitset::container_count(ContainerKind kind) const{
+    return static_cast<size_t>(std::count_if(m_containers.begin(), m_containers.end(),
+                                             [kind](const Container& container){ return container.kind == kind; }));
+}
@@ -0,0 +1,94 @@
+#ifndef COMPRESSED_BITSET_H
+#define COMPRESSED_BITSET_H
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "dynamic_bitset.h"
+
+//A set of 32 bit values, stored the way roaring bitmaps do it. A
+//dynamic_bitset over 4 billion possible ids is 512 MB, however few are set.
+//Here the values are split into chunks of 65536 by their upper 16 bits, and
+//each chunk that has values picks the smallest of three containers for the
+//lower 16 bits :
+//  - array  : sorted list of values, 2 bytes each. For sparse chunks.
+//  - bitmap : 65536 bits, 8 KB whatever the count. For dense chunks.
+//  - runs   : [start, last] pairs, 4 bytes each. For long stretches of ids.
+//Chunks with no values take no memory at all.
+
+enum class ContainerKind : std::uint8_t { array, bitmap, runs };
+
+struct Container
+{
+    static constexpr size_t BITMAP_WORDS = 65536 / 64;
+    static constexpr size_t ARRAY_MAX = 4096; // Past this, a bitmap is smaller
+
+    std::uint16_t key {};                 // Upper 16 bits of the values
+    ContainerKind kind {ContainerKind::array};
+    std::uint32_t cardinality {};
+    std::vector<std::uint16_t> values;    // array : sorted values. runs : start, last, start, last, ...
+    std::vector<std::uint64_t> words;     // bitmap : BITMAP_WORDS words
+
+    size_t memory_bytes() const{
+        return values.capacity() * sizeof(std::uint16_t) + words.capacity() * sizeof(std::uint64_t);
+    }
+};
+
+
+class CompressedBitset
+{
+public:
+    CompressedBitset() = default;
+
+    //The set bits of bits, as values. bits.size() must be at most 2^32.
+    static CompressedBitset from_bitset(const dynamic_bitset& bits);
+    dynamic_bitset to_bitset(size_t size) const;
+
+    void add(std::uint32_t value);
+    bool contains(std::uint32_t value) const;
+    size_t count() const;
+
+    //Converts every container to its smallest kind. add() only switches
+    //from array to bitmap, never to runs : call this after bulk inserts.
+    void optimize();
+
+    friend CompressedBitset operator&(const CompressedBitset& left, const CompressedBitset& right);
+
+    size_t memory_bytes() const;
+    size_t container_count(ContainerKind kind) const;
+
+    //Calls function(value) for every value, in increasing order
+    template <typename Function>
+    void for_each(Function function) const{
+        for(const Container& container : m_containers){
+            const std::uint32_t high = std::uint32_t{container.key} << 16;
+            switch(container.kind){
+            case ContainerKind::array:
+                for(std::uint16_t low : container.values)
+                    function(high | low);
+                break;
+            case ContainerKind::bitmap:
+                for(size_t w{}; w < Container::BITMAP_WORDS; ++w){
+                    for(std::uint64_t word = container.words[w]; word; word &= word - 1)
+                        function(high | static_cast<std::uint32_t>(w * 64 + std::countr_zero(word)));
+                }
+                break;
+            case ContainerKind::runs:
+                for(size_t r{}; r < container.values.size(); r += 2){
+                    for(std::uint32_t low = container.values[r]; low <= container.values[r + 1]; ++low)
+                        function(high | low);
+                }
+                break;
+            }
+        }
+    }
+
+private:
+    Container* find(std::uint16_t key);
+    const Container* find(std::uint16_t key) const;
+
+private:
+    std::vector<Container> m_containers; // Sorted by key
+};
+
+#endif // COMPRESSED_BITSET_H
@@ -0,0 +1,170 @@
+#include "dynamic_bitset.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DYNAMIC_BITSET_X86 1
+#endif
+
+namespace{
+
+using word_type = dynamic_bitset::word_type;
+
+size_t word_count(size_t bits){
+    return (bits + dynamic_bitset::WORD_BITS - 1) / dynamic_bitset::WORD_BITS;
+}
+
+//Without -mpopcnt the compiler can't assume the instruction exists, and
+//std::popcount becomes a dozen shifts and masks. These copies are compiled
+//for CPUs that have it, and picked at run time.
+size_t count_words(const word_type* words, size_t count){
+    size_t total {};
+    for(size_t i{}; i < count; ++i)
+        total += static_cast<size_t>(std::popcount(words[i]));
+    return total;
+}
+
+size_t count_and_words(const word_type* left, const word_type* right, size_t count){
+    size_t total {};
+    for(size_t i{}; i < count; ++i)
+        total += static_cast<size_t>(std::popcount(left[i] & right[i]));
+    return total;
+}
+
+#ifdef DYNAMIC_BITSET_X86
+__attribute__((target("popcnt")))
+size_t count_words_popcnt(const word_type* words, size_t count){
+    size_t total {};
+    for(size_t i{}; i < count; ++i)
+        total += static_cast<size_t>(std::popcount(words[i]));
+    return total;
+}
+
+__attribute__((target("popcnt")))
+size_t count_and_words_popcnt(const word_type* left, const word_type* right, size_t count){
+    size_t total {};
+    for(size_t i{}; i < count; ++i)
+        total += static_cast<size_t>(std::popcount(left[i] & right[i]));
+    return total;
+}
+
+bool has_popcnt(){
+    static const bool supported = []{
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt") != 0;
+    }();
+    return supported;
+}
+#endif
+
+} // namespace
+
+
+dynamic_bitset::dynamic_bitset(size_t size, bool value)
+    : m_words(word_count(size), value ? ~word_type{0} : word_type{0}), m_size(size)
+{
+    clear_unused_bits();
+}
+
+void dynamic_bitset::resize(size_t size, bool value){
+    const size_t old_size = m_size;
+    m_words.resize(word_count(size), value ? ~word_type{0} : word_type{0});
+    m_size = size;
+    if(value){
+        //The old last word had its unused bits cleared : set them
+        for(size_t i{old_size}; i < size && i % WORD_BITS != 0; ++i)
+            set(i);
+    }
+    clear_unused_bits();
+}
+
+void dynamic_bitset::clear_unused_bits(){
+    const size_t used = m_size % WORD_BITS;
+    if(used != 0)
+        m_words.back() &= (word_type{1} << used) - 1;
+}
+
+dynamic_bitset& dynamic_bitset::set(){
+    for(word_type& word : m_words)
+        word = ~word_type{0};
+    clear_unused_bits();
+    return *this;
+}
+
+dynamic_bitset& dynamic_bitset::reset(){
+    for(word_type& word : m_words)
+        word = 0;
+    return *this;
+}
+
+dynamic_bitset& dynamic_bitset::flip(){
+    for(word_type& word : m_words)
+        word = ~word;
+    clear_unused_bits();
+    return *this;
+}
+
+size_t dynamic_bitset::count() const{
+#ifdef DYNAMIC_BITSET_X86
+    if(has_popcnt())
+        return count_words_popcnt(m_words.data(), m_words.size());
+#endif
+    return count_words(m_words.data(), m_words.size());
+}
+
+size_t count_and(const dynamic_bitset& left, const dynamic_bitset& right){
+#ifdef DYNAMIC_BITSET_X86
+    if(has_popcnt())
+        return count_and_words_popcnt(left.m_words.data(), right.m_words.data(), left.m_words.size());
+#endif
+    return count_and_words(left.m_words.data(), right.m_words.data(), left.m_words.size());
+}
+
+bool dynamic_bitset::any() const{
+    for(word_type word : m_words)
+        if(word)
+            return true;
+    return false;
+}
+
+size_t dynamic_bitset::find_next(size_t from) const{
+    if(from >= m_size)
+        return npos;
+    size_t w = from / WORD_BITS;
+    word_type word = m_words[w] & (~word_type{0} << (from % WORD_BITS)); // Drop bits before from
+    while(!word){
+        if(++w == m_words.size())
+            return npos;
+        word = m_words[w];
+    }
+    return w * WORD_BITS + static_cast<size_t>(std::countr_zero(word)); // tzcnt / bsf
+}
+
+//Plain loops over words : the compiler vectorizes them
+dynamic_bitset& dynamic_bitset::operator&=(const dynamic_bitset& other){
+    for(size_t i{}; i < m_words.size(); ++i)
+        m_words[i] &= other.m_words[i];
+    return *this;
+}
+
+dynamic_bitset& dynamic_bitset::operator|=(const dynamic_bitset& other){
+    for(size_t i{}; i < m_words.size(); ++i)
+        m_words[i] |= other.m_words[i];
+    return *this;
+}
+
+dynamic_bitset& dynamic_bitset::operator^=(const dynamic_bitset& other){
+    for(size_t i{}; i < m_words.size(); ++i)
+        m_words[i] ^= other.m_words[i];
+    return *this;
+}
+
+dynamic_bitset& dynamic_bitset::and_not(const dynamic_bitset& other){
+    for(size_t i{}; i < m_words.size(); ++i)
+        m_words[i] &= ~other.m_words[i];
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& out, const dynamic_bitset& operand){
+    for(size_t i{operand.size()}; i > 0; --i)
+        out << (operand.test(i - 1) ? '1' : '0');
+    return out;
+}
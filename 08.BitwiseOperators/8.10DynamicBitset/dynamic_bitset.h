@@ -0,0 +1,101 @@
+#ifndef DYNAMIC_BITSET_H
+#define DYNAMIC_BITSET_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+//Like std::bitset, with the size chosen at run time. Bits are kept in 64
+//bit words, so set operations work on 64 bits per instruction, counting
+//uses the popcnt instruction, and searching skips over whole zero words.
+//Bit i is bit ( i % 64 ) of word i / 64. Bits past size() in the last
+//word are always 0.
+class dynamic_bitset
+{
+public:
+    using word_type = std::uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    dynamic_bitset() = default;
+    explicit dynamic_bitset(size_t size, bool value = false);
+
+    size_t size() const { return m_size; }
+    void resize(size_t size, bool value = false);
+
+    bool test(size_t index) const{
+        return (m_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+    }
+    bool operator[](size_t index) const { return test(index); }
+
+    dynamic_bitset& set(size_t index){
+        m_words[index / WORD_BITS] |= word_type{1} << (index % WORD_BITS);
+        return *this;
+    }
+    dynamic_bitset& reset(size_t index){
+        m_words[index / WORD_BITS] &= ~(word_type{1} << (index % WORD_BITS));
+        return *this;
+    }
+    dynamic_bitset& flip(size_t index){
+        m_words[index / WORD_BITS] ^= word_type{1} << (index % WORD_BITS);
+        return *this;
+    }
+    dynamic_bitset& set(size_t index, bool value) { return value ? set(index) : reset(index); }
+
+    dynamic_bitset& set();   // All bits
+    dynamic_bitset& reset();
+    dynamic_bitset& flip();
+
+    size_t count() const;    // Number of set bits
+    bool any() const;
+    bool none() const { return !any(); }
+
+    //Position of the first set bit at or after from, or npos
+    size_t find_first() const { return find_next(0); }
+    size_t find_next(size_t from) const;
+
+    //Word by word set algebra. Both sides must have the same size.
+    dynamic_bitset& operator&=(const dynamic_bitset& other);
+    dynamic_bitset& operator|=(const dynamic_bitset& other);
+    dynamic_bitset& operator^=(const dynamic_bitset& other);
+    dynamic_bitset& and_not(const dynamic_bitset& other); // this & ~other
+
+    //count() of ( left & right ), without building it
+    friend size_t count_and(const dynamic_bitset& left, const dynamic_bitset& right);
+
+    bool operator==(const dynamic_bitset&) const = default;
+
+    //Raw access, for code working a word at a time ( rank_select, ... )
+    const std::vector<word_type>& words() const { return m_words; }
+    size_t memory_bytes() const { return m_words.capacity() * sizeof(word_type); }
+
+    //Calls function(index) for every set bit, in order
+    template <typename Function>
+    void for_each_set(Function function) const{
+        for(size_t w{}; w < m_words.size(); ++w){
+            word_type word = m_words[w];
+            while(word){
+                function(w * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+                word &= word - 1; // Clear the lowest set bit
+            }
+        }
+    }
+
+private:
+    void clear_unused_bits();
+
+private:
+    std::vector<word_type> m_words;
+    size_t m_size {};
+};
+
+inline dynamic_bitset operator&(dynamic_bitset left, const dynamic_bitset& right) { return left &= right; }
+inline dynamic_bitset operator|(dynamic_bitset left, const dynamic_bitset& right) { return left |= right; }
+inline dynamic_bitset operator^(dynamic_bitset left, const dynamic_bitset& right) { return left ^= right; }
+
+//Bit 0 last, like std::bitset
+std::ostream& operator<<(std::ostream& out, const dynamic_bitset& operand);
+
+#endif // DYNAMIC_BITSET_H
@@ -0,0 +1,161 @@
+#include <iostream>
+#include <bitset>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include "dynamic_bitset.h"
+#include "rank_select.h"
+#include "compressed_bitset.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Random ids in [0, universe), each present with the given probability
+dynamic_bitset random_ids(size_t universe, double density, std::uint32_t seed){
+    dynamic_bitset result(universe);
+    std::mt19937_64 generator {seed};
+    std::geometric_distribution<size_t> gap {density};
+    for(size_t id = gap(generator); id < universe; id += gap(generator) + 1)
+        result.set(id);
+    return result;
+}
+
+std::vector<bool> to_vector_bool(const dynamic_bitset& bits){
+    std::vector<bool> result(bits.size());
+    bits.for_each_set([&result](size_t index){ result[index] = true; });
+    return result;
+}
+
+
+int main(int argc, char** argv){
+
+    //Same output as std::bitset, but the size is a run time value
+    unsigned short int data {15};
+    dynamic_bitset flags(16);
+    for(size_t i{}; i < flags.size(); ++i)
+        flags.set(i, (data >> i) & 1);
+    std::cout << "std::bitset     : " << std::bitset<16>(data) << std::endl;
+    std::cout << "dynamic_bitset  : " << flags << std::endl;
+
+    dynamic_bitset mask(16);
+    mask.set(1).set(3).set(5).set(7);
+    std::cout << "mask            : " << mask << std::endl;
+    std::cout << "flags & mask    : " << (flags & mask) << std::endl;
+    std::cout << "flags | mask    : " << (flags | mask) << std::endl;
+    std::cout << "flags ^ mask    : " << (flags ^ mask) << std::endl;
+    std::cout << "flags and_not mask : " << dynamic_bitset(flags).and_not(mask) << std::endl;
+    std::cout << "count : " << (flags | mask).count() << ", first set in mask : " << mask.find_first()
+              << ", next after 3 : " << mask.find_next(4) << std::endl;
+
+    RankSelect index(mask);
+    std::cout << "rank(6) : " << index.rank(6) << " (bits 1, 3 and 5 come before 6)" << std::endl;
+    std::cout << "select(2) : " << index.select(2) << " (the third set bit)" << std::endl;
+
+    CompressedBitset sparse;
+    for(std::uint32_t id : {7u, 70'000u, 70'001u, 70'002u, 4'000'000'000u})
+        sparse.add(id);
+    std::cout << "compressed : " << sparse.count() << " ids in " << sparse.memory_bytes() << " bytes, contains 70001 : "
+              << std::boolalpha << sparse.contains(70'001) << ", contains 8 : " << sparse.contains(8) << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : intersecting two sets of user ids. Default 200M possible
+    //ids, can be changed from the command line.
+    size_t universe = (argc > 1) ? std::stoul(argv[1]) : 200'000'000;
+    dynamic_bitset left = random_ids(universe, 0.3, 1);
+    dynamic_bitset right = random_ids(universe, 0.3, 2);
+    std::cout << universe << " bits, " << left.count() << " and " << right.count() << " set" << std::endl;
+
+    size_t result_count {};
+    double bitset_ms = time_ms([&]{ result_count = (left & right).count(); });
+    double fused_ms = time_ms([&]{ result_count = count_and(left, right); });
+    std::cout << "dynamic_bitset & then count : " << bitset_ms << " ms (" << result_count << ")" << std::endl;
+    std::cout << "count_and, no temporary : " << fused_ms << " ms" << std::endl;
+
+    std::vector<bool> left_bools = to_vector_bool(left);
+    std::vector<bool> right_bools = to_vector_bool(right);
+    double bools_ms = time_ms([&]{
+        std::vector<bool> both(universe);
+        for(size_t i{}; i < universe; ++i)
+            both[i] = left_bools[i] && right_bools[i];
+        result_count = static_cast<size_t>(std::count(both.begin(), both.end(), true));
+    });
+    std::cout << "std::vector<bool> : " << bools_ms << " ms (" << result_count << ")" << std::endl;
+
+    //std::set takes ~40 bytes per id : try it on a smaller universe, and scale
+    size_t set_universe = std::min<size_t>(universe, 2'000'000);
+    std::set<size_t> left_set, right_set;
+    for(size_t i{}; i < set_universe; ++i){
+        if(left[i]) left_set.insert(i);
+        if(right[i]) right_set.insert(i);
+    }
+    double set_ms = time_ms([&]{
+        std::vector<size_t> both;
+        std::set_intersection(left_set.begin(), left_set.end(), right_set.begin(), right_set.end(),
+                              std::back_inserter(both));
+        result_count = both.size();
+    });
+    std::cout << "std::set, first " << set_universe << " ids : " << set_ms << " ms, about "
+              << set_ms * static_cast<double>(universe) / static_cast<double>(set_universe) << " ms for all" << std::endl;
+
+    //Scanning the result, a word at a time
+    dynamic_bitset both = left & right;
+    size_t visited {};
+    double scan_ms = time_ms([&]{
+        for(size_t id = both.find_first(); id != dynamic_bitset::npos; id = both.find_next(id + 1))
+            ++visited;
+    });
+    std::cout << "find_next over " << visited << " ids : " << scan_ms << " ms" << std::endl;
+
+    //Rank / select : the position of the k-th id, and the number of ids before a position
+    RankSelect both_index(both);
+    const size_t queries {1'000'000};
+    std::mt19937_64 generator {3};
+    size_t checksum {};
+    double rank_ms = time_ms([&]{
+        for(size_t q{}; q < queries; ++q)
+            checksum += both_index.rank(generator() % universe);
+    });
+    double select_ms = time_ms([&]{
+        for(size_t q{}; q < queries; ++q)
+            checksum += both_index.select(generator() % both_index.count());
+    });
+    std::cout << queries << " rank : " << rank_ms << " ms, " << queries << " select : " << select_ms
+              << " ms, index " << both_index.memory_bytes() / 1024 << " KB (checksum " << checksum % 1000 << ")" << std::endl;
+
+    //Sparse sets : few ids, or long stretches of consecutive ids
+    dynamic_bitset few = random_ids(universe, 0.001, 4);
+    dynamic_bitset stretches(universe);
+    for(size_t start{}; start + 50'000 < universe; start += 1'000'000)
+        for(size_t id{start}; id < start + 50'000; ++id)
+            stretches.set(id);
+
+    CompressedBitset few_compressed = CompressedBitset::from_bitset(few);
+    CompressedBitset stretches_compressed = CompressedBitset::from_bitset(stretches);
+    std::cout << "sparse ids : " << few.memory_bytes() / 1024 << " KB as dynamic_bitset, "
+              << few_compressed.memory_bytes() / 1024 << " KB compressed ("
+              << few_compressed.container_count(ContainerKind::array) << " arrays)" << std::endl;
+    std::cout << "stretches : " << stretches.memory_bytes() / 1024 << " KB as dynamic_bitset, "
+              << stretches_compressed.memory_bytes() / 1024 << " KB compressed ("
+              << stretches_compressed.container_count(ContainerKind::runs) << " runs containers)" << std::endl;
+
+    size_t compressed_count {};
+    double compressed_ms = time_ms([&]{ compressed_count = (few_compressed & stretches_compressed).count(); });
+    double dense_ms = time_ms([&]{ result_count = count_and(few, stretches); });
+    std::cout << "sparse & stretches : compressed " << compressed_ms << " ms (" << compressed_count << "), dynamic_bitset "
+              << dense_ms << " ms (" << result_count << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "rank_select.h"
+#include <algorithm>
+#include <bit>
+
+namespace{
+
+//Position of the k-th set bit in word, which has more than k bits set.
+//Clearing the lowest set bit k times leaves the wanted one lowest.
+unsigned select_in_word(std::uint64_t word, size_t k){
+    for(; k > 0; --k)
+        word &= word - 1;
+    return static_cast<unsigned>(std::countr_zero(word));
+}
+
+} // namespace
+
+
+RankSelect::RankSelect(const dynamic_bitset& bits)
+    : m_bits(&bits)
+{
+    const auto& words = bits.words();
+    const size_t block_count = (words.size() + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    m_blocks.reserve(block_count + 1);
+
+    std::uint64_t running {};
+    for(size_t w{}; w < words.size(); ++w){
+        if(w % BLOCK_WORDS == 0)
+            m_blocks.push_back(running);
+        const auto in_word = static_cast<std::uint64_t>(std::popcount(words[w]));
+        //Set bits number running to running + in_word - 1 live in this block
+        while(m_samples.size() * SELECT_SAMPLE < running + in_word)
+            m_samples.push_back(static_cast<std::uint32_t>(w / BLOCK_WORDS));
+        running += in_word;
+    }
+    m_blocks.push_back(running);
+    m_samples.push_back(static_cast<std::uint32_t>(m_blocks.size() - 1));
+}
+
+size_t RankSelect::rank(size_t pos) const{
+    pos = std::min(pos, m_bits->size());
+    const auto& words = m_bits->words();
+    const size_t word_index = pos / dynamic_bitset::WORD_BITS;
+    const size_t block = word_index / BLOCK_WORDS;
+
+    size_t result = m_blocks[block];
+    for(size_t w{block * BLOCK_WORDS}; w < word_index; ++w)
+        result += static_cast<size_t>(std::popcount(words[w]));
+
+    const size_t bit = pos % dynamic_bitset::WORD_BITS;
+    if(bit != 0)
+        result += static_cast<size_t>(std::popcount(words[word_index] & ((std::uint64_t{1} << bit) - 1)));
+    return result;
+}
+
+size_t RankSelect::select(size_t k) const{
+    if(k >= count())
+        return dynamic_bitset::npos;
+
+    //Last block that starts with at most k bits before it. It lies between
+    //the blocks of the samples on either side of k.
+    const size_t sample = k / SELECT_SAMPLE;
+    auto after = std::upper_bound(m_blocks.begin() + m_samples[sample] + 1,
+                                  m_blocks.begin() + m_samples[sample + 1] + 1, k);
+    const size_t block = static_cast<size_t>(after - m_blocks.begin()) - 1;
+    k -= m_blocks[block];
+
+    const auto& words = m_bits->words();
+    for(size_t w{block * BLOCK_WORDS}; ; ++w){
+        const size_t in_word = static_cast<size_t>(std::popcount(words[w]));
+        if(k < in_word)
+            return w * dynamic_bitset::WORD_BITS + select_in_word(words[w], k);
+        k -= in_word;
+    }
+}
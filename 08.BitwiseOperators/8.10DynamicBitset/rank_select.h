@@ -0,0 +1,42 @@
+#ifndef RANK_SELECT_H
+#define RANK_SELECT_H
+
+#include <cstdint>
+#include <vector>
+#include "dynamic_bitset.h"
+
+//Answers two questions about a bitset that no longer changes :
+//    rank(pos)  : how many bits are set before position pos
+//    select(k)  : position of the k-th set bit ( k from 0 )
+//Counting from the start every time is O(n). Instead the number of set
+//bits before every block of 512 bits ( 8 words, one cache line ) is stored :
+//rank is one table lookup plus at most 8 popcounts. For select, the block
+//holding every 8192nd set bit is remembered too, so the binary search over the
+//table only covers the few blocks between two samples. The tables cost a
+//little over 64 bits per 512, 12.5% of the bitset.
+//The index points into the bitset : it must outlive the index, and be
+//rebuilt after it changes.
+class RankSelect
+{
+public:
+    static constexpr size_t BLOCK_WORDS = 8;
+    static constexpr size_t BLOCK_BITS = BLOCK_WORDS * dynamic_bitset::WORD_BITS;
+    static constexpr size_t SELECT_SAMPLE = 8192;
+
+    explicit RankSelect(const dynamic_bitset& bits);
+
+    size_t rank(size_t pos) const;     // Set bits in [0, pos)
+    size_t select(size_t k) const;     // dynamic_bitset::npos if k >= count()
+    size_t count() const { return m_blocks.back(); }
+
+    size_t memory_bytes() const{
+        return m_blocks.capacity() * sizeof(std::uint64_t) + m_samples.capacity() * sizeof(std::uint32_t);
+    }
+
+private:
+    const dynamic_bitset* m_bits;
+    std::vector<std::uint64_t> m_blocks; // m_blocks[b] : set bits before block b, plus the total at the end
+    std::vector<std::uint32_t> m_samples; // m_samples[j] : block holding set bit j * SELECT_SAMPLE
+};
+
+#endif // RANK_SELECT_H
@@ -0,0 +1,99 @@
+#ifndef BITFIELD_H
+#define BITFIELD_H
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+//Packed fields declared once, at compile time, instead of masks and shifts
+//written by hand at every use :
+//    struct Red   : bit_field<24, 8> {};   // 8 bits, starting at bit 24
+//    struct Green : bit_field<16, 8> {};
+//    ...
+//    using RgbaLayout = bit_layout<unsigned int, Red, Green, Blue, Alpha>;
+//
+//    bitfield<RgbaLayout> color {0xAABCDE00};
+//    color.get<Green>();      // 0xBC
+//    color.set<Alpha>(0x80);
+//The compiler works out the masks and shifts : getters and setters are a
+//shift and a mask, no branches. Fields that overlap, don't fit in the
+//storage, or don't belong to the layout are compile time errors.
+
+template <unsigned Offset, unsigned Width, typename Value = unsigned>
+struct bit_field
+{
+    static_assert(Width > 0, "A field needs at least one bit");
+    static constexpr unsigned offset = Offset;
+    static constexpr unsigned width = Width;
+    using value_type = Value;
+
+    //The field's bits, in a Storage value
+    template <std::unsigned_integral Storage>
+    static constexpr Storage mask(){
+        constexpr Storage low_bits = Width >= sizeof(Storage) * 8
+            ? static_cast<Storage>(~Storage{0})
+            : static_cast<Storage>((Storage{1} << Width) - 1);
+        return static_cast<Storage>(low_bits << Offset);
+    }
+};
+
+template <std::unsigned_integral Storage, typename... Fields>
+struct bit_layout
+{
+    using storage_type = Storage;
+
+    static_assert(((Fields::offset + Fields::width <= sizeof(Storage) * 8) && ...),
+                  "A field doesn't fit in the storage type");
+    static_assert((std::popcount(Fields::template mask<Storage>()) + ... + 0) ==
+                      std::popcount(static_cast<Storage>((Fields::template mask<Storage>() | ... | 0))),
+                  "Two fields share bits");
+
+    template <typename Field>
+    static constexpr bool contains = (std::is_same_v<Field, Fields> || ...);
+};
+
+
+template <typename Layout>
+class bitfield
+{
+public:
+    using storage_type = typename Layout::storage_type;
+
+    constexpr bitfield() = default;
+    constexpr explicit bitfield(storage_type bits) : m_bits(bits) {}
+
+    template <typename Field>
+    constexpr typename Field::value_type get() const{
+        static_assert(Layout::template contains<Field>, "Field is not part of this layout");
+        constexpr storage_type mask = Field::template mask<storage_type>();
+        return static_cast<typename Field::value_type>((m_bits & mask) >> Field::offset);
+    }
+
+    //Bits of value that don't fit in the field are dropped
+    template <typename Field>
+    constexpr bitfield& set(typename Field::value_type value){
+        static_assert(Layout::template contains<Field>, "Field is not part of this layout");
+        constexpr storage_type mask = Field::template mask<storage_type>();
+        m_bits = static_cast<storage_type>((m_bits & ~mask) |
+                                           ((static_cast<storage_type>(value) << Field::offset) & mask));
+        return *this;
+    }
+
+    //A copy with one field changed
+    template <typename Field>
+    constexpr bitfield with(typename Field::value_type value) const{
+        bitfield copy {*this};
+        copy.template set<Field>(value);
+        return copy;
+    }
+
+    constexpr storage_type raw() const { return m_bits; }
+
+    constexpr bool operator==(const bitfield&) const = default;
+
+private:
+    storage_type m_bits {};
+};
+
+#endif // BITFIELD_H
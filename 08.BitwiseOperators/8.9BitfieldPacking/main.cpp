@@ -0,0 +1,109 @@
+#include <iostream>
+#include <iomanip>
+#include <bitset>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include "bitfield.h"
+#include "rgba.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//The flags of 8.6Masks, as one bit fields of an unsigned char
+struct Visible  : bit_field<0, 1, bool> {};
+struct Selected : bit_field<1, 1, bool> {};
+struct Layer    : bit_field<4, 3> {}; // 0 to 7
+using FlagsLayout = bit_layout<unsigned char, Visible, Selected, Layer>;
+
+//Fields can't share bits, or stick out of the storage :
+//using Broken = bit_layout<unsigned char, Visible, bit_field<0, 2>>; // Compiler error
+//using TooBig = bit_layout<unsigned char, bit_field<4, 8>>;           // Compiler error
+
+//Everything works at compile time
+constexpr Rgba orange = Rgba{}.with<Red>(0xFF).with<Green>(0xA5).with<Alpha>(0xFF);
+static_assert(orange.raw() == 0xFFA500FF);
+static_assert(Rgba{0xAABCDE00}.get<Blue>() == 0xDE);
+
+//Unpacking the way 8.8 does it : masks and shifts by hand
+[[gnu::noinline]] void unpack_by_hand(const std::vector<std::uint32_t>& pixels, RgbaPlanes planes){
+    const unsigned int red_mask {0xFF000000};
+    const unsigned int green_mask {0x00FF0000};
+    const unsigned int blue_mask {0x0000FF00};
+    const unsigned int alpha_mask {0x000000FF};
+    for(size_t i{}; i < pixels.size(); ++i){
+        planes.red[i] = static_cast<std::uint8_t>((pixels[i] & red_mask) >> 24);
+        planes.green[i] = static_cast<std::uint8_t>((pixels[i] & green_mask) >> 16);
+        planes.blue[i] = static_cast<std::uint8_t>((pixels[i] & blue_mask) >> 8);
+        planes.alpha[i] = static_cast<std::uint8_t>((pixels[i] & alpha_mask) >> 0);
+    }
+}
+
+
+int main(int argc, char** argv){
+
+    Rgba my_color {0xAABCDE00};
+	std::cout << std::dec << std::showbase << std::endl;
+    std::cout << "Red is : " << my_color.get<Red>() << std::endl;
+    std::cout << "Green is : " << my_color.get<Green>() << std::endl;
+    std::cout << "Blue is : " << my_color.get<Blue>() << std::endl;
+    std::cout << "Alpha is : " << my_color.get<Alpha>() << std::endl;
+    my_color.set<Alpha>(0x80);
+    std::cout << "After set<Alpha>(0x80) : " << std::hex << my_color.raw() << std::dec << std::endl;
+    std::cout << "orange : " << std::hex << orange.raw() << std::dec << std::endl;
+
+    bitfield<FlagsLayout> flags;
+    flags.set<Visible>(true).set<Layer>(5);
+    std::cout << "flags : " << std::bitset<8>(flags.raw()) << std::endl; // 01010001
+    flags.set<Visible>(false).set<Selected>(true);
+    std::cout << "flags : " << std::bitset<8>(flags.raw()) << ", layer : " << flags.get<Layer>()
+              << ", visible : " << std::boolalpha << flags.get<Visible>() << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : whole images. Default 16M pixels, can be changed from the
+    //command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 16'000'000;
+    std::mt19937 generator {42};
+    std::vector<std::uint32_t> source(count), destination(count), out(count), repacked(count);
+    for(size_t i{}; i < count; ++i){
+        source[i] = static_cast<std::uint32_t>(generator());
+        destination[i] = static_cast<std::uint32_t>(generator());
+    }
+    std::vector<std::uint8_t> red(count), green(count), blue(count), alpha(count);
+    RgbaPlanes planes {red.data(), green.data(), blue.data(), alpha.data()};
+
+    //The SIMD kernels must give the same bits as the scalar ones
+    std::vector<std::uint32_t> scalar_blend(count);
+    blend_rgba(source, destination, scalar_blend, SimdLevel::scalar);
+    blend_rgba(source, destination, out, detected_simd_level());
+    unpack_rgba(source, planes);
+    pack_rgba(planes, repacked);
+    std::cout << std::endl;
+    std::cout << "SIMD level : " << to_string(detected_simd_level())
+              << ", blend matches scalar : " << (scalar_blend == out)
+              << ", unpack + pack round trip : " << (repacked == source) << std::endl;
+
+    std::cout << std::endl;
+    std::cout << count << " pixels : " << std::endl;
+    std::cout << "unpack, masks by hand   : " << time_ms([&]{ unpack_by_hand(source, planes); }) << " ms" << std::endl;
+    for(SimdLevel level : {SimdLevel::scalar, detected_simd_level()}){
+        std::cout << "unpack, " << std::setw(16) << std::left << to_string(level) << std::right << ": "
+                  << time_ms([&]{ unpack_rgba(source, planes, level); }) << " ms" << std::endl;
+        std::cout << "pack,   " << std::setw(16) << std::left << to_string(level) << std::right << ": "
+                  << time_ms([&]{ pack_rgba(planes, repacked, level); }) << " ms" << std::endl;
+        std::cout << "blend,  " << std::setw(16) << std::left << to_string(level) << std::right << ": "
+                  << time_ms([&]{ blend_rgba(source, destination, out, level); }) << " ms" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#ifndef RGBA_H
+#define RGBA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "bitfield.h"
+
+//The color layout of 8.8PackingColorInformation : 0xRRGGBBAA
+struct Red   : bit_field<24, 8> {};
+struct Green : bit_field<16, 8> {};
+struct Blue  : bit_field<8, 8> {};
+struct Alpha : bit_field<0, 8> {}; // Transparency information
+
+using RgbaLayout = bit_layout<std::uint32_t, Red, Green, Blue, Alpha>;
+using Rgba = bitfield<RgbaLayout>;
+
+//Which instruction set the kernels use. Picked once at run time from what
+//the CPU supports, but can be forced for testing and benchmarking.
+enum class SimdLevel { scalar, avx2 };
+
+SimdLevel detected_simd_level();
+const char* to_string(SimdLevel level);
+
+//One array per channel, for code that works on a channel at a time
+struct RgbaPlanes
+{
+    std::uint8_t* red;
+    std::uint8_t* green;
+    std::uint8_t* blue;
+    std::uint8_t* alpha;
+};
+
+//Packed pixels to planes, and back
+void unpack_rgba(std::span<const std::uint32_t> pixels, RgbaPlanes planes,
+                    SimdLevel level = detected_simd_level());
+void pack_rgba(RgbaPlanes planes, std::span<std::uint32_t> pixels,
+                    SimdLevel level = detected_simd_level());
+
+//Draws source over destination, using the source alpha :
+//    color = ( source * alpha + destination * ( 255 - alpha ) ) / 255
+//    alpha = alpha + destination alpha * ( 255 - alpha ) / 255
+//rounded to the nearest. out may be destination.
+void blend_rgba(std::span<const std::uint32_t> source, std::span<const std::uint32_t> destination,
+                    std::span<std::uint32_t> out, SimdLevel level = detected_simd_level());
+
+#endif // RGBA_H
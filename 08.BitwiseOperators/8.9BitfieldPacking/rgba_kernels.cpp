@@ -0,0 +1,197 @@
+#include "rgba.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RGBA_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace{
+
+//x / 255, rounded to the nearest, for x up to 255 * 255 : no division
+constexpr unsigned div255(unsigned x){
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+//Scalar kernels, written with the bitfield API. Also used for the tails
+//the vector loops leave behind.
+void unpack_scalar(const std::uint32_t* pixels, size_t start, size_t count, RgbaPlanes planes){
+    for(size_t i{start}; i < count; ++i){
+        Rgba pixel {pixels[i]};
+        planes.red[i] = static_cast<std::uint8_t>(pixel.get<Red>());
+        planes.green[i] = static_cast<std::uint8_t>(pixel.get<Green>());
+        planes.blue[i] = static_cast<std::uint8_t>(pixel.get<Blue>());
+        planes.alpha[i] = static_cast<std::uint8_t>(pixel.get<Alpha>());
+    }
+}
+
+void pack_scalar(RgbaPlanes planes, std::uint32_t* pixels, size_t start, size_t count){
+    for(size_t i{start}; i < count; ++i){
+        Rgba pixel;
+        pixel.set<Red>(planes.red[i]).set<Green>(planes.green[i])
+             .set<Blue>(planes.blue[i]).set<Alpha>(planes.alpha[i]);
+        pixels[i] = pixel.raw();
+    }
+}
+
+template <typename Channel>
+unsigned blend_channel(Rgba source, Rgba destination, unsigned alpha){
+    return div255(source.get<Channel>() * alpha + destination.get<Channel>() * (255 - alpha));
+}
+
+void blend_scalar(const std::uint32_t* source, const std::uint32_t* destination,
+                  std::uint32_t* out, size_t start, size_t count){
+    for(size_t i{start}; i < count; ++i){
+        //The alpha channel blends like the others, with 255 as the source value
+        Rgba s = Rgba{source[i]};
+        Rgba d {destination[i]};
+        unsigned alpha = s.get<Alpha>();
+        s.set<Alpha>(255);
+        Rgba result;
+        result.set<Red>(blend_channel<Red>(s, d, alpha))
+              .set<Green>(blend_channel<Green>(s, d, alpha))
+              .set<Blue>(blend_channel<Blue>(s, d, alpha))
+              .set<Alpha>(blend_channel<Alpha>(s, d, alpha));
+        out[i] = result.raw();
+    }
+}
+
+#ifdef RGBA_KERNELS_X86
+
+//In memory a 0xRRGGBBAA pixel is the bytes A, B, G, R ( little endian ).
+//This shuffle gathers, in each 128 bit lane of 4 pixels, the 4 A bytes, then
+//the 4 B bytes, and so on. It is its own inverse.
+__attribute__((target("avx2")))
+__m256i transpose_4x4_bytes(__m256i pixels){
+    const __m256i order = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                                           0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    return _mm256_shuffle_epi8(pixels, order);
+}
+
+//8 pixels per iteration
+__attribute__((target("avx2")))
+void unpack_avx2(const std::uint32_t* pixels, size_t count, RgbaPlanes planes){
+    const __m256i join_lanes = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i{};
+    for(; i + 8 <= count; i += 8){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+        //A0-3 B0-3 G0-3 R0-3 | A4-7 B4-7 G4-7 R4-7  ->  A0-7 B0-7 | G0-7 R0-7
+        v = _mm256_permutevar8x32_epi32(transpose_4x4_bytes(v), join_lanes);
+        __m128i alpha_blue = _mm256_castsi256_si128(v);
+        __m128i green_red = _mm256_extracti128_si256(v, 1);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(planes.alpha + i), alpha_blue);
+        _mm_storeh_pd(reinterpret_cast<double*>(planes.blue + i), _mm_castsi128_pd(alpha_blue));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(planes.green + i), green_red);
+        _mm_storeh_pd(reinterpret_cast<double*>(planes.red + i), _mm_castsi128_pd(green_red));
+    }
+    unpack_scalar(pixels, i, count, planes);
+}
+
+__attribute__((target("avx2")))
+void pack_avx2(RgbaPlanes planes, std::uint32_t* pixels, size_t count){
+    const __m256i split_lanes = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    size_t i{};
+    for(; i + 8 <= count; i += 8){
+        auto load8 = [](const std::uint8_t* bytes){
+            return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(bytes));
+        };
+        __m128i alpha_blue = _mm_unpacklo_epi64(load8(planes.alpha + i), load8(planes.blue + i));
+        __m128i green_red = _mm_unpacklo_epi64(load8(planes.green + i), load8(planes.red + i));
+        __m256i v = _mm256_set_m128i(green_red, alpha_blue);
+        //A0-7 B0-7 | G0-7 R0-7  ->  A0-3 B0-3 G0-3 R0-3 | A4-7 B4-7 G4-7 R4-7
+        v = transpose_4x4_bytes(_mm256_permutevar8x32_epi32(v, split_lanes));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), v);
+    }
+    pack_scalar(planes, pixels, i, count);
+}
+
+//Same arithmetic as blend_scalar, on 16 bit lanes : 8 pixels, 32 channels
+//at a time.
+__attribute__((target("avx2")))
+__m256i blend_half_avx2(__m256i source, __m256i destination, __m256i alpha, __m256i inverse_alpha){
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(source, alpha),
+                                 _mm256_mullo_epi16(destination, inverse_alpha));
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+void blend_avx2(const std::uint32_t* source, const std::uint32_t* destination,
+                std::uint32_t* out, size_t count){
+    const __m256i spread_alpha = _mm256_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12,
+                                                  0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12);
+    const __m256i alpha_byte = _mm256_set1_epi32(0x000000FF);
+    const __m256i all_ones = _mm256_set1_epi8(static_cast<char>(0xFF));
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i{};
+    for(; i + 8 <= count; i += 8){
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+        __m256i alpha = _mm256_shuffle_epi8(s, spread_alpha);  // Each pixel's alpha in its 4 bytes
+        __m256i inverse_alpha = _mm256_xor_si256(alpha, all_ones); // 255 - alpha
+        s = _mm256_or_si256(s, alpha_byte);
+
+        __m256i low = blend_half_avx2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero),
+                                      _mm256_unpacklo_epi8(alpha, zero), _mm256_unpacklo_epi8(inverse_alpha, zero));
+        __m256i high = blend_half_avx2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero),
+                                       _mm256_unpackhi_epi8(alpha, zero), _mm256_unpackhi_epi8(inverse_alpha, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_packus_epi16(low, high));
+    }
+    blend_scalar(source, destination, out, i, count);
+}
+
+#endif // RGBA_KERNELS_X86
+
+} // namespace
+
+
+SimdLevel detected_simd_level(){
+#ifdef RGBA_KERNELS_X86
+    static const SimdLevel level = []{
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdLevel::avx2 : SimdLevel::scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+const char* to_string(SimdLevel level){
+    switch(level){
+        case SimdLevel::scalar : return "scalar";
+        case SimdLevel::avx2 : return "AVX2";
+    }
+    return "unknown";
+}
+
+void unpack_rgba(std::span<const std::uint32_t> pixels, RgbaPlanes planes, SimdLevel level){
+#ifdef RGBA_KERNELS_X86
+    if(level == SimdLevel::avx2)
+        return unpack_avx2(pixels.data(), pixels.size(), planes);
+#else
+    (void)level;
+#endif
+    unpack_scalar(pixels.data(), 0, pixels.size(), planes);
+}
+
+void pack_rgba(RgbaPlanes planes, std::span<std::uint32_t> pixels, SimdLevel level){
+#ifdef RGBA_KERNELS_X86
+    if(level == SimdLevel::avx2)
+        return pack_avx2(planes, pixels.data(), pixels.size());
+#else
+    (void)level;
+#endif
+    pack_scalar(planes, pixels.data(), 0, pixels.size());
+}
+
+void blend_rgba(std::span<const std::uint32_t> source, std::span<const std::uint32_t> destination,
+                std::span<std::uint32_t> out, SimdLevel level){
+#ifdef RGBA_KERNELS_X86
+    if(level == SimdLevel::avx2)
+        return blend_avx2(source.data(), destination.data(), out.data(), out.size());
+#else
+    (void)level;
+#endif
+    blend_scalar(source.data(), destination.data(), out.data(), 0, out.size());
+}
@@ -0,0 +1,72 @@
+#ifndef EXTENTS_H
+#define EXTENTS_H
+
+#include <array>
+#include <cstddef>
+#include <limits>
+
+//The size of every dimension of a multi dimensional array, like the
+//[7][5][3] of int house_block[7][5][3]. A dimension is either fixed at
+//compile time, or dynamic_extent : given at run time.
+//    extents<7, 5, 3> house_block;                           // All fixed
+//    extents<dynamic_extent, 4> packages(rows);             // rows x 4
+//    dextents<2> grid(1000, 1000);                          // All dynamic
+inline constexpr size_t dynamic_extent = std::numeric_limits<size_t>::max();
+
+template <size_t... Extents>
+class extents
+{
+    static_assert(sizeof...(Extents) > 0, "extents needs at least one dimension");
+
+public:
+    static constexpr size_t rank() { return sizeof...(Extents); }
+    static constexpr size_t rank_dynamic() { return ((Extents == dynamic_extent) + ... + 0); }
+    static constexpr size_t static_extent(size_t r){
+        constexpr size_t values[] {Extents...};
+        return values[r];
+    }
+
+    //One size per dynamic dimension, in order
+    template <typename... Sizes>
+        requires (sizeof...(Sizes) == rank_dynamic())
+    constexpr explicit extents(Sizes... dynamic_sizes)
+    {
+        const size_t sizes[] {static_cast<size_t>(dynamic_sizes)..., 0};
+        size_t next {};
+        for(size_t r{}; r < rank(); ++r)
+            m_extents[r] = static_extent(r) == dynamic_extent ? sizes[next++] : static_extent(r);
+    }
+
+    //All the sizes at once, as a rank sized array
+    constexpr explicit extents(const std::array<size_t, sizeof...(Extents)>& sizes)
+        : m_extents(sizes)
+    {
+    }
+
+    constexpr size_t extent(size_t r) const { return m_extents[r]; }
+
+    //Number of elements
+    constexpr size_t size() const{
+        size_t result {1};
+        for(size_t e : m_extents)
+            result *= e;
+        return result;
+    }
+
+    constexpr bool operator==(const extents&) const = default;
+
+private:
+    std::array<size_t, sizeof...(Extents)> m_extents {};
+};
+
+template <size_t Rank, size_t... Dynamic>
+struct dextents_helper : dextents_helper<Rank - 1, dynamic_extent, Dynamic...> {};
+
+template <size_t... Dynamic>
+struct dextents_helper<0, Dynamic...> { using type = extents<Dynamic...>; };
+
+//Rank dimensions, all dynamic
+template <size_t Rank>
+using dextents = typename dextents_helper<Rank>::type;
+
+#endif // EXTENTS_H
@@ -0,0 +1,102 @@
+#ifndef LAYOUT_TILED_H
+#define LAYOUT_TILED_H
+
+#include <algorithm>
+#include <cstddef>
+#include "extents.h"
+
+//Blocked layout for 2D grids : the grid is cut in TileRows x TileCols
+//tiles, each tile is stored row major in one contiguous piece, and the
+//tiles themselves are stored row major. Elements that are close in either
+//direction are close in memory, so going down a column touches a few tiles
+//instead of one cache line per row. A tile of 32 x 32 doubles is 8 KB : two
+//of them fit in the L1 cache.
+//The grid is padded up to whole tiles. Tile sizes that are powers of two
+//turn the divisions below into shifts.
+template <size_t TileRows, size_t TileCols>
+struct layout_tiled
+{
+    static constexpr size_t tile_rows = TileRows;
+    static constexpr size_t tile_cols = TileCols;
+    static constexpr size_t tile_size = TileRows * TileCols;
+
+    template <typename Extents>
+    class mapping
+    {
+        static_assert(Extents::rank() == 2, "layout_tiled is for 2D grids");
+
+    public:
+        using extents_type = Extents;
+        static constexpr size_t rank() { return 2; }
+
+        constexpr explicit mapping(const Extents& extents)
+            : m_extents(extents),
+              m_tiles_down((extents.extent(0) + TileRows - 1) / TileRows),
+              m_tiles_across((extents.extent(1) + TileCols - 1) / TileCols)
+        {
+        }
+
+        constexpr const Extents& extents() const { return m_extents; }
+
+        constexpr size_t operator()(size_t i, size_t j) const{
+            const size_t row = i + m_first_row;
+            const size_t col = j + m_first_col;
+            const size_t tile = (row / TileRows) * m_tiles_across + col / TileCols;
+            return tile * tile_size + (row % TileRows) * TileCols + col % TileCols;
+        }
+
+        //The whole padded grid, also for a sub grid : views keep pointing
+        //at the start of the storage and remember where they begin instead
+        constexpr size_t required_span_size() const { return m_tiles_down * m_tiles_across * tile_size; }
+
+        //Rows first_row to first_row + rows - 1, columns likewise
+        template <typename SubExtents>
+        constexpr mapping<SubExtents> submapping(size_t first_row, size_t first_col, const SubExtents& extents) const{
+            mapping<SubExtents> result(*this, extents);
+            result.m_first_row = m_first_row + first_row;
+            result.m_first_col = m_first_col + first_col;
+            return result;
+        }
+
+        //Tile by tile, each tile row by row : memory order
+        template <typename Function>
+        void for_each_index(Function function) const{
+            const size_t rows = m_extents.extent(0);
+            const size_t cols = m_extents.extent(1);
+            if(rows == 0 || cols == 0)
+                return;
+            const size_t row_end = m_first_row + rows;
+            const size_t col_end = m_first_col + cols;
+            for(size_t tile_row{m_first_row / TileRows}; tile_row * TileRows < row_end; ++tile_row){
+                const size_t r_begin = std::max(tile_row * TileRows, m_first_row);
+                const size_t r_end = std::min((tile_row + 1) * TileRows, row_end);
+                for(size_t tile_col{m_first_col / TileCols}; tile_col * TileCols < col_end; ++tile_col){
+                    const size_t c_begin = std::max(tile_col * TileCols, m_first_col);
+                    const size_t c_end = std::min((tile_col + 1) * TileCols, col_end);
+                    for(size_t r{r_begin}; r < r_end; ++r)
+                        for(size_t c{c_begin}; c < c_end; ++c)
+                            function(r - m_first_row, c - m_first_col);
+                }
+            }
+        }
+
+    private:
+        template <typename> friend class mapping;
+
+        template <typename Other>
+        constexpr mapping(const mapping<Other>& parent, const Extents& extents)
+            : m_extents(extents), m_tiles_down(parent.m_tiles_down), m_tiles_across(parent.m_tiles_across),
+              m_first_row(parent.m_first_row), m_first_col(parent.m_first_col)
+        {
+        }
+
+    private:
+        Extents m_extents;
+        size_t m_tiles_down;
+        size_t m_tiles_across;
+        size_t m_first_row {};  // Where a sub grid starts in the full grid
+        size_t m_first_col {};
+    };
+};
+
+#endif // LAYOUT_TILED_H
@@ -0,0 +1,192 @@
+#ifndef LAYOUTS_H
+#define LAYOUTS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include "extents.h"
+
+//A layout decides where element (i, j, k, ...) lives in the flat block of
+//memory behind a multi dimensional array. Each layout has a
+//mapping<Extents> class that does the index -> offset computation, and
+//knows the order that walks through memory front to back :
+//for_each_index(function) calls function(i, j, ...) for every element in
+//that order. Nested loops written in the wrong order jump around in memory,
+//and on grids bigger than the cache that is several times slower.
+
+//Plain nested loops, dimension 0 in the outermost loop : the order of
+//layout_right. Calls function(i, j, ...).
+template <size_t Depth = 0, typename Extents, typename Function, typename... Indices>
+void for_each_index_right(const Extents& extents, Function& function, Indices... indices){
+    if constexpr (Depth == Extents::rank()){
+        function(indices...);
+    }else{
+        for(size_t i{}; i < extents.extent(Depth); ++i)
+            for_each_index_right<Depth + 1>(extents, function, indices..., i);
+    }
+}
+
+//Dimension 0 in the innermost loop : the order of layout_left
+template <size_t Depth, typename Extents, typename Function, typename... Indices>
+void for_each_index_left(const Extents& extents, Function& function, Indices... indices){
+    if constexpr (Depth == 0){
+        function(indices...);
+    }else{
+        for(size_t i{}; i < extents.extent(Depth - 1); ++i)
+            for_each_index_left<Depth - 1>(extents, function, i, indices...);
+    }
+}
+
+//Any other order : dimension order[0] in the outermost loop, order[Rank - 1]
+//in the innermost one. The index is kept in an array, which costs a little
+//more than the two above.
+template <size_t Depth = 0, typename Extents, typename Function>
+void for_each_index_in_order(const Extents& extents, const std::array<size_t, Extents::rank()>& order,
+                             std::array<size_t, Extents::rank()>& index, Function& function){
+    if constexpr (Depth == Extents::rank()){
+        std::apply(function, index);
+    }else{
+        const size_t r = order[Depth];
+        for(size_t i{}; i < extents.extent(r); ++i){
+            index[r] = i;
+            for_each_index_in_order<Depth + 1>(extents, order, index, function);
+        }
+    }
+}
+
+//offset = i * stride(0) + j * stride(1) + ... Base of the three layouts below.
+template <typename Extents>
+class strided_mapping
+{
+public:
+    using extents_type = Extents;
+    static constexpr size_t rank() { return Extents::rank(); }
+
+    constexpr const Extents& extents() const { return m_extents; }
+    constexpr size_t stride(size_t r) const { return m_strides[r]; }
+    constexpr const std::array<size_t, Extents::rank()>& strides() const { return m_strides; }
+
+    template <typename... Indices>
+        requires (sizeof...(Indices) == Extents::rank())
+    constexpr size_t operator()(Indices... indices) const{
+        const size_t index[] {static_cast<size_t>(indices)...};
+        size_t offset {};
+        for(size_t r{}; r < rank(); ++r)
+            offset += index[r] * m_strides[r];
+        return offset;
+    }
+
+    //Elements of memory the mapping can reach : offset of the last one, plus one
+    constexpr size_t required_span_size() const{
+        if(m_extents.size() == 0)
+            return 0;
+        size_t last {};
+        for(size_t r{}; r < rank(); ++r)
+            last += (m_extents.extent(r) - 1) * m_strides[r];
+        return last + 1;
+    }
+
+    //Largest stride in the outer loop, smallest in the inner one
+    template <typename Function>
+    void for_each_index(Function function) const{
+        std::array<size_t, Extents::rank()> order {};
+        for(size_t r{}; r < rank(); ++r)
+            order[r] = r;
+        std::stable_sort(order.begin(), order.end(),
+                         [this](size_t a, size_t b){ return m_strides[a] > m_strides[b]; });
+        if(std::is_sorted(order.begin(), order.end())){
+            for_each_index_right(m_extents, function);
+        }else if(std::is_sorted(order.rbegin(), order.rend())){
+            for_each_index_left<Extents::rank()>(m_extents, function);
+        }else{
+            std::array<size_t, Extents::rank()> index {};
+            for_each_index_in_order(m_extents, order, index, function);
+        }
+    }
+
+protected:
+    constexpr strided_mapping(const Extents& extents, const std::array<size_t, Extents::rank()>& strides)
+        : m_extents(extents), m_strides(strides)
+    {
+    }
+
+private:
+    Extents m_extents;
+    std::array<size_t, Extents::rank()> m_strides;
+};
+
+
+//Row major, the layout of built in arrays : the last index moves fastest.
+//packages[i][j] is at i * 4 + j.
+struct layout_right
+{
+    template <typename Extents>
+    class mapping : public strided_mapping<Extents>
+    {
+    public:
+        constexpr explicit mapping(const Extents& extents)
+            : strided_mapping<Extents>(extents, strides_for(extents))
+        {
+        }
+
+    private:
+        static constexpr std::array<size_t, Extents::rank()> strides_for(const Extents& extents){
+            std::array<size_t, Extents::rank()> strides {};
+            size_t stride {1};
+            for(size_t r{Extents::rank()}; r > 0; --r){
+                strides[r - 1] = stride;
+                stride *= extents.extent(r - 1);
+            }
+            return strides;
+        }
+    };
+};
+
+//Column major, the layout of Fortran and most linear algebra libraries : the
+//first index moves fastest.
+struct layout_left
+{
+    template <typename Extents>
+    class mapping : public strided_mapping<Extents>
+    {
+    public:
+        constexpr explicit mapping(const Extents& extents)
+            : strided_mapping<Extents>(extents, strides_for(extents))
+        {
+        }
+
+    private:
+        static constexpr std::array<size_t, Extents::rank()> strides_for(const Extents& extents){
+            std::array<size_t, Extents::rank()> strides {};
+            size_t stride {1};
+            for(size_t r{}; r < Extents::rank(); ++r){
+                strides[r] = stride;
+                stride *= extents.extent(r);
+            }
+            return strides;
+        }
+    };
+};
+
+//Any strides. What slices of the two layouts above turn into : every other
+//row, one column of a row major grid, ...
+struct layout_stride
+{
+    template <typename Extents>
+    class mapping : public strided_mapping<Extents>
+    {
+    public:
+        constexpr mapping(const Extents& extents, const std::array<size_t, Extents::rank()>& strides)
+            : strided_mapping<Extents>(extents, strides)
+        {
+        }
+
+        constexpr mapping(const strided_mapping<Extents>& other)
+            : strided_mapping<Extents>(other.extents(), other.strides())
+        {
+        }
+    };
+};
+
+#endif // LAYOUTS_H
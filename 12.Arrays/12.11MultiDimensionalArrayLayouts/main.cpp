@@ -0,0 +1,194 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include "mdarray.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Prints a 2D view, one row per line
+template <typename T, typename Extents, typename Layout>
+void print(const mdspan<T, Extents, Layout>& grid){
+    for(size_t i{0}; i < grid.extent(0); ++i){
+        for(size_t j{0}; j < grid.extent(1); ++j)
+            std::cout << std::setw(5) << grid(i, j);
+        std::cout << std::endl;
+    }
+}
+
+//Where each element of a 4 x 4 grid lives in memory, for a layout
+template <typename Layout>
+void print_offsets(const std::string& name){
+    using Mapping = typename Layout::template mapping<extents<4, 4>>;
+    Mapping mapping {extents<4, 4>{}};
+    std::cout << name << " : " << std::endl;
+    for(size_t i{0}; i < 4; ++i){
+        for(size_t j{0}; j < 4; ++j)
+            std::cout << std::setw(4) << mapping(i, j);
+        std::cout << std::endl;
+    }
+}
+
+//The same nested loops for every layout : fast or slow depending on the
+//layout of the arrays
+template <typename In, typename Out>
+void transpose_naive(const In& in, const Out& out){
+    for(size_t i{0}; i < in.extent(0); ++i)
+        for(size_t j{0}; j < in.extent(1); ++j)
+            out(j, i) = in(i, j);
+}
+
+//Cache blocking by hand : transpose one Block x Block square at a time, so
+//the rows read and the rows written stay in the cache while they are used
+template <size_t Block, typename In, typename Out>
+void transpose_blocked(const In& in, const Out& out){
+    const size_t rows = in.extent(0);
+    const size_t cols = in.extent(1);
+    for(size_t i{0}; i < rows; i += Block){
+        for(size_t j{0}; j < cols; j += Block){
+            auto from = submdspan(in, index_range{i, std::min(i + Block, rows)}, index_range{j, std::min(j + Block, cols)});
+            auto to = submdspan(out, index_range{j, std::min(j + Block, cols)}, index_range{i, std::min(i + Block, rows)});
+            transpose_naive(from, to);
+        }
+    }
+}
+
+//Follows the memory order of the source, whatever its layout
+template <typename In, typename Out>
+void transpose_in_order(const In& in, const Out& out){
+    in.for_each_index([&](size_t i, size_t j){ out(j, i) = in(i, j); });
+}
+
+//7 point stencil over the inside of a 3D grid : each point becomes the
+//average of itself and its 6 neighbours. Loops in i, j, k order.
+template <typename In, typename Out>
+void stencil_loops(const In& in, const Out& out){
+    const size_t n0 = in.extent(0), n1 = in.extent(1), n2 = in.extent(2);
+    for(size_t i{1}; i + 1 < n0; ++i)
+        for(size_t j{1}; j + 1 < n1; ++j)
+            for(size_t k{1}; k + 1 < n2; ++k)
+                out(i, j, k) = (in(i, j, k) + in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k)
+                                + in(i, j + 1, k) + in(i, j, k - 1) + in(i, j, k + 1)) / 7.0;
+}
+
+//Same computation, visiting the inside in the memory order of the layout.
+//The slice of out only gives the order, the elements are reached through
+//out itself : the lambda holds copies of the views, so their strides stay
+//in registers.
+template <typename In, typename Out>
+void stencil_in_order(const In& in, const Out& out){
+    auto inside = submdspan(out, index_range{1, out.extent(0) - 1}, index_range{1, out.extent(1) - 1},
+                            index_range{1, out.extent(2) - 1});
+    inside.for_each_index([in, out](size_t a, size_t b, size_t c){
+        const size_t i = a + 1, j = b + 1, k = c + 1;
+        out(i, j, k) = (in(i, j, k) + in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k)
+                        + in(i, j + 1, k) + in(i, j, k - 1) + in(i, j, k + 1)) / 7.0;
+    });
+}
+
+template <typename T, typename Extents, typename Layout>
+double checksum(const mdarray<T, Extents, Layout>& grid){
+    double sum {};
+    grid.for_each_index([&](auto... indices){ sum += grid(indices...); });
+    return sum;
+}
+
+
+int main(int argc, char** argv){
+
+    //int packages [] [4], with the number of rows chosen at run time
+    mdarray<int, extents<dynamic_extent, 4>> packages(4);
+    int value {1};
+    packages.for_each_index([&](size_t i, size_t j){ packages(i, j) = value++; });
+    std::cout << "packages : " << std::endl;
+    print(packages.to_mdspan());
+
+    //Slices are views : no copy
+    auto third_column = submdspan(packages.to_mdspan(), full_extent, 2);
+    std::cout << "third column :";
+    for(size_t i{0}; i < third_column.extent(0); ++i)
+        std::cout << " " << third_column(i);
+    std::cout << std::endl;
+    std::cout << "middle block : " << std::endl;
+    print(submdspan(packages.to_mdspan(), index_range{1, 3}, index_range{1, 3}));
+
+    //int house_block [7] [5] [3] : 3 lights per room, 5 rooms per house, 7 houses per block
+    mdarray<int, extents<7, 5, 3>> house_block {extents<7, 5, 3>{}};
+    value = 1;
+    house_block.for_each_index([&](size_t i, size_t j, size_t k){ house_block(i, j, k) = value++; });
+    std::cout << "lights of house 2 : " << std::endl;
+    print(submdspan(house_block.to_mdspan(), 2, full_extent, full_extent));
+
+    print_offsets<layout_right>("row major offsets");
+    print_offsets<layout_left>("column major offsets");
+    print_offsets<layout_tiled<2, 2>>("2 x 2 tiled offsets");
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : transposing a grid much bigger than the cache. Default
+    //4000 x 4000 doubles ( 128 MB per grid ), can be changed from the command line.
+    size_t n = (argc > 1) ? std::stoul(argv[1]) : 4000;
+    using Grid = mdarray<double, dextents<2>>;
+    using ColumnGrid = mdarray<double, dextents<2>, layout_left>;
+    using TiledGrid = mdarray<double, dextents<2>, layout_tiled<32, 32>>;
+
+    Grid source(n, n);
+    source.for_each_index([&](size_t i, size_t j){ source(i, j) = static_cast<double>(i * n + j); });
+    {
+        Grid transposed(n, n);
+        double naive_ms = time_ms([&]{ transpose_naive(source.to_mdspan(), transposed.to_mdspan()); });
+        double check = checksum(transposed);
+        double blocked_ms = time_ms([&]{ transpose_blocked<32>(source.to_mdspan(), transposed.to_mdspan()); });
+        std::cout << "transpose " << n << " x " << n << ", row major -> row major : " << naive_ms << " ms, cache blocked : "
+                  << blocked_ms << " ms" << std::endl;
+
+        ColumnGrid by_columns(n, n);
+        double columns_ms = time_ms([&]{ transpose_naive(source.to_mdspan(), by_columns.to_mdspan()); });
+        std::cout << "row major -> column major ( same loops ) : " << columns_ms << " ms" << std::endl;
+
+        TiledGrid tiled_source(n, n), tiled_transposed(n, n);
+        tiled_source.for_each_index([&](size_t i, size_t j){ tiled_source(i, j) = source(i, j); });
+        double tiled_naive_ms = time_ms([&]{ transpose_naive(tiled_source.to_mdspan(), tiled_transposed.to_mdspan()); });
+        double tiled_order_ms = time_ms([&]{ transpose_in_order(tiled_source.to_mdspan(), tiled_transposed.to_mdspan()); });
+        std::cout << "tiled -> tiled, same loops : " << tiled_naive_ms << " ms, tile order : " << tiled_order_ms << " ms" << std::endl;
+
+        bool same = checksum(by_columns) == check && checksum(tiled_transposed) == check;
+        for(size_t i{0}; i < n && same; i += 97)
+            for(size_t j{0}; j < n && same; j += 89)
+                same = transposed(j, i) == source(i, j) && by_columns(j, i) == source(i, j) && tiled_transposed(j, i) == source(i, j);
+        std::cout << "all transposes agree : " << std::boolalpha << same << std::endl;
+    }
+
+    //Benchmark : a 3D stencil. The i, j, k loops match the row major layout,
+    //and go against the column major one.
+    size_t side = (argc > 2) ? std::stoul(argv[2]) : 200;
+    using Volume = mdarray<double, dextents<3>>;
+    using ColumnVolume = mdarray<double, dextents<3>, layout_left>;
+    Volume volume(side, side, side), volume_out(side, side, side);
+    ColumnVolume column_volume(side, side, side), column_out(side, side, side);
+    volume.for_each_index([&](size_t i, size_t j, size_t k){
+        volume(i, j, k) = column_volume(i, j, k) = static_cast<double>((i * 7 + j * 3 + k) % 11);
+    });
+
+    double right_ms = time_ms([&]{ stencil_loops(volume.to_mdspan(), volume_out.to_mdspan()); });
+    double left_ms = time_ms([&]{ stencil_loops(column_volume.to_mdspan(), column_out.to_mdspan()); });
+    double left_order_ms = time_ms([&]{ stencil_in_order(column_volume.to_mdspan(), column_out.to_mdspan()); });
+    double right_order_ms = time_ms([&]{ stencil_in_order(volume.to_mdspan(), volume_out.to_mdspan()); });
+    std::cout << "stencil " << side << "^3, i j k loops : row major " << right_ms << " ms, column major " << left_ms
+              << " ms" << std::endl;
+    std::cout << "stencil in layout order : row major " << right_order_ms << " ms, column major " << left_order_ms
+              << " ms" << std::endl;
+    bool agree {true};
+    volume_out.for_each_index([&](size_t i, size_t j, size_t k){ agree = agree && volume_out(i, j, k) == column_out(i, j, k); });
+    std::cout << "results agree : " << agree << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#ifndef MDARRAY_H
+#define MDARRAY_H
+
+#include <cstddef>
+#include <vector>
+#include "mdspan.h"
+
+//An owning multi dimensional array : the storage, plus the mapping that
+//says where each element is. Unlike int packages[][4], the sizes can be
+//chosen at run time, and the layout can be changed without touching the
+//code that uses the array :
+//    mdarray<double, dextents<2>> grid(rows, cols);                      // Row major
+//    mdarray<double, dextents<2>, layout_left> by_columns(rows, cols);   // Column major
+//    mdarray<double, dextents<2>, layout_tiled<32, 32>> tiled(rows, cols);
+//Elements start value initialized ( 0 for numbers ).
+template <typename T, typename Extents, typename Layout = layout_right>
+class mdarray
+{
+public:
+    using element_type = T;
+    using extents_type = Extents;
+    using layout_type = Layout;
+    using mapping_type = typename Layout::template mapping<Extents>;
+
+    explicit mdarray(const Extents& extents)
+        : m_mapping(extents), m_storage(m_mapping.required_span_size())
+    {
+    }
+
+    template <typename... Sizes>
+        requires (sizeof...(Sizes) == Extents::rank_dynamic() && (std::convertible_to<Sizes, size_t> && ...))
+    explicit mdarray(Sizes... dynamic_sizes)
+        : mdarray(Extents(dynamic_sizes...))
+    {
+    }
+
+    template <typename... Indices>
+        requires (sizeof...(Indices) == Extents::rank())
+    T& operator()(Indices... indices){
+        return m_storage[m_mapping(static_cast<size_t>(indices)...)];
+    }
+
+    template <typename... Indices>
+        requires (sizeof...(Indices) == Extents::rank())
+    const T& operator()(Indices... indices) const{
+        return m_storage[m_mapping(static_cast<size_t>(indices)...)];
+    }
+
+    static constexpr size_t rank() { return Extents::rank(); }
+    size_t extent(size_t r) const { return m_mapping.extents().extent(r); }
+    size_t size() const { return m_mapping.extents().size(); }
+    const Extents& extents() const { return m_mapping.extents(); }
+    T* data() { return m_storage.data(); }
+    const T* data() const { return m_storage.data(); }
+    const mapping_type& mapping() const { return m_mapping; }
+
+    //Bytes of storage, padding included
+    size_t storage_bytes() const { return m_storage.size() * sizeof(T); }
+
+    mdspan<T, Extents, Layout> to_mdspan() { return {m_storage.data(), m_mapping}; }
+    mdspan<const T, Extents, Layout> to_mdspan() const { return {m_storage.data(), m_mapping}; }
+    operator mdspan<T, Extents, Layout>() { return to_mdspan(); }
+    operator mdspan<const T, Extents, Layout>() const { return to_mdspan(); }
+
+    template <typename Function>
+    void for_each_index(Function function) const { m_mapping.for_each_index(function); }
+
+private:
+    mapping_type m_mapping;
+    std::vector<T> m_storage;
+};
+
+#endif // MDARRAY_H
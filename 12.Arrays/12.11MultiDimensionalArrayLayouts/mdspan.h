@@ -0,0 +1,157 @@
+#ifndef MDSPAN_H
+#define MDSPAN_H
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include "extents.h"
+#include "layouts.h"
+#include "layout_tiled.h"
+
+//A non owning view of a flat block of memory as a multi dimensional array,
+//like std::span is for one dimension. The extents give the dimensions, the
+//layout where each element is :
+//    std::vector<double> storage(rows * cols);
+//    mdspan<double, dextents<2>> grid(storage.data(), rows, cols);
+//    grid(i, j) = 1.0;
+//Copying an mdspan copies the pointer and the mapping, never the elements.
+template <typename T, typename Extents, typename Layout = layout_right>
+class mdspan
+{
+public:
+    using element_type = T;
+    using extents_type = Extents;
+    using layout_type = Layout;
+    using mapping_type = typename Layout::template mapping<Extents>;
+
+    constexpr mdspan(T* data, const mapping_type& mapping)
+        : m_data(data), m_mapping(mapping)
+    {
+    }
+
+    //The sizes of the dynamic dimensions
+    template <typename... Sizes>
+        requires (sizeof...(Sizes) == Extents::rank_dynamic() && (std::convertible_to<Sizes, size_t> && ...))
+    constexpr explicit mdspan(T* data, Sizes... dynamic_sizes)
+        : mdspan(data, mapping_type(Extents(dynamic_sizes...)))
+    {
+    }
+
+    //mdspan<T> converts to mdspan<const T>
+    template <typename U>
+        requires (!std::is_same_v<U, T> && std::is_convertible_v<U(*)[], T(*)[]>)
+    constexpr mdspan(const mdspan<U, Extents, Layout>& other)
+        : mdspan(other.data(), other.mapping())
+    {
+    }
+
+    //C++23 spells this grid[i, j]. Before that, operator[] takes one argument only.
+    template <typename... Indices>
+        requires (sizeof...(Indices) == Extents::rank())
+    constexpr T& operator()(Indices... indices) const{
+        return m_data[m_mapping(static_cast<size_t>(indices)...)];
+    }
+
+    static constexpr size_t rank() { return Extents::rank(); }
+    constexpr size_t extent(size_t r) const { return m_mapping.extents().extent(r); }
+    constexpr size_t size() const { return m_mapping.extents().size(); }
+    constexpr const Extents& extents() const { return m_mapping.extents(); }
+    constexpr T* data() const { return m_data; }
+    constexpr const mapping_type& mapping() const { return m_mapping; }
+
+    //function(i, j, ...) for every element, in the order of the layout
+    template <typename Function>
+    void for_each_index(Function function) const { m_mapping.for_each_index(function); }
+
+    //function(element) for every element, in the order of the layout
+    template <typename Function>
+    void for_each(Function function) const{
+        m_mapping.for_each_index([this, &function](auto... indices){ function((*this)(indices...)); });
+    }
+
+private:
+    T* m_data;
+    mapping_type m_mapping;
+};
+
+
+//Slice specifiers for submdspan :
+//  - an index keeps that one position and drops the dimension.
+//  - full_extent keeps the whole dimension.
+//  - index_range{first, last} keeps [first, last).
+struct full_extent_t {};
+inline constexpr full_extent_t full_extent {};
+
+struct index_range
+{
+    size_t first;
+    size_t last;
+};
+
+template <typename Slice>
+inline constexpr bool is_index_slice_v = std::is_integral_v<Slice>;
+
+template <typename... Slices>
+inline constexpr size_t sub_rank_v = ((!is_index_slice_v<Slices>) + ... + 0);
+
+template <typename Slice>
+constexpr size_t slice_first(const Slice& slice){
+    if constexpr (is_index_slice_v<Slice>)
+        return static_cast<size_t>(slice);
+    else if constexpr (std::is_same_v<Slice, index_range>)
+        return slice.first;
+    else
+        return 0;
+}
+
+template <typename Slice>
+constexpr size_t slice_length(const Slice& slice, size_t extent){
+    if constexpr (std::is_same_v<Slice, index_range>)
+        return slice.last - slice.first;
+    else
+        return extent;
+}
+
+//A view of part of span : one slice per dimension. Slices of the strided
+//layouts are layout_stride views, with one dimension per non index slice :
+//    auto row = submdspan(grid, 3, full_extent);                // rank 1
+//    auto block = submdspan(grid, index_range{0, 32}, index_range{64, 96});
+//Slices of a tiled grid stay tiled. They have to keep both dimensions.
+template <typename T, typename Extents, typename Layout, typename... Slices>
+    requires (sizeof...(Slices) == Extents::rank())
+constexpr auto submdspan(const mdspan<T, Extents, Layout>& span, Slices... slices){
+    constexpr size_t sub_rank = sub_rank_v<Slices...>;
+    using SubExtents = dextents<sub_rank>;
+    const auto& mapping = span.mapping();
+
+    const std::array<size_t, Extents::rank()> first {slice_first(slices)...};
+    std::array<size_t, Extents::rank()> length {};
+    std::array<bool, Extents::rank()> keep {!is_index_slice_v<Slices>...};
+    {
+        size_t r {};
+        ((length[r] = slice_length(slices, span.extent(r)), ++r), ...);
+    }
+
+    std::array<size_t, sub_rank> sub_sizes {};
+    for(size_t r{}, s{}; r < Extents::rank(); ++r)
+        if(keep[r])
+            sub_sizes[s++] = length[r];
+
+    if constexpr (requires { mapping.stride(0); }){
+        std::array<size_t, sub_rank> sub_strides {};
+        for(size_t r{}, s{}; r < Extents::rank(); ++r)
+            if(keep[r])
+                sub_strides[s++] = mapping.stride(r);
+        const size_t offset = std::apply(mapping, first);
+        using SubMapping = layout_stride::mapping<SubExtents>;
+        return mdspan<T, SubExtents, layout_stride>(span.data() + offset,
+                                                    SubMapping(SubExtents(sub_sizes), sub_strides));
+    }else{
+        static_assert(sub_rank == Extents::rank(), "Slices of this layout must keep every dimension");
+        return mdspan<T, SubExtents, Layout>(span.data(),
+                                             mapping.submapping(first[0], first[1], SubExtents(sub_sizes)));
+    }
+}
+
+#endif // MDSPAN_H
@@ -0,0 +1,230 @@
+#include "bulk_random.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BULK_RANDOM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace{
+
+using State = std::uint64_t[4][4];
+
+//The top 52 bits as the mantissa of a double in [1, 2), minus 1 : uniform in
+//[0, 1) with no integer to floating point conversion. AVX2 has none for
+//64 bit integers.
+double to_unit(std::uint64_t bits){
+    return std::bit_cast<double>((bits >> 12) | 0x3FF0000000000000ull) - 1.0;
+}
+
+//unit * scale + low can round up to high itself when unit is close to 1.
+//Clamped to the last double below high, so the range stays [low, high).
+double highest_below(double low, double high){
+    return low < high ? std::nextafter(high, low) : low;
+}
+
+//Advances the four engines by one step each, writing one number per lane
+void next_scalar(State& s, std::uint64_t* out){
+    for(unsigned lane{}; lane < 4; ++lane){
+        out[lane] = std::rotl(s[1][lane] * 5, 7) * 9;
+        const std::uint64_t t = s[1][lane] << 17;
+        s[2][lane] ^= s[0][lane];
+        s[3][lane] ^= s[1][lane];
+        s[1][lane] ^= s[2][lane];
+        s[0][lane] ^= s[3][lane];
+        s[2][lane] ^= t;
+        s[3][lane] = std::rotl(s[3][lane], 45);
+    }
+}
+
+//Calls sink(block) with blocks of 4 numbers, count / 4 times
+template <typename Sink>
+void generate_scalar(State& s, size_t blocks, Sink sink){
+    alignas(32) std::uint64_t block[4];
+    for(size_t b{}; b < blocks; ++b){
+        next_scalar(s, block);
+        sink(b, block);
+    }
+}
+
+#ifdef BULK_RANDOM_X86
+
+__attribute__((target("avx2")))
+inline __m256i rotl_avx2(__m256i x, int k){
+    return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+}
+
+//The scalar step above, one lane per engine. No 64 bit multiply in AVX2 :
+//x * 5 is x + ( x << 2 ), x * 9 is x + ( x << 3 ).
+__attribute__((target("avx2")))
+inline __m256i next_avx2(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3){
+    const __m256i times5 = _mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2));
+    const __m256i rotated = rotl_avx2(times5, 7);
+    const __m256i result = _mm256_add_epi64(rotated, _mm256_slli_epi64(rotated, 3));
+    const __m256i t = _mm256_slli_epi64(s1, 17);
+    s2 = _mm256_xor_si256(s2, s0);
+    s3 = _mm256_xor_si256(s3, s1);
+    s1 = _mm256_xor_si256(s1, s2);
+    s0 = _mm256_xor_si256(s0, s3);
+    s2 = _mm256_xor_si256(s2, t);
+    s3 = rotl_avx2(s3, 45);
+    return result;
+}
+
+__attribute__((target("avx2")))
+void fill_bits_avx2(State& s, std::uint64_t* out, size_t blocks){
+    __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[0]));
+    __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[1]));
+    __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[2]));
+    __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[3]));
+    for(size_t b{}; b < blocks; ++b)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + b * 4), next_avx2(s0, s1, s2, s3));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[0]), s0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[1]), s1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[2]), s2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[3]), s3);
+}
+
+__attribute__((target("avx2")))
+void fill_uniform_avx2(State& s, double* out, size_t blocks, double low, double high){
+    __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[0]));
+    __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[1]));
+    __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[2]));
+    __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[3]));
+    const __m256i exponent = _mm256_set1_epi64x(0x3FF0000000000000ll);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d scale = _mm256_set1_pd(high - low);
+    const __m256d offset = _mm256_set1_pd(low);
+    const __m256d top = _mm256_set1_pd(highest_below(low, high));
+    for(size_t b{}; b < blocks; ++b){
+        const __m256i bits = _mm256_or_si256(_mm256_srli_epi64(next_avx2(s0, s1, s2, s3), 12), exponent);
+        const __m256d unit = _mm256_sub_pd(_mm256_castsi256_pd(bits), one);
+        //Not fused : a multiply then an add, like the scalar code
+        const __m256d value = _mm256_add_pd(_mm256_mul_pd(unit, scale), offset);
+        _mm256_storeu_pd(out + b * 4, _mm256_min_pd(value, top));
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[0]), s0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[1]), s1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[2]), s2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s[3]), s3);
+}
+
+#endif // BULK_RANDOM_X86
+
+void fill_bits(State& s, std::uint64_t* out, size_t blocks, SimdLevel level){
+#ifdef BULK_RANDOM_X86
+    if(level == SimdLevel::avx2)
+        return fill_bits_avx2(s, out, blocks);
+#else
+    (void)level;
+#endif
+    generate_scalar(s, blocks, [out](size_t b, const std::uint64_t* block){
+        std::memcpy(out + b * 4, block, sizeof(std::uint64_t) * 4);
+    });
+}
+
+void fill_uniform(State& s, double* out, size_t blocks, double low, double high, SimdLevel level){
+#ifdef BULK_RANDOM_X86
+    if(level == SimdLevel::avx2)
+        return fill_uniform_avx2(s, out, blocks, low, high);
+#else
+    (void)level;
+#endif
+    const double scale = high - low;
+    const double top = highest_below(low, high);
+    generate_scalar(s, blocks, [out, scale, low, top](size_t b, const std::uint64_t* block){
+        for(unsigned lane{}; lane < 4; ++lane)
+            out[b * 4 + lane] = std::min(to_unit(block[lane]) * scale + low, top);
+    });
+}
+
+} // namespace
+
+
+SimdLevel detected_simd_level(){
+#ifdef BULK_RANDOM_X86
+    static const SimdLevel level = []{
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdLevel::avx2 : SimdLevel::scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+const char* to_string(SimdLevel level){
+    switch(level){
+        case SimdLevel::scalar : return "scalar";
+        case SimdLevel::avx2 : return "AVX2";
+    }
+    return "unknown";
+}
+
+BulkRandom::BulkRandom(std::uint64_t seed, SimdLevel level)
+    : BulkRandom(xoshiro256ss{seed}, level)
+{
+}
+
+BulkRandom::BulkRandom(const xoshiro256ss& engine, SimdLevel level)
+    : m_level(level)
+{
+    xoshiro256ss lane_engine {engine};
+    for(unsigned lane{}; lane < 4; ++lane){
+        for(unsigned word{}; word < 4; ++word)
+            m_state[word][lane] = lane_engine.state()[word];
+        lane_engine.jump();
+    }
+}
+
+void BulkRandom::fill(std::span<std::uint64_t> out){
+    const size_t blocks = out.size() / 4;
+    fill_bits(m_state, out.data(), blocks, m_level);
+
+    //The last 1 to 3 numbers : one more step, part of it thrown away
+    if(out.size() % 4 != 0){
+        alignas(32) std::uint64_t block[4];
+        next_scalar(m_state, block);
+        for(size_t i{blocks * 4}; i < out.size(); ++i)
+            out[i] = block[i - blocks * 4];
+    }
+}
+
+void BulkRandom::fill_uniform(std::span<double> out, double low, double high){
+    const size_t blocks = out.size() / 4;
+    const double scale = high - low;
+    const double top = highest_below(low, high);
+    ::fill_uniform(m_state, out.data(), blocks, low, high, m_level);
+
+    if(out.size() % 4 != 0){
+        alignas(32) std::uint64_t block[4];
+        next_scalar(m_state, block);
+        for(size_t i{blocks * 4}; i < out.size(); ++i)
+            out[i] = std::min(to_unit(block[i - blocks * 4]) * scale + low, top);
+    }
+}
+
+void BulkRandom::fill_normal(std::span<double> out, double mean, double stddev){
+    //Uniforms first, in bulk, then turned into normals in place, two at a time :
+    //    r = sqrt( -2 ln u1 ),  out = r cos( 2 pi u2 ) and r sin( 2 pi u2 )
+    //The loop below is scalar whatever m_level is.
+    fill_uniform(out);
+    const size_t pairs = out.size() / 2;
+    for(size_t p{}; p < pairs; ++p){
+        const double u1 = 1.0 - out[2 * p]; // (0, 1] : no log(0)
+        const double angle = 2.0 * std::numbers::pi * out[2 * p + 1];
+        const double radius = stddev * std::sqrt(-2.0 * std::log(u1));
+        out[2 * p] = mean + radius * std::cos(angle);
+        out[2 * p + 1] = mean + radius * std::sin(angle);
+    }
+    if(out.size() % 2 != 0){
+        double extra[2];
+        fill_uniform(extra);
+        out.back() = mean + stddev * std::sqrt(-2.0 * std::log(1.0 - extra[0]))
+                                   * std::cos(2.0 * std::numbers::pi * extra[1]);
+    }
+}
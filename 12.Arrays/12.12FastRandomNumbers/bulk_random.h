@@ -0,0 +1,44 @@
+#ifndef BULK_RANDOM_H
+#define BULK_RANDOM_H
+
+#include <cstdint>
+#include <span>
+#include "random_engines.h"
+
+//Which instruction set the kernels use. Picked once at run time from what
+//the CPU supports, but can be forced for testing and benchmarking.
+enum class SimdLevel { scalar, avx2 };
+
+SimdLevel detected_simd_level();
+const char* to_string(SimdLevel level);
+
+//Fills whole arrays with random numbers. Calling an engine and a
+//distribution once per number is a chain : each number needs the state the
+//previous one left. Here four xoshiro256** engines, each 2^128 numbers apart,
+//run side by side in the four 64 bit lanes of an AVX2 register.
+//The output is the same with and without AVX2 : the scalar code runs the
+//same four engines in turn.
+class BulkRandom
+{
+public:
+    explicit BulkRandom(std::uint64_t seed, SimdLevel level = detected_simd_level());
+    //Lane 0 continues from engine, lanes 1 to 3 from its next three jumps
+    explicit BulkRandom(const xoshiro256ss& engine, SimdLevel level = detected_simd_level());
+
+    void fill(std::span<std::uint64_t> out);
+    //Uniform in [low, high) for low < high, 52 random bits each. Values that
+    //would round up to high are clamped to the double just below it.
+    void fill_uniform(std::span<double> out, double low = 0.0, double high = 1.0);
+    //Normal ( Gaussian ), by the Box-Muller transform over pairs of uniforms.
+    //Only the uniforms are drawn with SIMD : the transform itself ( log,
+    //sqrt, sin, cos ) is scalar code, and costs more than the draws.
+    void fill_normal(std::span<double> out, double mean = 0.0, double stddev = 1.0);
+
+    SimdLevel level() const { return m_level; }
+
+private:
+    alignas(32) std::uint64_t m_state[4][4]; // m_state[word][lane]
+    SimdLevel m_level;
+};
+
+#endif // BULK_RANDOM_H
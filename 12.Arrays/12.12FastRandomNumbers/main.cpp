@@ -0,0 +1,176 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include "random_engines.h"
+#include "bulk_random.h"
+
+static_assert(std::uniform_random_bit_generator<xoshiro256ss>);
+static_assert(std::uniform_random_bit_generator<pcg64>);
+static_assert(std::uniform_random_bit_generator<philox4x32>);
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Monte Carlo estimate of pi : the fraction of random points of the unit
+//square that fall inside the quarter circle is pi / 4
+template <typename Engine>
+std::uint64_t points_inside(Engine& engine, std::uint64_t points){
+    std::uniform_real_distribution<double> coordinate {0.0, 1.0};
+    std::uint64_t inside {};
+    for(std::uint64_t i{}; i < points; ++i){
+        double x = coordinate(engine);
+        double y = coordinate(engine);
+        inside += (x * x + y * y <= 1.0);
+    }
+    return inside;
+}
+
+//Each worker thread owns its stream : stream number worker of the same
+//seed. Same seed, same answer, however the threads get scheduled.
+double parallel_pi(std::uint64_t seed, unsigned workers, std::uint64_t points_per_worker){
+    std::vector<std::uint64_t> inside(workers);
+    std::vector<std::thread> threads;
+    for(unsigned w{}; w < workers; ++w){
+        threads.emplace_back([&inside, seed, w, points_per_worker]{
+            philox4x32 engine {seed, w};
+            inside[w] = points_inside(engine, points_per_worker);
+        });
+    }
+    std::uint64_t total {};
+    for(unsigned w{}; w < workers; ++w){
+        threads[w].join();
+        total += inside[w];
+    }
+    return 4.0 * static_cast<double>(total) / static_cast<double>(points_per_worker * workers);
+}
+
+
+int main(int argc, char** argv){
+
+    //The numbers of 12.6 : [1~10]. std::random_device gives a seed that
+    //changes from run to run, like std::time(0) did.
+    xoshiro256ss engine {std::random_device{}()};
+    std::uniform_int_distribution<int> one_to_ten {1, 10};
+    for(size_t i {0} ; i < 10 ; ++i)
+        std::cout << one_to_ten(engine) << " ";
+    std::cout << std::endl;
+
+    //The fortune teller of 12.10, without the % bias of std::rand() % 12
+    const char* predictions [] {
+        "a lot of kinds running in the backyard!",
+        "a lot of empty beer bootles on your work table.",
+        "clouds gathering in the sky and an army standing ready for war",
+        "you laughing your lungs out. I've never seen this before."
+    };
+    std::uniform_int_distribution<size_t> pick {0, std::size(predictions) - 1};
+    std::cout << "Oh dear, I see " << predictions[pick(engine)] << std::endl;
+
+    //Fixed seeds give the same numbers on every run and every machine
+    xoshiro256ss xoshiro {42};
+    pcg64 pcg {42};
+    philox4x32 philox {42};
+    std::cout << "xoshiro256** : " << xoshiro() << ", pcg64 : " << pcg() << ", philox4x32 : " << philox() << std::endl;
+
+    //Jumping ahead
+    pcg64 skipped {42};
+    skipped.advance(1'000'000);
+    pcg64 stepped {42};
+    for(int i{}; i < 1'000'000; ++i)
+        stepped();
+    std::cout << "pcg64 advance(1000000) == 1000000 calls : " << std::boolalpha << (skipped == stepped) << std::endl;
+
+    philox4x32 far_ahead {42};
+    far_ahead.discard(1'000'000'000'000ull); // No loop : the counter is set directly
+    std::cout << "philox4x32 number 10^12 : " << far_ahead() << std::endl;
+
+    std::cout << "pi, 4 workers : " << parallel_pi(2024, 4, 1'000'000) << ", again : " << parallel_pi(2024, 4, 1'000'000) << std::endl;
+
+    //Bulk filling gives the same numbers with or without AVX2
+    std::vector<double> scalar_numbers(1001), simd_numbers(1001);
+    BulkRandom scalar_bulk {7, SimdLevel::scalar};
+    BulkRandom simd_bulk {7};
+    scalar_bulk.fill_uniform(scalar_numbers);
+    simd_bulk.fill_uniform(simd_numbers);
+    std::cout << "bulk fill ( " << to_string(simd_bulk.level()) << " ) matches scalar : " << (scalar_numbers == simd_numbers) << std::endl;
+
+    //Doubles 2 apart : half of unit * 2 + low would round up to high
+    const double low {1e16}, high {1e16 + 2};
+    scalar_bulk.fill_uniform(scalar_numbers, low, high);
+    simd_bulk.fill_uniform(simd_numbers, low, high);
+    std::cout << "bulk fill in [1e16, 1e16 + 2) never gives high : "
+              << std::ranges::none_of(scalar_numbers, [high](double x){ return x >= high; })
+              << ", matches scalar : " << (scalar_numbers == simd_numbers) << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : uniform doubles in [0, 1). Default 50M, can be changed from
+    //the command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 50'000'000;
+    std::vector<double> numbers(count);
+    auto report = [&numbers, count](const std::string& name, double ms){
+        double sum {};
+        for(double number : numbers)
+            sum += number;
+        std::cout << name << " : " << ms << " ms, mean " << sum / static_cast<double>(count) << std::endl;
+    };
+
+    std::srand(42);
+    report("std::rand() / RAND_MAX", time_ms([&]{
+        for(double& number : numbers)
+            number = std::rand() / (RAND_MAX + 1.0);
+    }));
+
+    std::uniform_real_distribution<double> unit {0.0, 1.0};
+    std::mt19937_64 mersenne {42};
+    report("std::mt19937_64", time_ms([&]{
+        for(double& number : numbers)
+            number = unit(mersenne);
+    }));
+    report("xoshiro256**", time_ms([&]{
+        for(double& number : numbers)
+            number = unit(xoshiro);
+    }));
+    report("pcg64", time_ms([&]{
+        for(double& number : numbers)
+            number = unit(pcg);
+    }));
+    report("philox4x32", time_ms([&]{
+        for(double& number : numbers)
+            number = unit(philox);
+    }));
+    report("BulkRandom, scalar", time_ms([&]{ scalar_bulk.fill_uniform(numbers); }));
+    report("BulkRandom, " + std::string(to_string(simd_bulk.level())), time_ms([&]{ simd_bulk.fill_uniform(numbers); }));
+
+    //Normal distribution : mean 0, standard deviation 1
+    auto report_normal = [&numbers, count](const std::string& name, double ms){
+        double sum {}, squares {};
+        for(double number : numbers){
+            sum += number;
+            squares += number * number;
+        }
+        std::cout << name << " : " << ms << " ms, mean " << sum / static_cast<double>(count)
+                  << ", variance " << squares / static_cast<double>(count) << std::endl;
+    };
+    std::normal_distribution<double> gaussian {0.0, 1.0};
+    report_normal("normal, std::mt19937_64", time_ms([&]{
+        for(double& number : numbers)
+            number = gaussian(mersenne);
+    }));
+    report_normal("normal, BulkRandom", time_ms([&]{ simd_bulk.fill_normal(numbers); }));
+
+    return 0;
+}
@@ -0,0 +1,240 @@
+#ifndef RANDOM_ENGINES_H
+#define RANDOM_ENGINES_H
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+//std::rand() keeps one hidden state for the whole program : every thread
+//fights over it, its quality is poor, and RAND_MAX can be as low as 32767.
+//The engines below are small objects that each thread owns, fast, and meet
+//the std::uniform_random_bit_generator requirements : they plug into the
+//<random> distributions like std::mt19937 does.
+//    xoshiro256ss engine {42};
+//    std::uniform_int_distribution<int> dice {1, 6};
+//    int roll = dice(engine);
+//Each one can give independent streams to parallel workers :
+//  - xoshiro256ss : jump() skips 2^128 numbers. Worker k jumps k times.
+//  - pcg64        : one stream per increment, and advance(n) skips n numbers.
+//  - philox4x32   : number i of stream s is a pure function of ( key, s, i ),
+//                   so any worker can start anywhere, in any order.
+//None of them is for cryptography.
+
+//Mixes a 64 bit value into a well spread one. Used to turn a single seed
+//into the larger states below.
+inline std::uint64_t splitmix64(std::uint64_t& state){
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+
+//xoshiro256** by Blackman and Vigna : 256 bits of state, a few shifts, xors
+//and two multiplies per number. Period 2^256 - 1.
+class xoshiro256ss
+{
+public:
+    using result_type = std::uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    explicit xoshiro256ss(std::uint64_t seed = 0x853c49e6748fea9bull){
+        for(std::uint64_t& word : m_state)
+            word = splitmix64(seed);
+    }
+
+    result_type operator()(){
+        const std::uint64_t result = std::rotl(m_state[1] * 5, 7) * 9;
+        const std::uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = std::rotl(m_state[3], 45);
+        return result;
+    }
+
+    //Same as 2^128 calls : 2^128 non overlapping streams
+    void jump() { apply_jump(jump_polynomial); }
+    //Same as 2^192 calls, for a second level of splitting
+    void long_jump() { apply_jump(long_jump_polynomial); }
+
+    void discard(unsigned long long count){
+        for(; count > 0; --count)
+            (*this)();
+    }
+
+    const std::uint64_t* state() const { return m_state; }
+    bool operator==(const xoshiro256ss&) const = default;
+
+private:
+    static constexpr std::uint64_t jump_polynomial[] {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+    static constexpr std::uint64_t long_jump_polynomial[] {
+        0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull, 0x39109bb02acbe635ull};
+
+    void apply_jump(const std::uint64_t (&polynomial)[4]){
+        std::uint64_t result[4] {};
+        for(std::uint64_t word : polynomial){
+            for(unsigned bit{}; bit < 64; ++bit){
+                if(word & (std::uint64_t{1} << bit))
+                    for(unsigned i{}; i < 4; ++i)
+                        result[i] ^= m_state[i];
+                (*this)();
+            }
+        }
+        for(unsigned i{}; i < 4; ++i)
+            m_state[i] = result[i];
+    }
+
+private:
+    std::uint64_t m_state[4];
+};
+
+
+//PCG64 ( XSL RR 128/64 ) by O'Neill : a 128 bit linear congruential
+//generator, whose output is scrambled by a xor and a data dependent rotation.
+//Needs the 128 bit integers of GCC and Clang.
+class pcg64
+{
+public:
+    using result_type = std::uint64_t;
+    __extension__ using uint128 = unsigned __int128;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    //Engines with different streams never produce the same sequence
+    explicit pcg64(std::uint64_t seed = 0xcafef00dd15ea5e5ull, std::uint64_t stream = 0)
+        : m_increment((uint128{stream} << 1) | 1)
+    {
+        std::uint64_t mix {seed};
+        step();
+        m_state += (uint128{splitmix64(mix)} << 64) | splitmix64(mix);
+        step();
+    }
+
+    result_type operator()(){
+        step();
+        const auto rotation = static_cast<int>(m_state >> 122);
+        return std::rotr(static_cast<std::uint64_t>(m_state >> 64) ^ static_cast<std::uint64_t>(m_state), rotation);
+    }
+
+    //Skips count numbers in O(log count) steps : the state after n steps of
+    //x -> a * x + c is another a' * x + c', built by squaring
+    void advance(uint128 count){
+        uint128 total_multiplier {1}, total_increment {0};
+        uint128 multiplier {MULTIPLIER}, increment {m_increment};
+        for(; count > 0; count >>= 1){
+            if(count & 1){
+                total_multiplier *= multiplier;
+                total_increment = total_increment * multiplier + increment;
+            }
+            increment *= multiplier + 1;
+            multiplier *= multiplier;
+        }
+        m_state = total_multiplier * m_state + total_increment;
+    }
+
+    void discard(unsigned long long count) { advance(count); }
+
+    bool operator==(const pcg64&) const = default;
+
+private:
+    static constexpr uint128 MULTIPLIER = (uint128{2549297995355413924ull} << 64) | 4865540595714422341ull;
+
+    void step() { m_state = m_state * MULTIPLIER + m_increment; }
+
+private:
+    uint128 m_state {0};
+    uint128 m_increment;
+};
+
+
+//Philox4x32-10 by Salmon et al. ( Random123 ) : counter based. Block i of
+//the output is 10 rounds of multiplies and xors over the counter i, keyed by
+//the seed. There is no state to carry from one number to the next, so
+//skipping ahead is free and streams never overlap.
+class philox4x32
+{
+public:
+    using result_type = std::uint32_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    explicit philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0)
+        : m_key {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          m_counter {0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)}
+    {
+    }
+
+    result_type operator()(){
+        if(m_index == 4){
+            generate_block();
+            increment_counter(1);
+            m_index = 0;
+        }
+        return m_block[m_index++];
+    }
+
+    void discard(unsigned long long count){
+        const unsigned long long buffered = 4 - m_index;
+        if(count <= buffered){
+            m_index += static_cast<unsigned>(count);
+            return;
+        }
+        count -= buffered;
+        increment_counter(count / 4);
+        m_index = 4;
+        if(count % 4 != 0){
+            generate_block();
+            increment_counter(1);
+            m_index = static_cast<unsigned>(count % 4);
+        }
+    }
+
+    //The 4 numbers of block counter, for key : the building block
+    static void block(const std::uint32_t (&counter)[4], const std::uint32_t (&key)[2], std::uint32_t (&out)[4]){
+        std::uint32_t c0 {counter[0]}, c1 {counter[1]}, c2 {counter[2]}, c3 {counter[3]};
+        std::uint32_t k0 {key[0]}, k1 {key[1]};
+        for(int round{}; round < 10; ++round){
+            const std::uint64_t product0 = std::uint64_t{0xD2511F53u} * c0;
+            const std::uint64_t product1 = std::uint64_t{0xCD9E8D57u} * c2;
+            const auto hi0 = static_cast<std::uint32_t>(product0 >> 32), lo0 = static_cast<std::uint32_t>(product0);
+            const auto hi1 = static_cast<std::uint32_t>(product1 >> 32), lo1 = static_cast<std::uint32_t>(product1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    bool operator==(const philox4x32&) const = default;
+
+private:
+    void generate_block() { block(m_counter, m_key, m_block); }
+
+    //The low 64 bits of the counter number blocks, the high ones the stream
+    void increment_counter(unsigned long long count){
+        std::uint64_t low = (std::uint64_t{m_counter[1]} << 32) | m_counter[0];
+        low += count;
+        m_counter[0] = static_cast<std::uint32_t>(low);
+        m_counter[1] = static_cast<std::uint32_t>(low >> 32);
+    }
+
+private:
+    std::uint32_t m_key[2];
+    std::uint32_t m_counter[4];
+    std::uint32_t m_block[4] {};
+    unsigned m_index {4}; // 4 : the block is used up
+};
+
+#endif // RANDOM_ENGINES_H
@@ -0,0 +1,107 @@
+#ifndef ALIGNED_BUFFER_H
+#define ALIGNED_BUFFER_H
+
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "aligned_memory.h"
+
+//An owning array of count T's, like new T[count], with control over the
+//memory :
+//    aligned_buffer<double> salaries(size);                               // 64 byte aligned, garbage
+//    aligned_buffer<double> scores(size, {.init = Init::zeroed});         // All 0
+//    aligned_buffer<float> samples(size, {.alignment = 4096});
+//    aligned_buffer<double> grid(size);
+//    grid.first_touch_fill(0.0, threads); // Spread over the memory nodes
+//Elements are never constructed or destroyed one by one, so T must be a
+//type where garbage or zero bytes are a valid value : numbers, plain structs.
+//Freed automatically. Can be moved, not copied.
+template <typename T>
+    requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+class aligned_buffer
+{
+public:
+    aligned_buffer() = default;
+
+    explicit aligned_buffer(size_t count, const AllocationOptions& options = {})
+        : m_data(static_cast<T*>(allocate_aligned(byte_size(count), aligned_options(options)))),
+          m_size(count), m_alignment(aligned_options(options).alignment)
+    {
+    }
+
+    aligned_buffer(const aligned_buffer&) = delete;
+    aligned_buffer& operator=(const aligned_buffer&) = delete;
+
+    aligned_buffer(aligned_buffer&& source) noexcept
+        : m_data(std::exchange(source.m_data, nullptr)),
+          m_size(std::exchange(source.m_size, 0)),
+          m_alignment(source.m_alignment)
+    {
+    }
+
+    aligned_buffer& operator=(aligned_buffer&& source) noexcept{
+        if(this != &source){
+            free_aligned(m_data, m_size * sizeof(T), m_alignment);
+            m_data = std::exchange(source.m_data, nullptr);
+            m_size = std::exchange(source.m_size, 0);
+            m_alignment = source.m_alignment;
+        }
+        return *this;
+    }
+
+    ~aligned_buffer(){
+        free_aligned(m_data, m_size * sizeof(T), m_alignment);
+    }
+
+    //Writes value everywhere, each thread its own chunk. Run the code that
+    //uses the buffer with parallel_chunks(size(), threads, ...) too, and each
+    //thread finds its chunk on its own memory node.
+    void first_touch_fill(const T& value, unsigned threads = std::thread::hardware_concurrency()){
+        T* data = m_data;
+        parallel_chunks(m_size, threads, [data, &value](size_t begin, size_t end){
+            for(size_t i{begin}; i < end; ++i)
+                data[i] = value;
+        });
+    }
+
+    T& operator[](size_t index) { return m_data[index]; }
+    const T& operator[](size_t index) const { return m_data[index]; }
+
+    T* data() { return m_data; }
+    const T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    size_t alignment() const { return m_alignment; }
+    bool empty() const { return m_size == 0; }
+
+    T* begin() { return m_data; }
+    T* end() { return m_data + m_size; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+    std::span<T> span() { return {m_data, m_size}; }
+    std::span<const T> span() const { return {m_data, m_size}; }
+
+private:
+    //Same check as new T[count] does
+    static size_t byte_size(size_t count){
+        if(count > static_cast<size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+        return count * sizeof(T);
+    }
+
+    //At least the alignment T needs
+    static AllocationOptions aligned_options(AllocationOptions options){
+        if(options.alignment < alignof(T))
+            options.alignment = alignof(T);
+        return options;
+    }
+
+private:
+    T* m_data {nullptr};
+    size_t m_size {};
+    size_t m_alignment {alignof(T)};
+};
+
+#endif // ALIGNED_BUFFER_H
@@ -0,0 +1,122 @@
+#include "aligned_memory.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define ALIGNED_MEMORY_MMAP 1
+#endif
+
+namespace{
+
+bool mapped(size_t bytes, size_t alignment){
+#ifdef ALIGNED_MEMORY_MMAP
+    return bytes >= huge_page_size && alignment <= huge_page_size;
+#else
+    (void)bytes;
+    (void)alignment;
+    return false;
+#endif
+}
+
+size_t round_up(size_t value, size_t multiple){
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#ifdef ALIGNED_MEMORY_MMAP
+//Maps 2 MB more than needed, then gives back the parts before the first 2 MB
+//boundary and after the end : the kernel can only use huge pages for whole,
+//aligned 2 MB ranges. Fresh mappings read as zero, and no page exists
+//until it is first written : zeroed memory costs nothing up front.
+void* map_aligned(size_t bytes, HugePages huge_pages){
+    const size_t length = round_up(bytes, huge_page_size);
+    const size_t padded = length + huge_page_size;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(raw == MAP_FAILED)
+        return nullptr;
+
+    auto start = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = round_up(start, huge_page_size);
+    if(aligned > start)
+        munmap(raw, aligned - start);
+    const size_t tail = (start + padded) - (aligned + length);
+    if(tail > 0)
+        munmap(reinterpret_cast<void*>(aligned + length), tail);
+
+    //Only a hint : if the kernel says no, the memory is still usable
+    madvise(reinterpret_cast<void*>(aligned), length,
+            huge_pages == HugePages::advise ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+    return reinterpret_cast<void*>(aligned);
+}
+#endif
+
+} // namespace
+
+
+void* allocate_aligned(size_t bytes, const AllocationOptions& options, const std::nothrow_t&) noexcept{
+    if(bytes == 0)
+        bytes = 1;
+    if(options.alignment == 0 || (options.alignment & (options.alignment - 1)) != 0)
+        return nullptr;
+
+#ifdef ALIGNED_MEMORY_MMAP
+    if(mapped(bytes, options.alignment))
+        return map_aligned(bytes, options.huge_pages);
+#endif
+
+    const size_t alignment = std::max(options.alignment, sizeof(void*));
+    void* pointer = ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+    if(pointer && options.init == Init::zeroed)
+        std::memset(pointer, 0, bytes);
+    return pointer;
+}
+
+void* allocate_aligned(size_t bytes, const AllocationOptions& options){
+    void* pointer = allocate_aligned(bytes, options, std::nothrow);
+    if(!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void free_aligned(void* pointer, size_t bytes, size_t alignment) noexcept{
+    if(!pointer)
+        return;
+    if(bytes == 0)
+        bytes = 1;
+#ifdef ALIGNED_MEMORY_MMAP
+    if(mapped(bytes, alignment)){
+        munmap(pointer, round_up(bytes, huge_page_size));
+        return;
+    }
+#endif
+    ::operator delete(pointer, std::align_val_t(std::max(alignment, sizeof(void*))));
+}
+
+void parallel_chunks(size_t count, unsigned threads, const std::function<void(size_t, size_t)>& function){
+    if(threads <= 1 || count < threads){
+        function(0, count);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    const size_t chunk = (count + threads - 1) / threads;
+    for(unsigned t{1}; t < threads; ++t){
+        const size_t begin = std::min(count, t * chunk);
+        const size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(function, begin, end);
+    }
+    function(0, std::min(count, chunk)); // This thread takes the first chunk
+    for(std::thread& worker : workers)
+        worker.join();
+}
+
+std::string transparent_huge_pages_setting(){
+    std::ifstream file {"/sys/kernel/mm/transparent_hugepage/enabled"};
+    std::string setting;
+    if(!file || !std::getline(file, setting))
+        return "not available";
+    return setting;
+}
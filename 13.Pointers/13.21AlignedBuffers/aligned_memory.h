@@ -0,0 +1,65 @@
+#ifndef ALIGNED_MEMORY_H
+#define ALIGNED_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <string>
+
+//new double[size] gives memory aligned for a double ( 8 or 16 bytes ) and
+//nothing more : no say in the alignment, the page size, or where the memory
+//ends up on a machine with several memory nodes. For big numeric arrays
+//each of those costs time :
+//  - SIMD loads that straddle two cache lines are slower. 64 byte alignment
+//    means a 32 or 64 byte vector never does.
+//  - every 4 KB page needs a TLB entry. A few GB of 4 KB pages is far more
+//    than the TLB holds, and random accesses miss it all the time. A 2 MB huge
+//    page covers 512 times more memory per entry.
+//  - Linux places a page on the memory node of the thread that first writes
+//    to it. Initializing the array on one thread puts all of it on one node.
+
+enum class Init
+{
+    uninitialized, // Garbage, like new double[size]. Nothing is written.
+    zeroed         // Like new double[size]{}
+};
+
+enum class HugePages
+{
+    advise,  // Ask for huge pages on large allocations, madvise(MADV_HUGEPAGE)
+    avoid    // Ask for 4 KB pages, madvise(MADV_NOHUGEPAGE)
+};
+
+struct AllocationOptions
+{
+    size_t alignment {64};              // A power of two
+    Init init {Init::uninitialized};
+    HugePages huge_pages {HugePages::advise};
+};
+
+//Allocations from this size on are mapped straight from the system, 2 MB
+//aligned, and get the huge page hint. Smaller ones come from operator new.
+inline constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+//Throws std::bad_alloc on failure, like new. bytes must be passed back to
+//free_aligned, along with the same alignment.
+void* allocate_aligned(size_t bytes, const AllocationOptions& options = {});
+//Returns nullptr on failure, like new(std::nothrow)
+void* allocate_aligned(size_t bytes, const AllocationOptions& options, const std::nothrow_t&) noexcept;
+void free_aligned(void* pointer, size_t bytes, size_t alignment) noexcept;
+
+inline bool is_aligned(const void* pointer, size_t alignment){
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+//Splits [0, count) in threads equal chunks and calls function(begin, end)
+//on each from its own thread. Used to initialize memory from the threads
+//that will work on it later, with the same split, so each chunk's pages land
+//on the memory node of the thread using them ( "first touch" ).
+void parallel_chunks(size_t count, unsigned threads, const std::function<void(size_t, size_t)>& function);
+
+//The system setting for transparent huge pages, like "always [madvise] never"
+std::string transparent_huge_pages_setting();
+
+#endif // ALIGNED_MEMORY_H
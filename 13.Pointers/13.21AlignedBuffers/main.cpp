@@ -0,0 +1,173 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include "aligned_buffer.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ALIGNED_BUFFERS_X86 1
+#endif
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Memory of this process currently backed by huge pages, in KB
+size_t huge_pages_kb(){
+    std::ifstream file {"/proc/self/smaps_rollup"};
+    std::string name;
+    size_t value {};
+    while(file >> name){
+        if(name == "AnonHugePages:" && file >> value)
+            return value;
+        file.ignore(256, '\n');
+    }
+    return 0;
+}
+
+//Random reads all over the array : on big arrays nearly every one misses
+//the cache, and with 4 KB pages the TLB too
+[[gnu::noipa]] double random_reads(const double* data, size_t size, size_t reads){
+    std::uint64_t state {88172645463325252ull};
+    double sum {};
+    for(size_t i{}; i < reads; ++i){
+        state ^= state << 13; // xorshift
+        state ^= state >> 7;
+        state ^= state << 17;
+        sum += data[state % size];
+    }
+    return sum;
+}
+
+//Sums with 32 byte vector loads. Loads that cross a 64 byte line boundary
+//need two cache accesses.
+#ifdef ALIGNED_BUFFERS_X86
+__attribute__((target("avx2"), noipa))
+double sum_vectors(const double* data, size_t size){
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+    size_t i {};
+    for(; i + 8 <= size; i += 8){
+        sum0 = _mm256_add_pd(sum0, _mm256_loadu_pd(data + i));
+        sum1 = _mm256_add_pd(sum1, _mm256_loadu_pd(data + i + 4));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(sum0, sum1));
+    double sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for(; i < size; ++i)
+        sum += data[i];
+    return sum;
+}
+#else
+[[gnu::noipa]] double sum_vectors(const double* data, size_t size){
+    double sum {};
+    for(size_t i{}; i < size; ++i)
+        sum += data[i];
+    return sum;
+}
+#endif
+
+
+int main(int argc, char** argv){
+
+    const size_t size{10};
+
+    //The ways of 13.20, with aligned buffers. No delete [] : the buffers free
+    //their memory when they go out of scope.
+    aligned_buffer<double> salaries(size);                               // Garbage values
+    aligned_buffer<int> students(size, {.init = Init::zeroed});          // All 0
+    aligned_buffer<double> scores(size, {.alignment = 256, .init = Init::zeroed});
+    for(size_t i{}; i < 5; ++i)
+        scores[i] = static_cast<double>(i + 1);                          // 1,2,3,4,5,0,0,...
+
+    for(double score : scores)
+        std::cout << score << " ";
+    std::cout << std::endl;
+    std::cout << "students[3] : " << students[3] << std::endl;
+
+    double* p_salaries { new double[size] };
+    std::cout << "new double[] address % 64 : " << reinterpret_cast<std::uintptr_t>(p_salaries) % 64
+              << " (only 16 is promised)" << std::endl;
+    std::cout << "salaries 64 byte aligned : " << std::boolalpha << is_aligned(salaries.data(), 64) << std::endl;
+    std::cout << "scores 256 byte aligned : " << is_aligned(scores.data(), 256) << std::endl;
+    delete [] p_salaries;
+    p_salaries = nullptr;
+
+    //Like new(std::nothrow) : nullptr instead of an exception
+    void* too_much = allocate_aligned(size_t{1} << 62, {}, std::nothrow);
+    std::cout << "2^62 bytes with std::nothrow : " << (too_much ? "allocated" : "nullptr") << std::endl;
+    try{
+        aligned_buffer<double> huge(size_t{1} << 60);
+    }catch(const std::bad_alloc& ex){
+        std::cout << "2^60 doubles : " << ex.what() << std::endl;
+    }
+
+    std::cout << "transparent huge pages : " << transparent_huge_pages_setting() << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : a big numeric array. Default 1024 MB, can be changed from
+    //the command line ( in MB ).
+    size_t megabytes = (argc > 1) ? std::stoul(argv[1]) : 1024;
+    size_t count = megabytes * 1024 * 1024 / sizeof(double);
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    //Zeroing : new double[count]{} writes every byte up front, a fresh
+    //mapping is zero already and pages only appear when used
+    double sum {};
+    double new_ms = time_ms([&]{
+        double* p_data { new double[count]{} };
+        sum += p_data[count / 2];
+        delete [] p_data;
+    });
+    double zeroed_ms = time_ms([&]{
+        aligned_buffer<double> data(count, {.init = Init::zeroed});
+        sum += data[count / 2];
+    });
+    std::cout << megabytes << " MB zeroed, new double[]{} : " << new_ms << " ms, aligned_buffer : " << zeroed_ms
+              << " ms (" << sum << ")" << std::endl;
+
+    //Page size : the same random reads over 4 KB pages and over 2 MB pages
+    const size_t reads {20'000'000};
+    {
+        aligned_buffer<double> small_pages(count, {.huge_pages = HugePages::avoid});
+        double fill_ms = time_ms([&]{ small_pages.first_touch_fill(1.0, threads); });
+        double small_ms = time_ms([&]{ sum = random_reads(small_pages.data(), count, reads); });
+        std::cout << "4 KB pages : first touch " << fill_ms << " ms, " << reads << " random reads " << small_ms
+                  << " ms (" << sum << ", " << huge_pages_kb() / 1024 << " MB in huge pages)" << std::endl;
+    }
+    {
+        aligned_buffer<double> huge_pages(count, {.huge_pages = HugePages::advise});
+        double fill_ms = time_ms([&]{ huge_pages.first_touch_fill(1.0, threads); });
+        double huge_ms = time_ms([&]{ sum = random_reads(huge_pages.data(), count, reads); });
+        std::cout << "2 MB pages : first touch " << fill_ms << " ms, " << reads << " random reads " << huge_ms
+                  << " ms (" << sum << ", " << huge_pages_kb() / 1024 << " MB in huge pages)" << std::endl;
+    }
+
+    //Alignment : summing 16 KB ( fits in the L1 cache ) over and over, from a
+    //64 byte boundary, and 8 bytes past one
+    const size_t block {2048};
+    const size_t repeats {200'000};
+    aligned_buffer<double> numbers(block + 8);
+    for(size_t i{}; i < numbers.size(); ++i)
+        numbers[i] = static_cast<double>(i % 7);
+    double aligned_ms = time_ms([&]{
+        for(size_t r{}; r < repeats; ++r)
+            sum += sum_vectors(numbers.data(), block);
+    });
+    double misaligned_ms = time_ms([&]{
+        for(size_t r{}; r < repeats; ++r)
+            sum += sum_vectors(numbers.data() + 1, block);
+    });
+    std::cout << "vector sums, 64 byte aligned : " << aligned_ms << " ms, 8 bytes off : " << misaligned_ms
+              << " ms (" << sum << ")" << std::endl;
+
+    return 0;
+}
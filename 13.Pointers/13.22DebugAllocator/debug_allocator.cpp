@@ -0,0 +1,705 @@
+#include "debug_allocator.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <dlfcn.h>
+#define DEBUG_ALLOCATOR_DLADDR 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DEBUG_ALLOCATOR_CALLER __builtin_return_address(0)
+#else
+#define DEBUG_ALLOCATOR_CALLER nullptr
+#endif
+
+namespace{
+
+enum class Kind : std::uint8_t { single, array };
+
+constexpr std::uint32_t LIVE = 0x4C495645;     // "LIVE"
+constexpr std::uint32_t SAMPLED = 0x53414D50;  // "SAMP" : live, and tracked
+constexpr std::uint32_t FREED = 0x46524545;    // "FREE" : sampled, in the quarantine
+constexpr std::uint64_t GUARD = 0xFDFDFDFDFDFDFDFDull;
+constexpr std::uint16_t FRONT_GUARD = 0xFDFD;
+constexpr unsigned char POISON = 0xDD;
+constexpr size_t POISON_MAX = 64 * 1024; // Bigger blocks go straight back to malloc
+
+struct ThreadHeap;
+
+//Sits right before every block handed out. 16 bytes : a new int still fits
+//the 32 byte chunks malloc would have used for it.
+struct alignas(16) BlockHeader
+{
+    size_t size;
+    std::uint32_t state;          // LIVE, SAMPLED or FREED
+    Kind kind;
+    std::uint8_t alignment_shift; // log2 of the alignment asked for
+    std::uint16_t guard;          // Catches writes just before the block
+};
+static_assert(sizeof(BlockHeader) == 16);
+
+//Sampled blocks only, right before their BlockHeader : where they were
+//allocated, and the links of the live list or the quarantine. Once the
+//block is freed, the guard word after it holds where it was freed.
+struct TrackedHeader
+{
+    TrackedHeader* prev;
+    TrackedHeader* next;
+    ThreadHeap* heap;             // The heap whose live list holds the block
+    const void* allocated_at;
+};
+static_assert(sizeof(TrackedHeader) % 16 == 0);
+
+struct BlockList
+{
+    TrackedHeader* head {nullptr};
+    TrackedHeader* tail {nullptr};
+
+    void push_back(TrackedHeader* block){
+        block->prev = tail;
+        block->next = nullptr;
+        (tail ? tail->next : head) = block;
+        tail = block;
+    }
+
+    void remove(TrackedHeader* block){
+        (block->prev ? block->prev->next : head) = block->next;
+        (block->next ? block->next->prev : tail) = block->prev;
+    }
+
+    TrackedHeader* pop_front(){
+        TrackedHeader* block = head;
+        head = block->next;
+        (head ? head->prev : tail) = nullptr;
+        return block;
+    }
+};
+
+//Each counter has a single writer : the thread owning the heap, or whoever
+//holds registry_lock for the heaps no thread owns. A load and a store, no
+//locked instruction : other threads only ever read them.
+struct HeapCounters
+{
+    std::atomic<size_t> live_blocks {};
+    std::atomic<size_t> live_bytes {};
+    std::atomic<size_t> total_allocations {};
+    std::atomic<size_t> quarantined_bytes {};
+    std::atomic<size_t> double_frees {};
+    std::atomic<size_t> invalid_frees {};
+    std::atomic<size_t> mismatched_frees {};
+    std::atomic<size_t> overflows {};
+    std::atomic<size_t> writes_after_free {};
+};
+
+void add(std::atomic<size_t>& counter, size_t amount){
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void subtract(std::atomic<size_t>& counter, size_t amount){
+    counter.store(counter.load(std::memory_order_relaxed) - amount, std::memory_order_relaxed);
+}
+
+std::atomic<size_t> sample_interval {DEFAULT_SAMPLE_INTERVAL};
+std::atomic<size_t> quarantine_limit {1024 * 1024};
+
+//One per thread : the sampled blocks it allocated, the ones it freed and
+//holds back, and its counters. Only the owning thread touches the lists,
+//so new and delete take no lock. A sampled block deleted by another thread
+//is pushed on remote_frees, and the owner takes it off its live list at its
+//next sampled new.
+//A heap outlives its thread : when the thread ends, the heap is left to the
+//next thread that starts, with the blocks it still has.
+struct ThreadHeap
+{
+    BlockList live_blocks;
+    BlockList quarantine;
+    HeapCounters counters;
+    size_t until_sample {1};
+    std::uint64_t random_state {0x9E3779B97F4A7C15ull};
+    ThreadHeap* next_heap {nullptr};
+    std::atomic<bool> owned {false};
+    //Written by the other threads : on its own cache line
+    alignas(64) std::atomic<TrackedHeader*> remote_frees {nullptr};
+
+    //The gap to the next sampled new is random, interval on average : a
+    //fixed one could keep sampling the same call site of a loop
+    bool take_sample(){
+        if(--until_sample)
+            return false;
+        const size_t interval = sample_interval.load(std::memory_order_relaxed);
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        until_sample = interval ? 1 + random_state % (2 * interval - 1) : static_cast<size_t>(-1);
+        return interval != 0;
+    }
+};
+
+//All constant initialized : usable by the new calls that run during static
+//initialization, before any constructor in this file.
+//shared_heap is for the new calls of a thread whose heap is gone, like the
+//static destructors running after the main thread's heap was given up. No
+//thread owns it : it is only touched under registry_lock, like the heaps of
+//threads that have ended.
+std::mutex registry_lock;
+ThreadHeap shared_heap;
+ThreadHeap* heaps {&shared_heap};   // Every heap ever made, never freed
+
+enum class HeapState : std::uint8_t { none, attaching, attached, ended };
+thread_local ThreadHeap* current_heap {nullptr};
+thread_local HeapState heap_state {HeapState::none};
+
+unsigned char* user_pointer(BlockHeader* block){
+    return reinterpret_cast<unsigned char*>(block + 1);
+}
+
+BlockHeader* header_of(void* pointer){
+    return static_cast<BlockHeader*>(pointer) - 1;
+}
+
+TrackedHeader* tracked_of(BlockHeader* block){
+    return reinterpret_cast<TrackedHeader*>(block) - 1;
+}
+
+BlockHeader* block_of(TrackedHeader* tracked){
+    return reinterpret_cast<BlockHeader*>(tracked + 1);
+}
+
+bool is_sampled(BlockHeader* block){
+    return block->state == SAMPLED || block->state == FREED;
+}
+
+//Alignments are powers of two : a mask, not a division
+size_t round_up(size_t size, size_t alignment){
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+//The headers end where the block starts, on an alignment boundary
+size_t header_space(size_t alignment, bool sampled){
+    return round_up(sizeof(BlockHeader) + (sampled ? sizeof(TrackedHeader) : 0), alignment);
+}
+
+void* raw_of(BlockHeader* block){
+    return user_pointer(block) - header_space(size_t{1} << block->alignment_shift, is_sampled(block));
+}
+
+//Memory the block really holds on to, headers and guard included
+size_t footprint(BlockHeader* block){
+    return header_space(size_t{1} << block->alignment_shift, is_sampled(block)) + block->size + sizeof(GUARD);
+}
+
+bool guard_intact(BlockHeader* block){
+    std::uint64_t after;
+    std::memcpy(&after, user_pointer(block) + block->size, sizeof(after));
+    return block->guard == FRONT_GUARD && after == GUARD;
+}
+
+//Freed blocks only : the guard after the block is no longer needed
+const void* freed_at(BlockHeader* block){
+    const void* site;
+    std::memcpy(&site, user_pointer(block) + block->size, sizeof(site));
+    return site;
+}
+
+void set_freed_at(BlockHeader* block, const void* site){
+    std::memcpy(user_pointer(block) + block->size, &site, sizeof(site));
+}
+
+//8 bytes at a time, then the few left
+bool poison_intact(BlockHeader* block){
+    const unsigned char* data = user_pointer(block);
+    constexpr std::uint64_t poison_word = 0x0101010101010101ull * POISON;
+    size_t i {};
+    for(; i + 8 <= block->size; i += 8){
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if(word != poison_word)
+            return false;
+    }
+    for(; i < block->size; ++i)
+        if(data[i] != POISON)
+            return false;
+    return true;
+}
+
+//module+offset, and the symbol name when there is one
+void print_site(std::FILE* out, const void* address){
+#ifdef DEBUG_ALLOCATOR_DLADDR
+    Dl_info info;
+    if(address && dladdr(address, &info) && info.dli_fname){
+        const auto offset = reinterpret_cast<std::uintptr_t>(address) - reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+        std::fprintf(out, "%s+0x%zx", info.dli_fname, static_cast<size_t>(offset));
+        if(info.dli_sname)
+            std::fprintf(out, " (%s)", info.dli_sname);
+        return;
+    }
+#endif
+    std::fprintf(out, "%p", address);
+}
+
+//Call sites are only known for sampled blocks
+void report(const char* problem, BlockHeader* block, const void* site){
+    std::fprintf(stderr, "debug allocator : %s, %zu byte block at %p\n", problem, block->size,
+                 static_cast<void*>(user_pointer(block)));
+    if(is_sampled(block)){
+        std::fprintf(stderr, "    allocated at ");
+        print_site(stderr, tracked_of(block)->allocated_at);
+        std::fprintf(stderr, "\n");
+    }
+    if(block->state == FREED){
+        std::fprintf(stderr, "    freed at ");
+        print_site(stderr, freed_at(block));
+        std::fprintf(stderr, "\n");
+    }
+    if(site){
+        std::fprintf(stderr, "    detected at ");
+        print_site(stderr, site);
+        std::fprintf(stderr, "\n");
+    }
+}
+
+//Oldest blocks leave the quarantine until it fits its limit again
+void trim_quarantine(ThreadHeap& heap, size_t limit){
+    size_t quarantined = heap.counters.quarantined_bytes.load(std::memory_order_relaxed);
+    while(heap.quarantine.head && quarantined > limit){
+        BlockHeader* block = block_of(heap.quarantine.pop_front());
+        quarantined -= footprint(block);
+        if(!poison_intact(block)){
+            add(heap.counters.writes_after_free, 1);
+            report("write after delete", block, nullptr);
+        }
+        void* raw = raw_of(block);
+        block->state = 0;
+        std::free(raw);
+    }
+    heap.counters.quarantined_bytes.store(quarantined, std::memory_order_relaxed);
+}
+
+//The end of a sampled block's delete, once it passed the checks : off the
+//live list, into the quarantine. Counted out of the heap that counted it in.
+void retire(ThreadHeap& heap, BlockHeader* block){
+    TrackedHeader* tracked = tracked_of(block);
+    heap.live_blocks.remove(tracked);
+    subtract(heap.counters.live_blocks, 1);
+    subtract(heap.counters.live_bytes, block->size);
+
+    const size_t limit = quarantine_limit.load(std::memory_order_relaxed);
+    if(block->size > POISON_MAX || limit == 0){
+        void* raw = raw_of(block);
+        block->state = 0;
+        std::free(raw);
+        return;
+    }
+    std::memset(user_pointer(block), POISON, block->size);
+    heap.quarantine.push_back(tracked);
+    add(heap.counters.quarantined_bytes, footprint(block));
+    trim_quarantine(heap, limit);
+}
+
+//Sampled blocks other threads deleted. They are linked through their heap
+//member : the heap they go back to is the one holding the list.
+void retire_remote_frees(ThreadHeap& heap){
+    TrackedHeader* tracked = heap.remote_frees.exchange(nullptr, std::memory_order_acquire);
+    while(tracked){
+        TrackedHeader* next = reinterpret_cast<TrackedHeader*>(tracked->heap);
+        retire(heap, block_of(tracked));
+        tracked = next;
+    }
+}
+
+void push_remote_free(ThreadHeap& heap, TrackedHeader* tracked){
+    TrackedHeader* head = heap.remote_frees.load(std::memory_order_relaxed);
+    do{
+        tracked->heap = reinterpret_cast<ThreadHeap*>(head);
+    }while(!heap.remote_frees.compare_exchange_weak(head, tracked, std::memory_order_release, std::memory_order_relaxed));
+}
+
+//Gives the heap up when the thread ends. Registered the first time the
+//thread calls new.
+struct HeapReleaser
+{
+    ~HeapReleaser(){
+        ThreadHeap* heap = current_heap;
+        current_heap = nullptr;
+        heap_state = HeapState::ended;
+        if(!heap)
+            return;
+        std::lock_guard guard {registry_lock};
+        retire_remote_frees(*heap);
+        trim_quarantine(*heap, 0);
+        heap->owned.store(false, std::memory_order_release);
+    }
+};
+thread_local HeapReleaser heap_releaser;
+
+//A heap for this thread : one left by a thread that ended, or a new one
+ThreadHeap* attach_heap(){
+    heap_state = HeapState::attaching; // new calls from here on use shared_heap
+    (void)&heap_releaser;              // Registers its destructor, with calloc
+
+    ThreadHeap* heap {nullptr};
+    {
+        std::lock_guard guard {registry_lock};
+        for(ThreadHeap* candidate = heaps; candidate; candidate = candidate->next_heap){
+            if(candidate != &shared_heap && !candidate->owned.load(std::memory_order_relaxed)){
+                heap = candidate;
+                break;
+            }
+        }
+        if(!heap){
+            void* memory = std::aligned_alloc(alignof(ThreadHeap), sizeof(ThreadHeap));
+            if(!memory){
+                heap_state = HeapState::none;
+                return nullptr;
+            }
+            heap = new (memory) ThreadHeap;
+            //Never 0 : the top bits of the seed stay set
+            heap->random_state ^= reinterpret_cast<std::uintptr_t>(heap) >> 4;
+            heap->next_heap = heaps;
+            heaps = heap;
+        }
+        retire_remote_frees(*heap);
+        heap->owned.store(true, std::memory_order_relaxed);
+    }
+    current_heap = heap;
+    heap_state = HeapState::attached;
+    return heap;
+}
+
+//nullptr : use shared_heap, under registry_lock
+ThreadHeap* this_thread_heap(){
+    if(ThreadHeap* heap = current_heap)
+        return heap;
+    if(heap_state != HeapState::none)
+        return nullptr;
+    return attach_heap();
+}
+
+void track(ThreadHeap& heap, BlockHeader* block, const void* site){
+    if(heap.remote_frees.load(std::memory_order_relaxed))
+        retire_remote_frees(heap);
+    TrackedHeader* tracked = tracked_of(block);
+    tracked->heap = &heap;
+    tracked->allocated_at = site;
+    heap.live_blocks.push_back(tracked);
+    add(heap.counters.live_blocks, 1);
+    add(heap.counters.live_bytes, block->size);
+    add(heap.counters.total_allocations, 1);
+}
+
+BlockHeader* init_block(void* raw, size_t space, size_t size, bool sampled, Kind kind, size_t alignment){
+    auto block = reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(raw) + space) - 1;
+    block->size = size;
+    block->state = sampled ? SAMPLED : LIVE;
+    block->kind = kind;
+    block->alignment_shift = static_cast<std::uint8_t>(std::countr_zero(alignment));
+    block->guard = FRONT_GUARD;
+    std::memcpy(user_pointer(block) + size, &GUARD, sizeof(GUARD));
+    return block;
+}
+
+//Sampled blocks, over-aligned ones, and malloc failures
+[[gnu::noinline]] void* allocate_slow(size_t size, size_t alignment, Kind kind, const void* site, bool nothrow,
+                                      ThreadHeap* heap, bool sampled){
+    alignment = alignment < alignof(BlockHeader) ? alignof(BlockHeader) : alignment;
+    const size_t space = header_space(alignment, sampled);
+    if(size > static_cast<size_t>(-1) - space - sizeof(GUARD) - alignment){
+        if(nothrow)
+            return nullptr;
+        throw std::bad_alloc();
+    }
+    const size_t total = space + size + sizeof(GUARD);
+
+    void* raw;
+    for(;;){
+        raw = alignment == alignof(BlockHeader)
+                  ? std::malloc(total)
+                  : std::aligned_alloc(alignment, round_up(total, alignment));
+        if(raw)
+            break;
+        //Same contract as the standard operator new
+        std::new_handler handler = std::get_new_handler();
+        if(!handler){
+            if(nothrow)
+                return nullptr;
+            throw std::bad_alloc();
+        }
+        if(nothrow){
+            try{
+                handler();
+            }catch(...){
+                return nullptr;
+            }
+        }else{
+            handler();
+        }
+    }
+
+    BlockHeader* block = init_block(raw, space, size, sampled, kind, alignment);
+    if(sampled){
+        if(heap){
+            track(*heap, block, site);
+        }else{
+            std::lock_guard guard {registry_lock};
+            track(shared_heap, block, site);
+        }
+    }
+    return user_pointer(block);
+}
+
+void* allocate(size_t size, size_t alignment, Kind kind, const void* site, bool nothrow){
+    ThreadHeap* heap = this_thread_heap();
+    bool sampled;
+    if(heap){
+        sampled = heap->take_sample();
+    }else{
+        std::lock_guard guard {registry_lock};
+        sampled = shared_heap.take_sample();
+    }
+
+    //Most news : not sampled, malloc's alignment is enough
+    constexpr size_t extra = sizeof(BlockHeader) + sizeof(GUARD);
+    if(!sampled && alignment <= alignof(BlockHeader) && size <= static_cast<size_t>(-1) - extra){
+        if(void* raw = std::malloc(size + extra))
+            return user_pointer(init_block(raw, sizeof(BlockHeader), size, false, kind, alignof(BlockHeader)));
+    }
+    return allocate_slow(size, alignment, kind, site, nothrow, heap, sampled);
+}
+
+//The checks of a delete. Problems are counted in the deleting thread's
+//heap. False : leave the block alone.
+bool release_checks(BlockHeader* block, Kind kind, const void* site, HeapCounters& counters){
+    if(block->state == FREED){
+        //Still in the quarantine : the memory is ours, and was freed before
+        add(counters.double_frees, 1);
+        report("double delete", block, site);
+        return false;
+    }
+    if(block->state != LIVE && block->state != SAMPLED){
+        //Not sampled blocks go back to malloc at once, which writes over
+        //their header : a second delete lands here too
+        add(counters.invalid_frees, 1);
+        std::fprintf(stderr, "debug allocator : delete of %p, which new did not return ( or was already freed )\n    at ",
+                     static_cast<void*>(user_pointer(block)));
+        print_site(stderr, site);
+        std::fprintf(stderr, "\n");
+        return false; // Leave it alone : handing it to free would corrupt the heap
+    }
+    if(!guard_intact(block)){
+        add(counters.overflows, 1);
+        report("write outside the block", block, site);
+    }
+    if(block->kind != kind){
+        add(counters.mismatched_frees, 1);
+        report(kind == Kind::single ? "new[] released with delete" : "new released with delete[]", block, site);
+    }
+    return true;
+}
+
+//A sampled block back to the heap holding it. heap : the deleting thread's,
+//nullptr under registry_lock.
+void release_sampled(ThreadHeap* heap, BlockHeader* block, const void* site){
+    block->state = FREED;
+    set_freed_at(block, site);
+
+    TrackedHeader* tracked = tracked_of(block);
+    ThreadHeap* owner = tracked->heap;
+    if(owner == heap){
+        retire(*heap, block);
+        return;
+    }
+    if(heap && owner->owned.load(std::memory_order_acquire)){
+        push_remote_free(*owner, tracked);
+        return;
+    }
+    //Allocated by a thread that has ended, or deleted by one
+    std::unique_lock guard {registry_lock, std::defer_lock};
+    if(heap)
+        guard.lock();
+    if(owner->owned.load(std::memory_order_relaxed))
+        push_remote_free(*owner, tracked);
+    else
+        retire(*owner, block);
+}
+
+//A delete that found something wrong, or a sampled block
+void release_slow(BlockHeader* block, Kind kind, const void* site){
+    if(ThreadHeap* heap = this_thread_heap()){
+        if(!release_checks(block, kind, site, heap->counters))
+            return;
+        if(block->state == SAMPLED){
+            release_sampled(heap, block, site);
+            return;
+        }
+    }else{
+        std::lock_guard guard {registry_lock};
+        if(!release_checks(block, kind, site, shared_heap.counters))
+            return;
+        if(block->state == SAMPLED){
+            release_sampled(nullptr, block, site);
+            return;
+        }
+    }
+    void* raw = raw_of(block);
+    block->state = 0;
+    std::free(raw);
+}
+
+//Not sampled, and nothing wrong : straight back to malloc, with no look at
+//the thread's heap
+void release(void* pointer, Kind kind, const void* site) noexcept{
+    if(!pointer)
+        return;
+    BlockHeader* block = header_of(pointer);
+    if(block->state == LIVE && block->kind == kind && guard_intact(block)){
+        void* raw = raw_of(block);
+        block->state = 0; // A second delete must not find it LIVE
+        std::free(raw);
+        return;
+    }
+    release_slow(block, kind, site);
+}
+
+//The heaps whose lists this thread may walk : its own, and the ones no thread
+//owns. Called under registry_lock.
+template <typename Function>
+void for_each_visible_heap(Function function){
+    for(ThreadHeap* heap = heaps; heap; heap = heap->next_heap){
+        if(heap == current_heap || !heap->owned.load(std::memory_order_acquire)){
+            retire_remote_frees(*heap);
+            function(*heap);
+        }
+    }
+}
+
+//After every static destructor has run : what is still live now leaked
+__attribute__((destructor)) void report_at_exit(){
+    report_leaks(stderr);
+}
+
+} // namespace
+
+
+DebugAllocatorStats debug_allocator_stats(){
+    DebugAllocatorStats stats;
+    std::lock_guard guard {registry_lock};
+    for_each_visible_heap([](ThreadHeap&){}); // Takes the blocks other threads deleted off the live lists
+    for(ThreadHeap* heap = heaps; heap; heap = heap->next_heap){
+        const HeapCounters& counters = heap->counters;
+        stats.live_blocks += counters.live_blocks.load(std::memory_order_relaxed);
+        stats.live_bytes += counters.live_bytes.load(std::memory_order_relaxed);
+        stats.total_allocations += counters.total_allocations.load(std::memory_order_relaxed);
+        stats.quarantined_bytes += counters.quarantined_bytes.load(std::memory_order_relaxed);
+        stats.double_frees += counters.double_frees.load(std::memory_order_relaxed);
+        stats.invalid_frees += counters.invalid_frees.load(std::memory_order_relaxed);
+        stats.mismatched_frees += counters.mismatched_frees.load(std::memory_order_relaxed);
+        stats.overflows += counters.overflows.load(std::memory_order_relaxed);
+        stats.writes_after_free += counters.writes_after_free.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+size_t report_leaks(std::FILE* out, size_t max_blocks){
+    const DebugAllocatorStats stats = debug_allocator_stats();
+    if(stats.live_blocks == 0)
+        return 0;
+    std::fprintf(out, "debug allocator : %zu sampled blocks ( %zu bytes ) still live\n", stats.live_blocks, stats.live_bytes);
+    std::lock_guard guard {registry_lock};
+    size_t printed {};
+    for_each_visible_heap([&](ThreadHeap& heap){
+        for(TrackedHeader* tracked = heap.live_blocks.head; tracked && printed < max_blocks; tracked = tracked->next, ++printed){
+            std::fprintf(out, "    %zu bytes at %p, allocated at ", block_of(tracked)->size,
+                         static_cast<void*>(user_pointer(block_of(tracked))));
+            print_site(out, tracked->allocated_at);
+            std::fprintf(out, "\n");
+        }
+    });
+    if(stats.live_blocks > printed)
+        std::fprintf(out, "    ... and %zu more\n", stats.live_blocks - printed);
+    return stats.live_blocks;
+}
+
+bool check_heap(){
+    std::lock_guard guard {registry_lock};
+    bool clean {true};
+    for_each_visible_heap([&](ThreadHeap& heap){
+        for(TrackedHeader* tracked = heap.live_blocks.head; tracked; tracked = tracked->next){
+            if(!guard_intact(block_of(tracked))){
+                add(heap.counters.overflows, 1);
+                report("write outside the block", block_of(tracked), nullptr);
+                clean = false;
+            }
+        }
+        for(TrackedHeader* tracked = heap.quarantine.head; tracked; tracked = tracked->next){
+            BlockHeader* block = block_of(tracked);
+            if(!poison_intact(block)){
+                add(heap.counters.writes_after_free, 1);
+                report("write after delete", block, nullptr);
+                std::memset(user_pointer(block), POISON, block->size); // Report it once
+                clean = false;
+            }
+        }
+    });
+    return clean;
+}
+
+void set_quarantine_limit(size_t bytes){
+    quarantine_limit.store(bytes, std::memory_order_relaxed);
+    std::lock_guard guard {registry_lock};
+    for_each_visible_heap([&](ThreadHeap& heap){
+        trim_quarantine(heap, bytes);
+    });
+}
+
+void set_sample_interval(size_t interval){
+    sample_interval.store(interval, std::memory_order_relaxed);
+    if(ThreadHeap* heap = this_thread_heap())
+        heap->until_sample = 1; // This thread's next new picks the new gap
+}
+
+
+//The replaceable global allocation functions. The call site is the return
+//address of operator new : the code that said new.
+void* operator new(size_t size){
+    return allocate(size, alignof(std::max_align_t), Kind::single, DEBUG_ALLOCATOR_CALLER, false);
+}
+void* operator new[](size_t size){
+    return allocate(size, alignof(std::max_align_t), Kind::array, DEBUG_ALLOCATOR_CALLER, false);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept{
+    return allocate(size, alignof(std::max_align_t), Kind::single, DEBUG_ALLOCATOR_CALLER, true);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept{
+    return allocate(size, alignof(std::max_align_t), Kind::array, DEBUG_ALLOCATOR_CALLER, true);
+}
+void* operator new(size_t size, std::align_val_t alignment){
+    return allocate(size, static_cast<size_t>(alignment), Kind::single, DEBUG_ALLOCATOR_CALLER, false);
+}
+void* operator new[](size_t size, std::align_val_t alignment){
+    return allocate(size, static_cast<size_t>(alignment), Kind::array, DEBUG_ALLOCATOR_CALLER, false);
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    return allocate(size, static_cast<size_t>(alignment), Kind::single, DEBUG_ALLOCATOR_CALLER, true);
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    return allocate(size, static_cast<size_t>(alignment), Kind::array, DEBUG_ALLOCATOR_CALLER, true);
+}
+
+void operator delete(void* pointer) noexcept { release(pointer, Kind::single, DEBUG_ALLOCATOR_CALLER); }
+void operator delete[](void* pointer) noexcept { release(pointer, Kind::array, DEBUG_ALLOCATOR_CALLER); }
+void operator delete(void* pointer, size_t) noexcept { release(pointer, Kind::single, DEBUG_ALLOCATOR_CALLER); }
+void operator delete[](void* pointer, size_t) noexcept { release(pointer, Kind::array, DEBUG_ALLOCATOR_CALLER); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { release(pointer, Kind::single, DEBUG_ALLOCATOR_CALLER); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { release(pointer, Kind::array, DEBUG_ALLOCATOR_CALLER); }
+void operator delete(void* pointer, std::align_val_t) noexcept { release(pointer, Kind::single, DEBUG_ALLOCATOR_CALLER); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { release(pointer, Kind::array, DEBUG_ALLOCATOR_CALLER); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { release(pointer, Kind::single, DEBUG_ALLOCATOR_CALLER); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { release(pointer, Kind::array, DEBUG_ALLOCATOR_CALLER); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer, Kind::single, DEBUG_ALLOCATOR_CALLER); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer, Kind::array, DEBUG_ALLOCATOR_CALLER); }
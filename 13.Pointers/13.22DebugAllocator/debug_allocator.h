@@ -0,0 +1,78 @@
+#ifndef DEBUG_ALLOCATOR_H
+#define DEBUG_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdio>
+
+//A debugging replacement for the global operator new and operator delete.
+//Compiling debug_allocator.cpp into a program turns it on for every new and
+//delete in the program, library code included. Leave the file out to go
+//back to the normal allocator : nothing else changes.
+//
+//What it catches :
+//  - leaks : sampled blocks remember where they were allocated. The ones
+//    still live when the program ends are reported, with that call site.
+//  - new[] released with delete, or new with delete[].
+//  - writes past the end of a block ( a guard word after each block ).
+//  - delete of a pointer that new never returned, or deleted already.
+//  - for sampled blocks, double delete and writes through dangling
+//    pointers : freed memory is filled with 0xDD and held back for a while
+//    instead of being reused, in a quarantine. When a block leaves the
+//    quarantine, or at check_heap(), the fill is checked. Reads through
+//    dangling pointers see 0xDDDDDDDD instead of old values.
+//Problems are printed to stderr as they are found. Call sites are printed as
+//module+offset : addr2line -f -C -e <module> <offset> gives file and line
+//when the program is built with -g.
+//
+//Cost : tracking every block, with its list links, call site and time in
+//the quarantine, makes new / delete 3 to 4 times slower than malloc. That
+//is fine while debugging, set_sample_interval(1), but too much for a canary
+//in production. By default only about one new in DEFAULT_SAMPLE_INTERVAL is
+//tracked, and the others only pay for a 16 byte header and the guard word :
+//under 2x on new int / delete, alone or with several threads, and a bug
+//that happens often gets caught soon enough.
+//Each thread keeps its own sampled blocks and quarantine : new and delete
+//take no lock. report_leaks() and check_heap() see the blocks of the
+//calling thread and of the threads that have ended.
+//
+//It is not AddressSanitizer : nothing checks individual loads and stores,
+//and once a freed block leaves the quarantine its memory is reused.
+
+constexpr size_t DEFAULT_SAMPLE_INTERVAL {64};
+
+//Blocks and bytes : the sampled blocks only. Problems : all of them.
+struct DebugAllocatorStats
+{
+    size_t live_blocks {};
+    size_t live_bytes {};
+    size_t total_allocations {};
+    size_t quarantined_bytes {};
+    size_t double_frees {};
+    size_t invalid_frees {};
+    size_t mismatched_frees {};       // new[] / delete mismatches
+    size_t overflows {};              // Guard words overwritten
+    size_t writes_after_free {};      // Quarantined blocks written to
+};
+
+DebugAllocatorStats debug_allocator_stats();
+
+//Prints the sampled blocks still live, up to max_blocks of them, and returns
+//how many there are. Runs by itself when the program ends.
+size_t report_leaks(std::FILE* out = stderr, size_t max_blocks = 32);
+
+//Checks the guard words of every live sampled block, and the fill of every
+//quarantined one. Returns true if nothing was overwritten.
+bool check_heap();
+
+//Bytes of freed memory each thread holds back before reuse, headers
+//included. Default 1 MB : bigger catches dangling writes longer after the
+//delete, but the blocks coming out of the quarantine are colder in the
+//cache. 0 turns the quarantine off.
+void set_quarantine_limit(size_t bytes);
+
+//One new in interval, on average, is tracked. 1 tracks them all, 0 none.
+//Takes effect at once for the calling thread, and after their next sampled
+//new for the others.
+void set_sample_interval(size_t interval);
+
+#endif // DEBUG_ALLOCATOR_H
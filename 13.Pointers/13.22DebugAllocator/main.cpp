@@ -0,0 +1,177 @@
+#include <iostream>
+#include <map>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <thread>
+#include <algorithm>
+#include "debug_allocator.h"
+
+//The demos below contain the bugs on purpose
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuse-after-free"
+#endif
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Straight to malloc and free, the way the normal operator new works : the
+//baseline to compare the debug allocator to, in the same program
+template <typename T>
+struct MallocAllocator
+{
+    using value_type = T;
+
+    MallocAllocator() = default;
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>&) {}
+
+    T* allocate(size_t count){
+        if(void* pointer = std::malloc(count * sizeof(T)))
+            return static_cast<T*>(pointer);
+        throw std::bad_alloc();
+    }
+    void deallocate(T* pointer, size_t) { std::free(pointer); }
+
+    template <typename U>
+    bool operator==(const MallocAllocator<U>&) const { return true; }
+};
+
+//count new int / delete, or malloc / free, in batches, split over threads
+template <typename Allocate, typename Release>
+void churn(size_t count, size_t threads, Allocate allocate, Release release){
+    auto work = [&]{
+        const size_t batch {1000};
+        std::vector<int*> pointers(batch);
+        for(size_t done{}; done < count / threads; done += batch){
+            for(size_t i{}; i < batch; ++i)
+                pointers[i] = allocate(static_cast<int>(i));
+            for(size_t i{}; i < batch; ++i)
+                release(pointers[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for(size_t t{1}; t < threads; ++t)
+        workers.emplace_back(work);
+    work();
+    for(auto& worker : workers)
+        worker.join();
+}
+
+//The bugs of 13.16 and 13.19, behind functions the compiler can't see
+//through : it would remove or change them otherwise
+[[gnu::noipa]] int read_through(int* pointer) { return *pointer; }
+[[gnu::noipa]] void write_through(int* pointer, size_t index, int value) { pointer[index] = value; }
+[[gnu::noipa]] void release(int* pointer) { delete pointer; }
+
+
+int main(int argc, char** argv){
+
+    //Debugging : every block tracked, so every bug below is caught
+    set_sample_interval(1);
+
+	//Nested scopes with dynamically allocated memory
+	{
+		int *p_number2 {new int{57}};
+        std::cout << "*p_number2 : " << *p_number2 << std::endl;
+	}
+	//Memory with int{57} leaked : reported when the program ends
+
+    //Deleted pointer : the old value is gone, the read shows the 0xDD fill
+    int * p_number1 {new int{67}};
+    delete p_number1;
+    std::cout << std::hex << std::showbase << "*p_number1 (after delete) : " << read_through(p_number1)
+              << std::dec << std::endl;
+
+    //Writing through it is caught by check_heap(), or when the block leaves
+    //the quarantine
+    write_through(p_number1, 0, 42);
+    std::cout << "check_heap() : " << std::boolalpha << check_heap() << std::endl;
+
+    //Multiple pointers pointing to same address, both deleted
+    int *p_number3 {new int{83}};
+    int *p_number4 {p_number3};
+    delete p_number3;
+    release(p_number4);
+
+    //Writing one past the end
+    int *p_scores {new int[4]{1, 2, 3, 4}};
+    write_through(p_scores, 4, 5);
+    delete [] p_scores;
+
+    //new[] with delete
+    int *p_students {new int[10]{}};
+    release(p_students);
+
+    DebugAllocatorStats stats = debug_allocator_stats();
+    std::cout << "double deletes : " << stats.double_frees << ", writes after delete : " << stats.writes_after_free
+              << ", overflows : " << stats.overflows << ", new[]/delete mismatches : " << stats.mismatched_frees
+              << ", live blocks : " << stats.live_blocks << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : the cost per new / delete, against malloc / free. Default
+    //5M operations, can be changed from the command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 5'000'000;
+    auto debug_new = [](int value) { return new int{value}; };
+    auto debug_delete = [](int* pointer) { delete pointer; };
+    auto plain_malloc = [](int value){
+        int* pointer = static_cast<int*>(std::malloc(sizeof(int)));
+        *pointer = value;
+        return pointer;
+    };
+    auto plain_free = [](int* pointer) { std::free(pointer); };
+
+    //Best of a few runs, taking turns : noise from the machine only ever
+    //makes a run slower, and hits both sides alike
+    auto compare = [&](const char* name, size_t threads){
+        double new_ms {1e300};
+        double malloc_ms {1e300};
+        for(int run{}; run < 5; ++run){
+            new_ms = std::min(new_ms, time_ms([&]{ churn(count, threads, debug_new, debug_delete); }));
+            malloc_ms = std::min(malloc_ms, time_ms([&]{ churn(count, threads, plain_malloc, plain_free); }));
+        }
+        std::cout << count << " new int / delete, " << name << ", " << threads << " thread(s) : debug " << new_ms
+                  << " ms, malloc / free " << malloc_ms << " ms, x" << new_ms / malloc_ms << std::endl;
+    };
+    compare("every block tracked", 1);
+
+    //Production canary : one block in DEFAULT_SAMPLE_INTERVAL tracked
+    set_sample_interval(DEFAULT_SAMPLE_INTERVAL);
+    compare("sampled", 1);
+    compare("sampled", 4);
+
+    //Real code does more than allocate : a map that allocates a node per element
+    const size_t elements = count / 5;
+    auto fill_map = [elements](auto& map){
+        for(size_t i{}; i < elements; ++i)
+            map[static_cast<int>((i * 2654435761u) % elements)] = static_cast<int>(i);
+        return map.size();
+    };
+    size_t sizes {};
+    {
+        std::map<int, int> warm_up; // Gets the heap its memory from the system once, outside the timings
+        sizes += fill_map(warm_up);
+    }
+    double malloc_map_ms = time_ms([&]{
+        std::map<int, int, std::less<int>, MallocAllocator<std::pair<const int, int>>> map;
+        sizes += fill_map(map);
+    });
+    double debug_map_ms = time_ms([&]{
+        std::map<int, int> map;
+        sizes += fill_map(map);
+    });
+    std::cout << "std::map, " << elements << " inserts : debug " << debug_map_ms << " ms, malloc " << malloc_map_ms
+              << " ms, x" << debug_map_ms / malloc_map_ms << " (" << sizes << ")" << std::endl;
+
+    std::cout << "Program ending well" << std::endl;
+    return 0;
+}
@@ -0,0 +1,550 @@
+#ifndef EXPECTED_H
+#define EXPECTED_H
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//An error channel for failures that are expected and frequent. A function
+//returns expected<T, E> : either a T value, or an E error. No stack
+//unwinding, no exception object allocation : failing costs about as much
+//as succeeding.
+//    expected<int, MathError> divide(int a, int b);
+//    auto result = divide(10, 0);
+//    if(result) use(*result); else report(result.error());
+//Chaining :
+//    divide(a, b).and_then(next_step).transform(format).or_else(recover);
+//Exceptions remain the right tool for rare failures, and at API boundaries
+//the adaptors at the bottom of this file convert between the two.
+
+//Wraps an error value, to tell it apart from a T when building an expected
+template <typename E>
+class unexpected
+{
+public:
+    template <typename Err = E>
+        requires std::is_constructible_v<E, Err>
+    constexpr explicit unexpected(Err&& error) : m_error(std::forward<Err>(error)){}
+
+    constexpr const E& error() const & noexcept { return m_error; }
+    constexpr E& error() & noexcept { return m_error; }
+    constexpr E&& error() && noexcept { return std::move(m_error); }
+
+private:
+    E m_error;
+};
+
+template <typename E>
+unexpected(E) -> unexpected<E>;
+
+
+//Thrown by value() when there is no value
+class bad_expected_access_base : public std::exception
+{
+public:
+    virtual const char* what() const noexcept override{
+        return "bad expected access : no value, the expected holds an error";
+    }
+};
+
+template <typename E>
+class bad_expected_access : public bad_expected_access_base
+{
+public:
+    explicit bad_expected_access(E error) : m_error(std::move(error)){}
+    const E& error() const noexcept { return m_error; }
+private:
+    E m_error;
+};
+
+
+template <typename T, typename E>
+class expected
+{
+    static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>,
+                  "expected doesn't hold references");
+
+public:
+    using value_type = T;
+    using error_type = E;
+
+    constexpr expected() requires std::is_default_constructible_v<T>
+        : m_value(), m_has_value(true)
+    {
+    }
+
+    template <typename U = T>
+        requires (!std::is_same_v<std::remove_cvref_t<U>, expected>) &&
+                 (!std::is_same_v<std::remove_cvref_t<U>, unexpected<E>>) &&
+                 std::is_constructible_v<T, U>
+    constexpr expected(U&& value)
+        : m_value(std::forward<U>(value)), m_has_value(true)
+    {
+    }
+
+    template <typename G>
+    constexpr expected(const unexpected<G>& error)
+        : m_error(error.error()), m_has_value(false)
+    {
+    }
+
+    template <typename G>
+    constexpr expected(unexpected<G>&& error)
+        : m_error(std::move(error).error()), m_has_value(false)
+    {
+    }
+
+    expected(const expected& source)
+        : m_has_value(source.m_has_value)
+    {
+        if(m_has_value)
+            std::construct_at(&m_value, source.m_value);
+        else
+            std::construct_at(&m_error, source.m_error);
+    }
+
+    expected(expected&& source) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                         std::is_nothrow_move_constructible_v<E>)
+        : m_has_value(source.m_has_value)
+    {
+        if(m_has_value)
+            std::construct_at(&m_value, std::move(source.m_value));
+        else
+            std::construct_at(&m_error, std::move(source.m_error));
+    }
+
+    //source is already a copy ( or was moved in ). What's left is to move it
+    //into *this without ever leaving *this with nothing in it. Like
+    //std::expected, this needs T or E to be nothrow move constructible. When
+    //the states differ, *this is unchanged if the move throws. When they
+    //match, the member's own move assignment decides.
+    expected& operator=(expected source) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                  std::is_nothrow_move_constructible_v<E> &&
+                                                  std::is_nothrow_move_assignable_v<T> &&
+                                                  std::is_nothrow_move_assignable_v<E>){
+        static_assert(std::is_nothrow_move_constructible_v<T> || std::is_nothrow_move_constructible_v<E>,
+                      "expected assignment needs T or E to be nothrow move constructible");
+        if(m_has_value && source.m_has_value){
+            m_value = std::move(source.m_value);
+        }else if(!m_has_value && !source.m_has_value){
+            m_error = std::move(source.m_error);
+        }else if(m_has_value){
+            reinit(&m_error, &m_value, std::move(source.m_error));
+            m_has_value = false;
+        }else{
+            reinit(&m_value, &m_error, std::move(source.m_value));
+            m_has_value = true;
+        }
+        return *this;
+    }
+
+    ~expected(){
+        destroy();
+    }
+
+    //Checking
+    constexpr bool has_value() const noexcept { return m_has_value; }
+    constexpr explicit operator bool() const noexcept { return m_has_value; }
+
+    //Access without checking : like a raw pointer, only call when has_value()
+    constexpr T& operator*() & noexcept { return m_value; }
+    constexpr const T& operator*() const & noexcept { return m_value; }
+    constexpr T&& operator*() && noexcept { return std::move(m_value); }
+    constexpr T* operator->() noexcept { return &m_value; }
+    constexpr const T* operator->() const noexcept { return &m_value; }
+
+    //Checked access : throws bad_expected_access<E> when there's no value
+    T& value() & {
+        if(!m_has_value)
+            throw bad_expected_access<E>(m_error);
+        return m_value;
+    }
+    const T& value() const & {
+        if(!m_has_value)
+            throw bad_expected_access<E>(m_error);
+        return m_value;
+    }
+    T&& value() && {
+        if(!m_has_value)
+            throw bad_expected_access<E>(std::move(m_error));
+        return std::move(m_value);
+    }
+
+    constexpr E& error() & noexcept { return m_error; }
+    constexpr const E& error() const & noexcept { return m_error; }
+    constexpr E&& error() && noexcept { return std::move(m_error); }
+
+    template <typename U>
+    constexpr T value_or(U&& fallback) const & {
+        return m_has_value ? m_value : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    //Monadic operations
+
+    //function : T -> expected<U, E>. Errors are passed through untouched.
+    template <typename Function>
+    auto and_then(Function&& function) const & {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function, const T&>>;
+        static_assert(std::is_same_v<typename Result::error_type, E>,
+                      "and_then must return an expected with the same error type");
+        if(m_has_value)
+            return std::invoke(std::forward<Function>(function), m_value);
+        return Result(unexpected<E>(m_error));
+    }
+
+    template <typename Function>
+    auto and_then(Function&& function) && {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function, T&&>>;
+        static_assert(std::is_same_v<typename Result::error_type, E>,
+                      "and_then must return an expected with the same error type");
+        if(m_has_value)
+            return std::invoke(std::forward<Function>(function), std::move(m_value));
+        return Result(unexpected<E>(std::move(m_error)));
+    }
+
+    //function : T -> U. Gives expected<U, E>.
+    template <typename Function>
+    auto transform(Function&& function) const & {
+        using U = std::remove_cv_t<std::invoke_result_t<Function, const T&>>;
+        if(m_has_value){
+            if constexpr (std::is_void_v<U>){
+                std::invoke(std::forward<Function>(function), m_value);
+                return expected<void, E>();
+            }else{
+                return expected<U, E>(std::invoke(std::forward<Function>(function), m_value));
+            }
+        }
+        return expected<U, E>(unexpected<E>(m_error));
+    }
+
+    template <typename Function>
+    auto transform(Function&& function) && {
+        using U = std::remove_cv_t<std::invoke_result_t<Function, T&&>>;
+        if(m_has_value){
+            if constexpr (std::is_void_v<U>){
+                std::invoke(std::forward<Function>(function), std::move(m_value));
+                return expected<void, E>();
+            }else{
+                return expected<U, E>(std::invoke(std::forward<Function>(function), std::move(m_value)));
+            }
+        }
+        return expected<U, E>(unexpected<E>(std::move(m_error)));
+    }
+
+    //function : E -> expected<T, G>. Values are passed through untouched.
+    template <typename Function>
+    auto or_else(Function&& function) const & {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function, const E&>>;
+        static_assert(std::is_same_v<typename Result::value_type, T>,
+                      "or_else must return an expected with the same value type");
+        if(m_has_value)
+            return Result(m_value);
+        return std::invoke(std::forward<Function>(function), m_error);
+    }
+
+    template <typename Function>
+    auto or_else(Function&& function) && {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function, E&&>>;
+        static_assert(std::is_same_v<typename Result::value_type, T>,
+                      "or_else must return an expected with the same value type");
+        if(m_has_value)
+            return Result(std::move(m_value));
+        return std::invoke(std::forward<Function>(function), std::move(m_error));
+    }
+
+    //function : E -> G. Gives expected<T, G>.
+    template <typename Function>
+    auto transform_error(Function&& function) const & {
+        using G = std::remove_cv_t<std::invoke_result_t<Function, const E&>>;
+        if(m_has_value)
+            return expected<T, G>(m_value);
+        return expected<T, G>(unexpected<G>(std::invoke(std::forward<Function>(function), m_error)));
+    }
+
+    template <typename Function>
+    auto transform_error(Function&& function) && {
+        using G = std::remove_cv_t<std::invoke_result_t<Function, E&&>>;
+        if(m_has_value)
+            return expected<T, G>(std::move(m_value));
+        return expected<T, G>(unexpected<G>(std::invoke(std::forward<Function>(function), std::move(m_error))));
+    }
+
+private:
+    void destroy() noexcept{
+        if(m_has_value)
+            std::destroy_at(&m_value);
+        else
+            std::destroy_at(&m_error);
+    }
+
+    //Replaces *old_object by a New built from source. If that throws, the old
+    //object is still there.
+    template <typename New, typename Old>
+    static void reinit(New* new_object, Old* old_object, New&& source){
+        if constexpr (std::is_nothrow_move_constructible_v<New>){
+            std::destroy_at(old_object);
+            std::construct_at(new_object, std::move(source));
+        }else{
+            //Then Old can be moved without throwing : park it while trying
+            Old parked(std::move(*old_object));
+            std::destroy_at(old_object);
+            try{
+                std::construct_at(new_object, std::move(source));
+            }catch(...){
+                std::construct_at(old_object, std::move(parked));
+                throw;
+            }
+        }
+    }
+
+private:
+    union
+    {
+        T m_value;
+        E m_error;
+    };
+    bool m_has_value;
+};
+
+
+//For operations that either succeed with nothing to report, or fail
+template <typename E>
+class expected<void, E>
+{
+public:
+    using value_type = void;
+    using error_type = E;
+
+    constexpr expected() noexcept : m_has_value(true){}
+
+    template <typename G>
+    constexpr expected(const unexpected<G>& error) : m_error(error.error()), m_has_value(false){}
+
+    template <typename G>
+    constexpr expected(unexpected<G>&& error) : m_error(std::move(error).error()), m_has_value(false){}
+
+    expected(const expected& source) : m_has_value(source.m_has_value){
+        if(!m_has_value)
+            std::construct_at(&m_error, source.m_error);
+    }
+
+    expected(expected&& source) noexcept(std::is_nothrow_move_constructible_v<E>)
+        : m_has_value(source.m_has_value){
+        if(!m_has_value)
+            std::construct_at(&m_error, std::move(source.m_error));
+    }
+
+    //Never leaves *this without a state : the flag only changes once the
+    //error is built
+    expected& operator=(expected source) noexcept(std::is_nothrow_move_constructible_v<E> &&
+                                                  std::is_nothrow_move_assignable_v<E>){
+        if(!m_has_value && !source.m_has_value){
+            m_error = std::move(source.m_error);
+        }else if(!source.m_has_value){
+            std::construct_at(&m_error, std::move(source.m_error));
+            m_has_value = false;
+        }else if(!m_has_value){
+            std::destroy_at(&m_error);
+            m_has_value = true;
+        }
+        return *this;
+    }
+
+    ~expected(){
+        destroy();
+    }
+
+    constexpr bool has_value() const noexcept { return m_has_value; }
+    constexpr explicit operator bool() const noexcept { return m_has_value; }
+
+    void value() const {
+        if(!m_has_value)
+            throw bad_expected_access<E>(m_error);
+    }
+
+    constexpr E& error() & noexcept { return m_error; }
+    constexpr const E& error() const & noexcept { return m_error; }
+    constexpr E&& error() && noexcept { return std::move(m_error); }
+
+    //Monadic operations, as for expected<T, E> with no value to pass on
+
+    //function : () -> expected<U, E>
+    template <typename Function>
+    auto and_then(Function&& function) const & {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function>>;
+        static_assert(std::is_same_v<typename Result::error_type, E>,
+                      "and_then must return an expected with the same error type");
+        if(m_has_value)
+            return std::invoke(std::forward<Function>(function));
+        return Result(unexpected<E>(m_error));
+    }
+
+    template <typename Function>
+    auto and_then(Function&& function) && {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function>>;
+        static_assert(std::is_same_v<typename Result::error_type, E>,
+                      "and_then must return an expected with the same error type");
+        if(m_has_value)
+            return std::invoke(std::forward<Function>(function));
+        return Result(unexpected<E>(std::move(m_error)));
+    }
+
+    //function : () -> U. Gives expected<U, E>.
+    template <typename Function>
+    auto transform(Function&& function) const & {
+        using U = std::remove_cv_t<std::invoke_result_t<Function>>;
+        if(m_has_value){
+            if constexpr (std::is_void_v<U>){
+                std::invoke(std::forward<Function>(function));
+                return expected<void, E>();
+            }else{
+                return expected<U, E>(std::invoke(std::forward<Function>(function)));
+            }
+        }
+        return expected<U, E>(unexpected<E>(m_error));
+    }
+
+    template <typename Function>
+    auto transform(Function&& function) && {
+        using U = std::remove_cv_t<std::invoke_result_t<Function>>;
+        if(m_has_value){
+            if constexpr (std::is_void_v<U>){
+                std::invoke(std::forward<Function>(function));
+                return expected<void, E>();
+            }else{
+                return expected<U, E>(std::invoke(std::forward<Function>(function)));
+            }
+        }
+        return expected<U, E>(unexpected<E>(std::move(m_error)));
+    }
+
+    //function : E -> expected<void, G>
+    template <typename Function>
+    auto or_else(Function&& function) const & {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function, const E&>>;
+        static_assert(std::is_void_v<typename Result::value_type>,
+                      "or_else must return an expected with the same value type");
+        if(m_has_value)
+            return Result();
+        return std::invoke(std::forward<Function>(function), m_error);
+    }
+
+    template <typename Function>
+    auto or_else(Function&& function) && {
+        using Result = std::remove_cvref_t<std::invoke_result_t<Function, E&&>>;
+        static_assert(std::is_void_v<typename Result::value_type>,
+                      "or_else must return an expected with the same value type");
+        if(m_has_value)
+            return Result();
+        return std::invoke(std::forward<Function>(function), std::move(m_error));
+    }
+
+    //function : E -> G. Gives expected<void, G>.
+    template <typename Function>
+    auto transform_error(Function&& function) const & {
+        using G = std::remove_cv_t<std::invoke_result_t<Function, const E&>>;
+        if(m_has_value)
+            return expected<void, G>();
+        return expected<void, G>(unexpected<G>(std::invoke(std::forward<Function>(function), m_error)));
+    }
+
+    template <typename Function>
+    auto transform_error(Function&& function) && {
+        using G = std::remove_cv_t<std::invoke_result_t<Function, E&&>>;
+        if(m_has_value)
+            return expected<void, G>();
+        return expected<void, G>(unexpected<G>(std::invoke(std::forward<Function>(function), std::move(m_error))));
+    }
+
+private:
+    void destroy() noexcept{
+        if(!m_has_value)
+            std::destroy_at(&m_error);
+    }
+
+private:
+    union
+    {
+        E m_error;
+    };
+    bool m_has_value;
+};
+
+
+//Propagation helper. Evaluates an expression giving an expected. On error,
+//returns the error from the enclosing function, otherwise declares var
+//holding the value :
+//    expected<int, MathError> average(int sum, int count){
+//        TRY(quotient, divide(sum, count));
+//        return quotient;
+//    }
+//The enclosing function must return an expected with the same error type.
+#define TRY(var, expression)                                                   \
+    auto var##_expected_ = (expression);                                       \
+    if(!var##_expected_)                                                       \
+        return unexpected(std::move(var##_expected_).error());                 \
+    auto var = std::move(*var##_expected_)
+
+
+//Adaptors for API boundaries
+
+//Runs function, turning an exception of type Exception into an error.
+//Other exceptions keep propagating. The error is a copy of the exception,
+//so Exception must be the exact type thrown : a final class, or one with no
+//virtual functions. Catching a base class would keep only its base part.
+template <typename Exception, typename Function>
+auto catch_as_expected(Function&& function)
+    -> expected<std::invoke_result_t<Function>, Exception>
+{
+    static_assert(std::is_final_v<Exception> || !std::is_polymorphic_v<Exception>,
+                  "catch_as_expected would slice derived exceptions : make Exception final");
+    try{
+        if constexpr (std::is_void_v<std::invoke_result_t<Function>>){
+            std::invoke(std::forward<Function>(function));
+            return {};
+        }else{
+            return std::invoke(std::forward<Function>(function));
+        }
+    }catch(const Exception& ex){
+        return unexpected<Exception>(ex);
+    }
+}
+
+//The other way around : gives the value, or throws. When the error type is
+//itself an exception it is thrown as is, otherwise make_exception turns it
+//into one.
+template <typename T, typename E>
+T value_or_throw(expected<T, E> result){
+    static_assert(std::is_base_of_v<std::exception, E>,
+                  "Error type isn't an exception : pass a conversion function");
+    if(!result)
+        throw std::move(result).error();
+    return std::move(*result);
+}
+
+template <typename T, typename E, typename MakeException>
+T value_or_throw(expected<T, E> result, MakeException&& make_exception){
+    if(!result)
+        throw std::invoke(std::forward<MakeException>(make_exception), std::move(result).error());
+    return std::move(*result);
+}
+
+//No value to give back : only throws
+template <typename E>
+void value_or_throw(expected<void, E> result){
+    static_assert(std::is_base_of_v<std::exception, E>,
+                  "Error type isn't an exception : pass a conversion function");
+    if(!result)
+        throw std::move(result).error();
+}
+
+template <typename E, typename MakeException>
+void value_or_throw(expected<void, E> result, MakeException&& make_exception){
+    if(!result)
+        throw std::invoke(std::forward<MakeException>(make_exception), std::move(result).error());
+}
+
+#endif // EXPECTED_H
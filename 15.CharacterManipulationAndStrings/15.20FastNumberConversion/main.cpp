@@ -0,0 +1,161 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <charconv>
+#include <cstdlib>
+#include "number_conversion.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::string_view error_name(std::errc error){
+    switch(error){
+        case std::errc::invalid_argument : return "invalid_argument";
+        case std::errc::result_out_of_range : return "result_out_of_range";
+        case std::errc::value_too_large : return "value_too_large";
+        default : return "other error";
+    }
+}
+
+template <typename T>
+void show_parse(std::string_view text){
+    auto result = parse_number<T>(text);
+    std::cout << "    \"" << text << "\" -> ";
+    if(result)
+        std::cout << *result << std::endl;
+    else
+        std::cout << "error : " << error_name(result.error()) << std::endl;
+}
+
+
+int main(int argc, char** argv){
+
+    std::cout << "parse_number<int> : " << std::endl;
+    show_parse<int>("223");
+    show_parse<int>("-2147483648");
+    show_parse<int>("2147483648");    // One too many
+    show_parse<int>("34.567");        // std::stoi would return 34
+    show_parse<int>("hello");         // std::atoi would return 0
+    show_parse<int>("");
+    show_parse<unsigned long>("-34"); // std::stoul would wrap around
+    show_parse<unsigned long long>("18446744073709551615");
+
+    std::cout << "parse_number<double> : " << std::endl;
+    show_parse<double>("1.34847e5");
+    show_parse<double>("34.567");
+    show_parse<double>("1e400");
+
+    //Shortest text that reads back to the same value. std::to_string
+    //always prints 6 decimals : 22.300000 for 22.3f.
+    char buffer[number_buffer_size];
+    std::cout << "format_number : " << std::endl;
+    std::cout << "    22.3f -> " << *format_number(buffer, 22.3f) << std::endl;
+    std::cout << "    0.1 -> " << *format_number(buffer, 0.1) << std::endl;
+    std::cout << "    1.34847e5 -> " << *format_number(buffer, 1.34847e5) << std::endl;
+    std::cout << "    -9223372036854775808 -> " << *format_number(buffer, std::numeric_limits<long long>::min()) << std::endl;
+    char small[3];
+    auto too_long = format_number(small, 12345);
+    std::cout << "    12345 into 3 chars -> error : " << error_name(too_long.error()) << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : a column of numbers as text. Default 1M values, can be
+    //changed from the command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 1'000'000;
+    std::mt19937_64 generator {42};
+    std::uniform_int_distribution<long long> int_values {-2'000'000'000, 2'000'000'000};
+    std::uniform_real_distribution<double> double_values {-1e6, 1e6};
+
+    std::vector<long long> ints(count);
+    std::vector<double> doubles(count);
+    std::vector<std::string> int_texts(count);
+    std::vector<std::string> double_texts(count);
+    for(size_t i{}; i < count; ++i){
+        ints[i] = int_values(generator) / static_cast<long long>(1 + i % 1000); // Mixed lengths
+        doubles[i] = double_values(generator);
+        int_texts[i] = std::to_string(ints[i]);
+        double_texts[i] = *format_number(buffer, doubles[i]);
+    }
+
+    //Check against std::from_chars first
+    size_t mismatches {};
+    for(size_t i{}; i < count; ++i){
+        if(*parse_number<long long>(int_texts[i]) != ints[i])
+            ++mismatches;
+        if(*parse_number<double>(double_texts[i]) != doubles[i])
+            ++mismatches;
+    }
+    std::cout << std::endl;
+    std::cout << "Round trip mismatches : " << mismatches << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Parsing " << count << " integers : " << std::endl;
+    long long total {};
+    std::cout << "std::stoll        : " << time_ms([&]{
+        for(const std::string& text : int_texts) total += std::stoll(text);
+    }) << " ms" << std::endl;
+    std::cout << "std::atoll        : " << time_ms([&]{
+        for(const std::string& text : int_texts) total += std::atoll(text.c_str());
+    }) << " ms" << std::endl;
+    std::cout << "std::from_chars   : " << time_ms([&]{
+        for(const std::string& text : int_texts){
+            long long value {};
+            std::from_chars(text.data(), text.data() + text.size(), value);
+            total += value;
+        }
+    }) << " ms" << std::endl;
+    std::cout << "parse_number      : " << time_ms([&]{
+        for(const std::string& text : int_texts) total += *parse_number<long long>(text);
+    }) << " ms" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Parsing " << count << " doubles : " << std::endl;
+    double double_total {};
+    std::cout << "std::stod         : " << time_ms([&]{
+        for(const std::string& text : double_texts) double_total += std::stod(text);
+    }) << " ms" << std::endl;
+    std::cout << "std::atof         : " << time_ms([&]{
+        for(const std::string& text : double_texts) double_total += std::atof(text.c_str());
+    }) << " ms" << std::endl;
+    std::cout << "parse_number      : " << time_ms([&]{
+        for(const std::string& text : double_texts) double_total += *parse_number<double>(text);
+    }) << " ms" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Formatting " << count << " integers : " << std::endl;
+    size_t characters {};
+    std::cout << "std::to_string    : " << time_ms([&]{
+        for(long long value : ints) characters += std::to_string(value).size();
+    }) << " ms" << std::endl;
+    std::cout << "std::to_chars     : " << time_ms([&]{
+        for(long long value : ints)
+            characters += static_cast<size_t>(std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer);
+    }) << " ms" << std::endl;
+    std::cout << "format_number     : " << time_ms([&]{
+        for(long long value : ints) characters += format_number(buffer, value)->size();
+    }) << " ms" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Formatting " << count << " doubles : " << std::endl;
+    std::cout << "std::to_string    : " << time_ms([&]{
+        for(double value : doubles) characters += std::to_string(value).size();
+    }) << " ms" << std::endl;
+    std::cout << "format_number     : " << time_ms([&]{
+        for(double value : doubles) characters += format_number(buffer, value)->size();
+    }) << " ms" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "( checksums : " << total << " " << double_total << " " << characters << " )" << std::endl;
+
+    return 0;
+}
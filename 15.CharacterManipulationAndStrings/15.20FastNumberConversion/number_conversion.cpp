@@ -0,0 +1,103 @@
+#include <bit>
+#include <cstring>
+#include "number_conversion.h"
+
+static_assert(std::endian::native == std::endian::little,
+              "The SWAR digit parsing reads the text as a little endian integer");
+
+//True if the 8 bytes are all '0' ... '9'. Each byte of a digit is 0x30 to
+//0x39 : its high nibble is 3, and adding 6 doesn't carry into the high nibble.
+static bool all_digits(std::uint64_t chunk){
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+            (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+           == 0x3333333333333333;
+}
+
+//Eight digits to their value in three multiplications instead of eight.
+//The first character read is the lowest byte, and the most significant digit.
+static std::uint32_t eight_digits(std::uint64_t chunk){
+    chunk -= 0x3030303030303030;                       // Characters to digit values
+    chunk = (chunk * 10) + (chunk >> 8);               // Pairs of digits, in every other byte
+    chunk = (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+    return static_cast<std::uint32_t>(chunk);
+}
+
+std::errc parse_digits(const char* first, const char* last, std::uint64_t& value){
+    if(first == last)
+        return std::errc::invalid_argument;
+
+    std::uint64_t result {};
+    const char* current = first;
+
+    //At most 20 digits fit in 64 bits, but leading zeros are allowed : check
+    //for overflow as we go rather than counting digits.
+    while(last - current >= 8){
+        std::uint64_t chunk;
+        std::memcpy(&chunk, current, 8);
+        if(!all_digits(chunk))
+            break;
+        if(__builtin_mul_overflow(result, 100'000'000ULL, &result) ||
+           __builtin_add_overflow(result, eight_digits(chunk), &result))
+            return std::errc::result_out_of_range;
+        current += 8;
+    }
+
+    for(; current != last; ++current){
+        unsigned digit = static_cast<unsigned char>(*current) - '0';
+        if(digit > 9)
+            return std::errc::invalid_argument;
+        if(__builtin_mul_overflow(result, 10ULL, &result) ||
+           __builtin_add_overflow(result, digit, &result))
+            return std::errc::result_out_of_range;
+    }
+
+    value = result;
+    return std::errc{};
+}
+
+
+//"00" "01" ... "99" : two digits per division by 100
+static constexpr char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+//Number of decimal digits of value
+static size_t digit_count(std::uint64_t value){
+    size_t count {1};
+    for(;;){
+        if(value < 10) return count;
+        if(value < 100) return count + 1;
+        if(value < 1000) return count + 2;
+        if(value < 10000) return count + 3;
+        value /= 10000;
+        count += 4;
+    }
+}
+
+size_t format_digits(char* out, std::uint64_t value){
+    const size_t length = digit_count(value);
+    char* position = out + length;
+    while(value >= 100){
+        const size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--position = digit_pairs[pair + 1];
+        *--position = digit_pairs[pair];
+    }
+    if(value >= 10){
+        const size_t pair = static_cast<size_t>(value) * 2;
+        *--position = digit_pairs[pair + 1];
+        *--position = digit_pairs[pair];
+    }else{
+        *--position = static_cast<char>('0' + value);
+    }
+    return length;
+}
@@ -0,0 +1,111 @@
+#ifndef NUMBER_CONVERSION_H
+#define NUMBER_CONVERSION_H
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include "expected.h"
+
+//Number <-> text conversions for hot paths, instead of std::stoi / std::stod /
+//atof / std::to_string :
+//  - no allocation, no locale : "1.5" means 1.5 whatever the global locale.
+//  - failures come back as an std::errc in an expected, never as an
+//    exception or as a silent 0 :
+//        std::errc::invalid_argument     not a number, or trailing characters
+//        std::errc::result_out_of_range  doesn't fit in T
+//        std::errc::value_too_large      ( format ) buffer too small
+//  - the whole text must be the number : no leading spaces, no '+', no
+//    trailing characters.
+//Integers are parsed eight digits at a time with SWAR ( SIMD within a
+//register ) arithmetic, and formatted two digits at a time.
+//Floating point goes through std::from_chars / std::to_chars : exact parsing,
+//shortest text that reads back to the same value.
+
+//Big enough for any integer or floating point value formatted here
+inline constexpr size_t number_buffer_size {32};
+
+//Parses decimal digits only, into a 64 bit value. Defined in the .cpp file.
+std::errc parse_digits(const char* first, const char* last, std::uint64_t& value);
+
+//Writes the digits of value at out, returns how many. Defined in the .cpp file.
+size_t format_digits(char* out, std::uint64_t value);
+
+
+template <typename T>
+concept Arithmetic = (std::integral<T> || std::floating_point<T>) && !std::same_as<T, bool>;
+
+template <Arithmetic T>
+expected<T, std::errc> parse_number(std::string_view text){
+    if constexpr (std::floating_point<T>){
+        T value {};
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if(error != std::errc{})
+            return unexpected(error);
+        if(end != text.data() + text.size())
+            return unexpected(std::errc::invalid_argument);
+        return value;
+    }else{
+        bool negative = !text.empty() && text.front() == '-';
+        if(negative){
+            if constexpr (std::is_unsigned_v<T>)
+                return unexpected(std::errc::invalid_argument);
+            text.remove_prefix(1);
+        }
+        std::uint64_t magnitude {};
+        std::errc error = parse_digits(text.data(), text.data() + text.size(), magnitude);
+        if(error != std::errc{})
+            return unexpected(error);
+
+        using Unsigned = std::make_unsigned_t<T>;
+        constexpr std::uint64_t max = std::numeric_limits<T>::max();
+        if(negative){
+            if(magnitude > max + 1) // The minimum of a signed type is -(max + 1)
+                return unexpected(std::errc::result_out_of_range);
+            return static_cast<T>(Unsigned(0) - static_cast<Unsigned>(magnitude));
+        }
+        if(magnitude > max)
+            return unexpected(std::errc::result_out_of_range);
+        return static_cast<T>(magnitude);
+    }
+}
+
+//Writes value into buffer. The result views the written characters, inside
+//buffer : no terminating '\0'.
+template <Arithmetic T>
+expected<std::string_view, std::errc> format_number(std::span<char> buffer, T value){
+    if constexpr (std::floating_point<T>){
+        auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        if(error != std::errc{})
+            return unexpected(error);
+        return std::string_view(buffer.data(), static_cast<size_t>(end - buffer.data()));
+    }else{
+        //Straight into buffer when it is sure to be big enough
+        char digits[number_buffer_size];
+        const bool direct = buffer.size() >= number_buffer_size;
+        char* out = direct ? buffer.data() : digits;
+        char* start = out;
+        std::uint64_t magnitude = static_cast<std::uint64_t>(value);
+        if constexpr (std::is_signed_v<T>){
+            if(value < 0){
+                *out++ = '-';
+                magnitude = std::uint64_t(0) - magnitude; // Also right for the minimum
+            }
+        }
+        size_t length = static_cast<size_t>(out - start) + format_digits(out, magnitude);
+        if(!direct){
+            if(length > buffer.size())
+                return unexpected(std::errc::value_too_large);
+            std::copy(digits, digits + length, buffer.data());
+        }
+        return std::string_view(buffer.data(), length);
+    }
+}
+
+#endif // NUMBER_CONVERSION_H
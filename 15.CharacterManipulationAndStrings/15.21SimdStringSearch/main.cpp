@@ -0,0 +1,115 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <random>
+#include <chrono>
+#include "string_search.h"
+
+//Time a piece of code, in nanoseconds per call
+template <typename Function>
+double ns_per_call(size_t calls, Function function){
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i{}; i < calls; ++i)
+        function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+}
+
+volatile size_t sink {}; // Keeps results alive
+
+const SimdLevel levels[] {SimdLevel::scalar, SimdLevel::ssse3, SimdLevel::avx2};
+
+//Every level must agree with std::string_view on random text
+size_t check_against_std(){
+    std::mt19937 generator {7};
+    std::uniform_int_distribution<int> letter {'a', 'h'};
+    std::uniform_int_distribution<size_t> length {0, 200};
+    const ByteSet set {"fg"};
+    size_t mismatches {};
+    for(int round{}; round < 20'000; ++round){
+        std::string haystack(length(generator), ' ');
+        for(char& c : haystack)
+            c = static_cast<char>(letter(generator));
+        std::string needle(length(generator) % 5, ' ');
+        for(char& c : needle)
+            c = static_cast<char>(letter(generator));
+        std::string_view view {haystack};
+        for(SimdLevel level : levels){
+            if(level > detected_simd_level())
+                continue;
+            mismatches += find_byte(view, 'h', level) != view.find('h');
+            mismatches += rfind_byte(view, 'h', level) != view.rfind('h');
+            mismatches += find_first_of(view, set, level) != view.find_first_of("fg");
+            mismatches += find_substring(view, needle, level) != view.find(needle);
+        }
+    }
+    return mismatches;
+}
+
+
+int main(){
+
+    std::string string1{"Water was poured in the heater"};
+    std::cout << "string1 : " << string1 << std::endl;
+    std::cout << "find_substring(\"ter\") : " << find_substring(string1, "ter") << std::endl; // 2
+    std::cout << "find_substring(\"red\") : " << find_substring(string1, "red") << std::endl; // 13
+    std::cout << "find_substring(\"chicken\") == npos : " << std::boolalpha
+              << (find_substring(string1, "chicken") == npos) << std::endl;
+    std::cout << "find_byte('p') : " << find_byte(string1, 'p') << std::endl;   // 10
+    std::cout << "rfind_byte('a') : " << rfind_byte(string1, 'a') << std::endl; // 26
+    std::cout << "find_first_of(\"eiou\") : " << find_first_of(string1, "eiou") << std::endl; // 3
+
+    //Character classes : any predicate, turned into a set once
+    constexpr ByteSet digits = ByteSet::matching([](unsigned char c){ return c >= '0' && c <= '9'; });
+    const char* c_string {"Order number : 2024-117"}; // Works on C strings too
+    std::cout << "First digit in \"" << c_string << "\" : " << find_first_of(c_string, digits) << std::endl;
+
+    std::cout << "Detected SIMD level : " << to_string(detected_simd_level()) << std::endl;
+    std::cout << "Mismatches against std::string_view : " << check_against_std() << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : log like text, the target sits at the very end, so every
+    //search scans the whole haystack.
+    const ByteSet delimiters {"=[]{}\"\t|"};
+    for(size_t size : {64, 1024, 64 * 1024, 1024 * 1024}){
+        std::string haystack(size, ' ');
+        std::mt19937 generator {42};
+        std::uniform_int_distribution<int> letter {'a', 'z'};
+        for(char& c : haystack)
+            c = static_cast<char>(letter(generator));
+        haystack.replace(size - 8, 8, "=needle|");
+        std::string_view view {haystack};
+        const size_t calls = 100'000'000 / size + 10;
+
+        std::cout << std::endl;
+        std::cout << "Haystack of " << size << " bytes ( ns per search ) : " << std::endl;
+        std::cout << "  find '|'              std::string_view::find : "
+                  << ns_per_call(calls, [&]{ sink = view.find('|'); })
+                  << ", memchr : "
+                  << ns_per_call(calls, [&]{ sink = static_cast<size_t>(static_cast<const char*>(std::memchr(view.data(), '|', view.size())) - view.data()); });
+        for(SimdLevel level : levels)
+            std::cout << ", " << to_string(level) << " : " << ns_per_call(calls, [&]{ sink = find_byte(view, '|', level); });
+        std::cout << std::endl;
+
+        std::cout << "  find_first_of 8 chars std::string_view : "
+                  << ns_per_call(calls, [&]{ sink = view.find_first_of("=[]{}\"\t|"); })
+                  << ", strpbrk : "
+                  << ns_per_call(calls, [&]{ sink = static_cast<size_t>(std::strpbrk(haystack.c_str(), "=[]{}\"\t|") - haystack.c_str()); });
+        for(SimdLevel level : levels)
+            std::cout << ", " << to_string(level) << " : " << ns_per_call(calls, [&]{ sink = find_first_of(view, delimiters, level); });
+        std::cout << std::endl;
+
+        std::cout << "  find \"needle\"         std::string_view : "
+                  << ns_per_call(calls, [&]{ sink = view.find("needle"); })
+                  << ", strstr : "
+                  << ns_per_call(calls, [&]{ sink = static_cast<size_t>(std::strstr(haystack.c_str(), "needle") - haystack.c_str()); });
+        for(SimdLevel level : levels)
+            std::cout << ", " << to_string(level) << " : " << ns_per_call(calls, [&]{ sink = find_substring(view, "needle", level); });
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,357 @@
+#include <cstring>
+#include "string_search.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define STRING_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace{
+
+//Scalar kernels, also used for the tails the vector loops leave behind.
+size_t find_byte_scalar(const unsigned char* data, size_t size, size_t start, unsigned char c){
+    for(size_t i{start}; i < size; ++i){
+        if(data[i] == c)
+            return i;
+    }
+    return npos;
+}
+
+//Looks at positions [0, end), from the back
+size_t rfind_byte_scalar(const unsigned char* data, size_t end, unsigned char c){
+    while(end > 0){
+        --end;
+        if(data[end] == c)
+            return end;
+    }
+    return npos;
+}
+
+size_t find_first_of_scalar(const unsigned char* data, size_t size, size_t start, const ByteSet& set){
+    for(size_t i{start}; i < size; ++i){
+        if(set.contains(data[i]))
+            return i;
+    }
+    return npos;
+}
+
+size_t find_substring_scalar(const unsigned char* data, size_t size, size_t start,
+                             const unsigned char* needle, size_t needle_size){
+    for(size_t i{start}; i + needle_size <= size; ++i){
+        if(data[i] == needle[0] && std::memcmp(data + i + 1, needle + 1, needle_size - 1) == 0)
+            return i;
+    }
+    return npos;
+}
+
+#ifdef STRING_SEARCH_X86
+
+//Each kernel turns a vector comparison into a bit mask, one bit per byte
+//( movemask ), then the lowest set bit is the first match.
+
+__attribute__((target("ssse3")))
+size_t find_byte_ssse3(const unsigned char* data, size_t size, unsigned char c){
+    const __m128i target = _mm_set1_epi8(static_cast<char>(c));
+    size_t i{};
+    for(; i + 16 <= size; i += 16){
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)));
+        if(mask)
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return find_byte_scalar(data, size, i, c);
+}
+
+__attribute__((target("avx2")))
+size_t find_byte_avx2(const unsigned char* data, size_t size, unsigned char c){
+    const __m256i target = _mm256_set1_epi8(static_cast<char>(c));
+    size_t i{};
+    //Four vectors per iteration, one branch : the common case is no match
+    for(; i + 128 <= size; i += 128){
+        const __m256i* block = reinterpret_cast<const __m256i*>(data + i);
+        __m256i any = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(block), target),
+                            _mm256_cmpeq_epi8(_mm256_loadu_si256(block + 1), target)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(block + 2), target),
+                            _mm256_cmpeq_epi8(_mm256_loadu_si256(block + 3), target)));
+        if(!_mm256_testz_si256(any, any))
+            break; // The loop below finds which byte
+    }
+    for(; i + 32 <= size; i += 32){
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target)));
+        if(mask)
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return find_byte_scalar(data, size, i, c);
+}
+
+//From the back : the highest set bit is the last match
+__attribute__((target("ssse3")))
+size_t rfind_byte_ssse3(const unsigned char* data, size_t size, unsigned char c){
+    const __m128i target = _mm_set1_epi8(static_cast<char>(c));
+    size_t end {size};
+    for(; end >= 16; end -= 16){
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + end - 16));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)));
+        if(mask)
+            return end - 16 + static_cast<size_t>(31 - __builtin_clz(mask));
+    }
+    return rfind_byte_scalar(data, end, c);
+}
+
+__attribute__((target("avx2")))
+size_t rfind_byte_avx2(const unsigned char* data, size_t size, unsigned char c){
+    const __m256i target = _mm256_set1_epi8(static_cast<char>(c));
+    size_t end {size};
+    for(; end >= 32; end -= 32){
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + end - 32));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target)));
+        if(mask)
+            return end - 32 + static_cast<size_t>(31 - __builtin_clz(mask));
+    }
+    return rfind_byte_scalar(data, end, c);
+}
+
+//Set membership for 16 bytes at once :
+//  - pshufb looks up table[c & 15] for every byte, and gives 0 for bytes
+//    with the top bit set. Flipping the top bit before the second lookup
+//    sends bytes 0x80 - 0xFF to high_table, and the others to 0.
+//  - the bit to test in the looked up byte is 1 << ( ( c >> 4 ) & 7 ), also
+//    found with pshufb, in a table of powers of two.
+__attribute__((target("ssse3")))
+__m128i in_set_ssse3(__m128i chunk, __m128i low_table, __m128i high_table, __m128i powers){
+    const __m128i top_bit = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i low_nibbles = _mm_set1_epi8(0x0f);
+    __m128i rows = _mm_or_si128(_mm_shuffle_epi8(low_table, chunk),
+                                _mm_shuffle_epi8(high_table, _mm_xor_si128(chunk, top_bit)));
+    __m128i high_nibble = _mm_and_si128(_mm_srli_epi16(chunk, 4), low_nibbles);
+    __m128i bit = _mm_shuffle_epi8(powers, high_nibble);
+    return _mm_cmpeq_epi8(_mm_and_si128(rows, bit), bit);
+}
+
+__attribute__((target("avx2")))
+__m256i in_set_avx2(__m256i chunk, __m256i low_table, __m256i high_table, __m256i powers){
+    const __m256i top_bit = _mm256_set1_epi8(static_cast<char>(0x80));
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+    __m256i rows = _mm256_or_si256(_mm256_shuffle_epi8(low_table, chunk),
+                                   _mm256_shuffle_epi8(high_table, _mm256_xor_si256(chunk, top_bit)));
+    __m256i high_nibble = _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_nibbles);
+    __m256i bit = _mm256_shuffle_epi8(powers, high_nibble);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), bit);
+}
+
+//1 << ( i & 7 ) for i in 0 ... 15
+alignas(16) const unsigned char powers_of_two[16] {1, 2, 4, 8, 16, 32, 64, 128,
+                                                   1, 2, 4, 8, 16, 32, 64, 128};
+
+__attribute__((target("ssse3")))
+size_t find_first_of_ssse3(const unsigned char* data, size_t size, const ByteSet& set){
+    const __m128i low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low_table().data()));
+    const __m128i high_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.high_table().data()));
+    const __m128i powers = _mm_load_si128(reinterpret_cast<const __m128i*>(powers_of_two));
+    size_t i{};
+    for(; i + 16 <= size; i += 16){
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(in_set_ssse3(chunk, low_table, high_table, powers)));
+        if(mask)
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return find_first_of_scalar(data, size, i, set);
+}
+
+__attribute__((target("avx2")))
+size_t find_first_of_avx2(const unsigned char* data, size_t size, const ByteSet& set){
+    //pshufb works within each 128 bit half : the tables go in both halves
+    const __m256i low_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low_table().data())));
+    const __m256i high_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.high_table().data())));
+    const __m256i powers = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(powers_of_two)));
+    size_t i{};
+    for(; i + 64 <= size; i += 64){
+        const __m256i* block = reinterpret_cast<const __m256i*>(data + i);
+        __m256i any = _mm256_or_si256(in_set_avx2(_mm256_loadu_si256(block), low_table, high_table, powers),
+                                      in_set_avx2(_mm256_loadu_si256(block + 1), low_table, high_table, powers));
+        if(!_mm256_testz_si256(any, any))
+            break; // The loop below finds which byte
+    }
+    for(; i + 32 <= size; i += 32){
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(in_set_avx2(chunk, low_table, high_table, powers)));
+        if(mask)
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return find_first_of_scalar(data, size, i, set);
+}
+
+//Candidates are positions where the first byte of needle matches, and the
+//byte needle_size - 1 further matches its last byte. The middle byte is
+//tested too : on ordinary text that removes most of the false candidates,
+//each of which costs a mispredicted branch. Only real candidates get the
+//full comparison. needle_size is at least 2.
+//The last block is moved back to end exactly at the last position : it
+//overlaps positions already checked, which is harmless, and saves a scalar tail.
+__attribute__((target("ssse3")))
+size_t find_substring_ssse3(const unsigned char* data, size_t size,
+                            const unsigned char* needle, size_t needle_size){
+    const size_t positions = size - needle_size + 1;
+    if(positions < 16)
+        return find_substring_scalar(data, size, 0, needle, needle_size);
+    const size_t middle_offset = needle_size / 2;
+    const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+    const __m128i middle = _mm_set1_epi8(static_cast<char>(needle[middle_offset]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+    size_t i{};
+    for(;;){
+        if(i + 16 > positions){
+            if(i == positions)
+                return npos;
+            i = positions - 16; // Last block, moved back to end at the last position
+        }
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i block_middle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + middle_offset));
+        __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needle_size - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_middle, middle)),
+                   _mm_cmpeq_epi8(block_last, last))));
+        while(mask){
+            size_t candidate = i + static_cast<size_t>(__builtin_ctz(mask));
+            if(std::memcmp(data + candidate + 1, needle + 1, needle_size - 2) == 0)
+                return candidate;
+            mask &= mask - 1; // Next candidate
+        }
+        i += 16;
+    }
+}
+
+__attribute__((target("avx2")))
+size_t find_substring_avx2(const unsigned char* data, size_t size,
+                            const unsigned char* needle, size_t needle_size){
+    const size_t positions = size - needle_size + 1;
+    if(positions < 32)
+        return find_substring_scalar(data, size, 0, needle, needle_size);
+    const size_t middle_offset = needle_size / 2;
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(needle[0]));
+    const __m256i middle = _mm256_set1_epi8(static_cast<char>(needle[middle_offset]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+    size_t i{};
+    for(;;){
+        if(i + 32 > positions){
+            if(i == positions)
+                return npos;
+            i = positions - 32; // Last block, moved back to end at the last position
+        }
+        __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i block_middle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + middle_offset));
+        __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + needle_size - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_middle, middle)),
+                   _mm256_cmpeq_epi8(block_last, last))));
+        while(mask){
+            size_t candidate = i + static_cast<size_t>(__builtin_ctz(mask));
+            if(std::memcmp(data + candidate + 1, needle + 1, needle_size - 2) == 0)
+                return candidate;
+            mask &= mask - 1; // Next candidate
+        }
+        i += 32;
+    }
+}
+
+#endif // STRING_SEARCH_X86
+
+const unsigned char* bytes_of(std::string_view text){
+    return reinterpret_cast<const unsigned char*>(text.data());
+}
+
+} // namespace
+
+
+SimdLevel detected_simd_level(){
+#ifdef STRING_SEARCH_X86
+    static const SimdLevel level = []{
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+            return SimdLevel::avx2;
+        if(__builtin_cpu_supports("ssse3"))
+            return SimdLevel::ssse3;
+        return SimdLevel::scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+const char* to_string(SimdLevel level){
+    switch(level){
+        case SimdLevel::scalar : return "scalar";
+        case SimdLevel::ssse3 : return "SSSE3";
+        case SimdLevel::avx2 : return "AVX2";
+    }
+    return "unknown";
+}
+
+size_t find_byte(std::string_view haystack, char c, SimdLevel level){
+    auto data = bytes_of(haystack);
+    auto target = static_cast<unsigned char>(c);
+#ifdef STRING_SEARCH_X86
+    switch(level){
+        case SimdLevel::avx2 : return find_byte_avx2(data, haystack.size(), target);
+        case SimdLevel::ssse3 : return find_byte_ssse3(data, haystack.size(), target);
+        case SimdLevel::scalar : break;
+    }
+#else
+    (void)level;
+#endif
+    return find_byte_scalar(data, haystack.size(), 0, target);
+}
+
+size_t rfind_byte(std::string_view haystack, char c, SimdLevel level){
+    auto data = bytes_of(haystack);
+    auto target = static_cast<unsigned char>(c);
+#ifdef STRING_SEARCH_X86
+    switch(level){
+        case SimdLevel::avx2 : return rfind_byte_avx2(data, haystack.size(), target);
+        case SimdLevel::ssse3 : return rfind_byte_ssse3(data, haystack.size(), target);
+        case SimdLevel::scalar : break;
+    }
+#else
+    (void)level;
+#endif
+    return rfind_byte_scalar(data, haystack.size(), target);
+}
+
+size_t find_first_of(std::string_view haystack, const ByteSet& set, SimdLevel level){
+    auto data = bytes_of(haystack);
+#ifdef STRING_SEARCH_X86
+    switch(level){
+        case SimdLevel::avx2 : return find_first_of_avx2(data, haystack.size(), set);
+        case SimdLevel::ssse3 : return find_first_of_ssse3(data, haystack.size(), set);
+        case SimdLevel::scalar : break;
+    }
+#else
+    (void)level;
+#endif
+    return find_first_of_scalar(data, haystack.size(), 0, set);
+}
+
+size_t find_substring(std::string_view haystack, std::string_view needle, SimdLevel level){
+    if(needle.empty())
+        return 0;
+    if(needle.size() > haystack.size())
+        return npos;
+    if(needle.size() == 1)
+        return find_byte(haystack, needle[0], level);
+    auto data = bytes_of(haystack);
+    auto pattern = bytes_of(needle);
+#ifdef STRING_SEARCH_X86
+    switch(level){
+        case SimdLevel::avx2 : return find_substring_avx2(data, haystack.size(), pattern, needle.size());
+        case SimdLevel::ssse3 : return find_substring_ssse3(data, haystack.size(), pattern, needle.size());
+        case SimdLevel::scalar : break;
+    }
+#endif
+    return find_substring_scalar(data, haystack.size(), 0, pattern, needle.size());
+}
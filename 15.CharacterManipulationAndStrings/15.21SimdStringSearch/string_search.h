@@ -0,0 +1,96 @@
+#ifndef STRING_SEARCH_H
+#define STRING_SEARCH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//Vectorized versions of std::string::find, rfind and find_first_of, working
+//on std::string_view ( so on std::string and C strings as well ). They
+//return an index, or npos, like the std::string member functions.
+//  - find_byte / rfind_byte compare 16 or 32 bytes at a time.
+//  - find_first_of tests 16 or 32 bytes at a time against any set of bytes,
+//    with two 16 entry nibble tables and byte shuffles : the cost doesn't
+//    depend on how many characters are in the set.
+//  - find_substring looks for the first and the last byte of the needle at
+//    the same time, and only compares the whole needle where both match.
+
+inline constexpr size_t npos = std::string_view::npos;
+
+//Which instruction set the kernels use. Picked once at run time from what
+//the CPU supports, but can be forced for testing and benchmarking.
+//SSSE3 is SSE2 plus the pshufb byte shuffle, present on every x86-64 CPU
+//of the last fifteen years.
+enum class SimdLevel { scalar, ssse3, avx2 };
+
+SimdLevel detected_simd_level();
+const char* to_string(SimdLevel level);
+
+
+//A set of bytes, built once and reused for many searches. Kept both as a
+//256 bit bitmap, for scalar code, and as nibble tables for the SIMD kernels :
+//byte c is in the set if bit ( c >> 4 ) of table[c & 15] is set.
+//low_table covers bytes 0x00 - 0x7F, high_table bytes 0x80 - 0xFF.
+class ByteSet
+{
+public:
+    constexpr ByteSet() = default;
+    constexpr explicit ByteSet(std::string_view chars){
+        for(char c : chars)
+            add(static_cast<unsigned char>(c));
+    }
+
+    //All the bytes predicate accepts, as in
+    //    ByteSet::matching([](unsigned char c){ return c >= '0' && c <= '9'; });
+    template <typename Predicate>
+    static constexpr ByteSet matching(Predicate predicate){
+        ByteSet set;
+        for(unsigned c{}; c < 256; ++c)
+            if(predicate(static_cast<unsigned char>(c)))
+                set.add(static_cast<unsigned char>(c));
+        return set;
+    }
+
+    constexpr void add(unsigned char c){
+        m_bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+        if(c < 0x80)
+            m_low_table[c & 15] |= static_cast<std::uint8_t>(1u << (c >> 4));
+        else
+            m_high_table[c & 15] |= static_cast<std::uint8_t>(1u << ((c >> 4) - 8));
+    }
+
+    constexpr bool contains(unsigned char c) const{
+        return (m_bits[c >> 6] >> (c & 63)) & 1;
+    }
+
+    const std::array<std::uint8_t, 16>& low_table() const { return m_low_table; }
+    const std::array<std::uint8_t, 16>& high_table() const { return m_high_table; }
+
+private:
+    std::array<std::uint64_t, 4> m_bits {};
+    std::array<std::uint8_t, 16> m_low_table {};
+    std::array<std::uint8_t, 16> m_high_table {};
+};
+
+
+//First / last position of c in haystack, or npos
+size_t find_byte(std::string_view haystack, char c, SimdLevel level = detected_simd_level());
+size_t rfind_byte(std::string_view haystack, char c, SimdLevel level = detected_simd_level());
+
+//First position of any byte of set in haystack, or npos
+size_t find_first_of(std::string_view haystack, const ByteSet& set,
+                        SimdLevel level = detected_simd_level());
+
+//Convenience : builds the set on every call. Build a ByteSet once when
+//searching for the same characters many times.
+inline size_t find_first_of(std::string_view haystack, std::string_view chars,
+                               SimdLevel level = detected_simd_level()){
+    return find_first_of(haystack, ByteSet(chars), level);
+}
+
+//First position of needle in haystack, or npos. An empty needle is found at 0.
+size_t find_substring(std::string_view haystack, std::string_view needle,
+                         SimdLevel level = detected_simd_level());
+
+#endif // STRING_SEARCH_H
@@ -0,0 +1,48 @@
+#include "arena.h"
+
+Arena::Arena(size_t block_size)
+    : m_block_size(block_size)
+{
+}
+
+Arena::~Arena(){
+    for(char* block : m_blocks)
+        delete[] block;
+    for(char* block : m_large_blocks)
+        delete[] block;
+}
+
+char* Arena::allocate_slow(size_t size){
+    //Big requests get a block of their own, so the current block isn't
+    //abandoned half used.
+    if(size > m_block_size / 4){
+        char* block = new char[size];
+        m_large_blocks.push_back(block);
+        m_reserved += size;
+        m_used += size;
+        return block;
+    }
+    char* block = new char[m_block_size];
+    m_blocks.push_back(block);
+    m_reserved += m_block_size;
+    m_current = block;
+    m_end = block + m_block_size;
+    return allocate(size);
+}
+
+void Arena::reset(){
+    for(char* block : m_large_blocks)
+        delete[] block;
+    m_large_blocks.clear();
+    m_used = 0;
+    if(m_blocks.empty()){
+        m_reserved = 0;
+        return;
+    }
+    for(size_t i{1}; i < m_blocks.size(); ++i)
+        delete[] m_blocks[i];
+    m_blocks.resize(1);
+    m_current = m_blocks[0];
+    m_end = m_blocks[0] + m_block_size;
+    m_reserved = m_block_size;
+}
@@ -0,0 +1,61 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+//Memory for strings that live and die together ( one request, one file
+//being parsed, one batch of records ). Allocating is moving a pointer
+//forward in a big block; nothing is freed one by one : everything goes
+//away at once, when the arena dies or on reset().
+//Characters only need no alignment, so there is no padding between
+//allocations. An Arena is not thread safe : use one per thread.
+class Arena
+{
+public:
+    explicit Arena(size_t block_size = 64 * 1024);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    char* allocate(size_t size){
+        if(size > static_cast<size_t>(m_end - m_current))
+            return allocate_slow(size);
+        char* result = m_current;
+        m_current += size;
+        m_used += size;
+        return result;
+    }
+
+    //Grows the most recent allocation without moving it, if there is room
+    //behind it. Returns false, and changes nothing, otherwise.
+    bool try_extend(char* allocation, size_t old_size, size_t new_size){
+        if(allocation + old_size != m_current ||
+           new_size - old_size > static_cast<size_t>(m_end - m_current))
+            return false;
+        m_current += new_size - old_size;
+        m_used += new_size - old_size;
+        return true;
+    }
+
+    //Every string allocated from the arena becomes invalid. The first block
+    //is kept for reuse.
+    void reset();
+
+    size_t bytes_used() const { return m_used; }           // Handed out
+    size_t bytes_reserved() const { return m_reserved; }   // Taken from the heap
+
+private:
+    char* allocate_slow(size_t size);
+
+private:
+    size_t m_block_size;
+    std::vector<char*> m_blocks;       // Regular blocks, of m_block_size
+    std::vector<char*> m_large_blocks; // One per big allocation
+    char* m_current {nullptr};
+    char* m_end {nullptr};
+    size_t m_used {};
+    size_t m_reserved {};
+};
+
+#endif // ARENA_H
@@ -0,0 +1,21 @@
+#include "arena_string.h"
+
+void arena_string::reserve(size_t new_capacity){
+    if(new_capacity <= m_capacity)
+        return;
+
+    //The last allocation of the arena can grow where it is
+    if(!is_inline() && m_arena->try_extend(m_heap, m_capacity + 1, new_capacity + 1)){
+        m_capacity = static_cast<uint32_t>(new_capacity);
+        return;
+    }
+
+    //Otherwise move, at least doubling so repeated appends stay cheap
+    size_t grown = m_capacity * size_t{2};
+    if(grown > new_capacity)
+        new_capacity = grown;
+    char* characters = m_arena->allocate(new_capacity + 1);
+    std::memcpy(characters, data(), m_size + 1);
+    m_heap = characters;
+    m_capacity = static_cast<uint32_t>(new_capacity);
+}
@@ -0,0 +1,130 @@
+#ifndef ARENA_STRING_H
+#define ARENA_STRING_H
+
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string_view>
+#include "arena.h"
+
+//A string whose characters live in an Arena, or inside the object itself
+//when they fit ( up to 15 characters, like std::string's small string
+//optimization ).
+//  - no heap allocation, no free : the destructor does nothing, the arena
+//    releases everything at once.
+//  - growing moves the characters only when something else was allocated
+//    from the arena since : the last string allocated just extends.
+//  - copies are deep, into the arena of the source.
+//The arena must outlive its strings. Memory left behind when a string
+//moves, or is destroyed, is only recovered by Arena::reset().
+class arena_string
+{
+    static constexpr uint32_t INLINE_CAPACITY = 15;
+
+public:
+    explicit arena_string(Arena& arena) : m_arena(&arena) {
+        m_inline[0] = '\0';
+    }
+    arena_string(Arena& arena, std::string_view text) : arena_string(arena) {
+        append(text);
+    }
+    arena_string(const arena_string& source) : arena_string(*source.m_arena, source.view()) {}
+    arena_string& operator=(const arena_string& source){
+        if(this != &source){
+            clear();
+            append(source.view());
+        }
+        return *this;
+    }
+    arena_string& operator=(std::string_view text){
+        if(aliases(text)){
+            //Part of this string : move it to the front, nothing to allocate
+            char* characters = mutable_data();
+            std::memmove(characters, text.data(), text.size());
+            m_size = static_cast<uint32_t>(text.size());
+            characters[m_size] = '\0';
+            return *this;
+        }
+        clear();
+        append(text);
+        return *this;
+    }
+    ~arena_string() = default; // Nothing to free
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t capacity() const { return m_capacity; }
+    bool is_inline() const { return m_capacity == INLINE_CAPACITY; }
+
+    const char* data() const { return is_inline() ? m_inline : m_heap; }
+    const char* c_str() const { return data(); } // Always '\0' terminated
+    std::string_view view() const { return {data(), m_size}; }
+    operator std::string_view() const { return view(); }
+
+    char operator[](size_t index) const { return data()[index]; }
+
+    arena_string& append(std::string_view text){
+        //s.append(s.view()) : growing from inline overwrites the characters
+        //text points to, so find them again after reserve
+        if(aliases(text)){
+            size_t offset = static_cast<size_t>(text.data() - data());
+            reserve(m_size + text.size());
+            text = std::string_view(data() + offset, text.size());
+        }else{
+            reserve(m_size + text.size());
+        }
+        char* characters = mutable_data();
+        std::memcpy(characters + m_size, text.data(), text.size());
+        m_size += static_cast<uint32_t>(text.size());
+        characters[m_size] = '\0';
+        return *this;
+    }
+    arena_string& operator+=(std::string_view text) { return append(text); }
+    arena_string& operator+=(char c) { return append(std::string_view(&c, 1)); }
+
+    void reserve(size_t new_capacity);
+
+    void clear(){
+        m_size = 0;
+        mutable_data()[0] = '\0';
+    }
+
+    Arena& arena() const { return *m_arena; }
+
+    friend bool operator==(const arena_string& left, const arena_string& right){
+        return left.view() == right.view();
+    }
+    friend bool operator==(const arena_string& left, std::string_view right){
+        return left.view() == right;
+    }
+    friend std::strong_ordering operator<=>(const arena_string& left, const arena_string& right){
+        return left.view() <=> right.view();
+    }
+
+private:
+    char* mutable_data() { return is_inline() ? m_inline : m_heap; }
+
+    //Does text point into this string's characters ?
+    bool aliases(std::string_view text) const{
+        std::less_equal<const char*> less_equal; // Ordering unrelated pointers is only defined this way
+        return !text.empty() && less_equal(data(), text.data()) && less_equal(text.data(), data() + m_size);
+    }
+
+private:
+    Arena* m_arena;
+    uint32_t m_size {0};
+    uint32_t m_capacity {INLINE_CAPACITY}; // Not counting the '\0'
+    union{
+        char m_inline[INLINE_CAPACITY + 1];
+        char* m_heap;
+    };
+};
+
+inline std::ostream& operator<<(std::ostream& out, const arena_string& operand){
+    out << operand.view();
+    return out;
+}
+
+#endif // ARENA_STRING_H
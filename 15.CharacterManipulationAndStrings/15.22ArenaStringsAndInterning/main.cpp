@@ -0,0 +1,168 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include "arena.h"
+#include "arena_string.h"
+#include "string_builder.h"
+#include "string_interner.h"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Bytes currently allocated on the heap, where the C library can tell us
+size_t heap_in_use(){
+#ifdef __GLIBC__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+//Records the way Person, Dog or Shape store their description, and with an
+//interned one
+struct Record
+{
+    int id;
+    std::string description;
+};
+
+struct InternedRecord
+{
+    int id;
+    InternedString description;
+};
+
+
+int main(int argc, char** argv){
+
+    Arena arena;
+
+    //arena_string : small ones stay inside the object
+    arena_string greeting(arena, "Hello");
+    std::cout << "greeting : " << greeting << ", inline : " << std::boolalpha << greeting.is_inline() << std::endl;
+    greeting += " World, from a string that no longer fits inline";
+    std::cout << "greeting : " << greeting << ", inline : " << greeting.is_inline() << std::endl;
+    std::cout << "Arena bytes used : " << arena.bytes_used() << std::endl;
+
+    //Building in one go : size first, then one allocation
+    std::string str1{"Hello"};
+    std::string str2{"World"};
+    std::string message = concat(str1, " my ", str2, '!');
+    std::cout << "concat : " << message << std::endl;
+    arena_string arena_message = concat(arena, str1, " my ", str2, '!');
+    std::cout << "concat into the arena : " << arena_message << std::endl;
+
+    StringBuilder builder;
+    for(std::string_view word : {"one", "two", "three"})
+        builder << word << ",";
+    std::cout << "StringBuilder, " << builder.size() << " characters : " << builder.build() << std::endl;
+
+    //Interning : equal strings, equal ids
+    StringInterner interner;
+    InternedString dog1 = interner.intern("A dog with a long tail");
+    InternedString dog2 = interner.intern(std::string("A dog with a long ") + "tail");
+    InternedString cat = interner.intern("A cat");
+    std::cout << "dog1 == dog2 : " << (dog1 == dog2) << ", dog1 == cat : " << (dog1 == cat) << std::endl;
+    std::cout << "dog1 : id " << dog1.id() << ", \"" << interner.view(dog1) << "\"" << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark 1 : building strings. Default 1M, can be changed from the
+    //command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 1'000'000;
+    std::string first_name {"Daniel"};
+    std::string last_name {"Gray-Fitzgerald"};
+    std::string city {"San Francisco"};
+    size_t characters {};
+    std::cout << std::endl;
+    std::cout << "Building " << count << " strings of 5 pieces : " << std::endl;
+    std::cout << "operator+           : " << time_ms([&]{
+        for(size_t i{}; i < count; ++i){
+            std::string s = first_name + " " + last_name + ", " + city;
+            characters += s.size();
+        }
+    }) << " ms" << std::endl;
+    std::cout << "concat              : " << time_ms([&]{
+        for(size_t i{}; i < count; ++i){
+            std::string s = concat(first_name, ' ', last_name, ", ", city);
+            characters += s.size();
+        }
+    }) << " ms" << std::endl;
+    std::cout << "concat, arena       : " << time_ms([&]{
+        Arena local_arena;
+        for(size_t i{}; i < count; ++i){
+            arena_string s = concat(local_arena, first_name, ' ', last_name, ", ", city);
+            characters += s.size();
+            if(i % 1000 == 999)
+                local_arena.reset(); // A batch done
+        }
+    }) << " ms" << std::endl;
+
+    //Benchmark 2 : records repeating a few thousand descriptions
+    const size_t records = 2 * count;
+    const size_t distinct = 3000;
+    std::vector<std::string> descriptions(distinct);
+    for(size_t i{}; i < distinct; ++i)
+        descriptions[i] = concat("A description shared by many records, number ", std::to_string(i));
+    std::mt19937 generator {42};
+    std::uniform_int_distribution<size_t> pick {0, distinct - 1};
+    std::vector<size_t> picks(records);
+    for(size_t& p : picks)
+        p = pick(generator);
+
+    std::cout << std::endl;
+    std::cout << records << " records, " << distinct << " distinct descriptions : " << std::endl;
+    {
+        size_t heap_before = heap_in_use();
+        std::vector<Record> plain;
+        double fill = time_ms([&]{
+            plain.reserve(records);
+            for(size_t i{}; i < records; ++i)
+                plain.push_back({static_cast<int>(i), descriptions[picks[i]]});
+        });
+        size_t memory = heap_in_use() - heap_before;
+        size_t matches {};
+        double search = time_ms([&]{
+            for(const Record& record : plain)
+                matches += record.description == descriptions[17];
+        });
+        std::cout << "std::string  : " << memory / (1024 * 1024) << " MiB, fill " << fill
+                  << " ms, count equal " << search << " ms ( " << matches << " )" << std::endl;
+    }
+    {
+        size_t heap_before = heap_in_use();
+        StringInterner descriptions_table;
+        std::vector<InternedRecord> interned;
+        double fill = time_ms([&]{
+            interned.reserve(records);
+            for(size_t i{}; i < records; ++i)
+                interned.push_back({static_cast<int>(i), descriptions_table.intern(descriptions[picks[i]])});
+        });
+        size_t memory = heap_in_use() - heap_before;
+        size_t matches {};
+        InternedString target = *descriptions_table.find(descriptions[17]);
+        double search = time_ms([&]{
+            for(const InternedRecord& record : interned)
+                matches += record.description == target;
+        });
+        std::cout << "interned     : " << memory / (1024 * 1024) << " MiB, fill " << fill
+                  << " ms, count equal " << search << " ms ( " << matches << " )" << std::endl;
+    }
+    std::cout << "( checksum : " << characters << " )" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef STRING_BUILDER_H
+#define STRING_BUILDER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "arena.h"
+#include "arena_string.h"
+
+//Building a string out of pieces with + or repeated appends copies the
+//characters over and over, and reallocates whenever the capacity runs out :
+//    std::string message = str1 + " my " + str2 + "!"; // 3 temporaries
+//Here the final size is worked out first, the memory is allocated once, and
+//every character is written once.
+
+//A piece is anything that converts to std::string_view, or a single char
+inline std::string_view piece_view(std::string_view piece) { return piece; }
+inline std::string_view piece_view(const char& piece) { return {&piece, 1}; }
+
+template <typename... Pieces>
+size_t total_size(const Pieces&... pieces){
+    return (piece_view(pieces).size() + ... + 0);
+}
+
+//    std::string message = concat(str1, " my ", str2, '!');
+template <typename... Pieces>
+std::string concat(const Pieces&... pieces){
+    std::string result;
+    result.reserve(total_size(pieces...));
+    (result.append(piece_view(pieces)), ...);
+    return result;
+}
+
+//Same, into an arena
+template <typename... Pieces>
+arena_string concat(Arena& arena, const Pieces&... pieces){
+    arena_string result(arena);
+    result.reserve(total_size(pieces...));
+    (result.append(piece_view(pieces)), ...);
+    return result;
+}
+
+
+//When the pieces come one at a time, in a loop. The builder only remembers
+//where the pieces are : they must stay alive until build().
+class StringBuilder
+{
+public:
+    StringBuilder& add(std::string_view piece){
+        m_pieces.push_back(piece);
+        m_size += piece.size();
+        return *this;
+    }
+    StringBuilder& operator<<(std::string_view piece) { return add(piece); }
+
+    size_t size() const { return m_size; }
+    void clear(){
+        m_pieces.clear();
+        m_size = 0;
+    }
+
+    std::string build() const{
+        std::string result;
+        result.reserve(m_size);
+        for(std::string_view piece : m_pieces)
+            result.append(piece);
+        return result;
+    }
+
+    arena_string build(Arena& arena) const{
+        arena_string result(arena);
+        result.reserve(m_size);
+        for(std::string_view piece : m_pieces)
+            result.append(piece);
+        return result;
+    }
+
+private:
+    std::vector<std::string_view> m_pieces;
+    size_t m_size {};
+};
+
+#endif // STRING_BUILDER_H
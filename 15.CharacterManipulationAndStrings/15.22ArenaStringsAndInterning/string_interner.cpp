@@ -0,0 +1,67 @@
+#include <cstring>
+#include <functional>
+#include <utility>
+#include "string_interner.h"
+
+StringInterner::StringInterner()
+    : m_slots(1024, EMPTY)
+{
+}
+
+size_t StringInterner::find_slot(std::string_view text, size_t hash) const{
+    //Linear probing : the table size is a power of two, and at most half full
+    const size_t mask = m_slots.size() - 1;
+    size_t slot = hash & mask;
+    while(m_slots[slot] != EMPTY){
+        uint32_t id = m_slots[slot];
+        if(m_hashes[id] == hash && m_strings[id] == text)
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+InternedString StringInterner::intern(std::string_view text){
+    const size_t hash = std::hash<std::string_view>{}(text);
+    size_t slot = find_slot(text, hash);
+    if(m_slots[slot] != EMPTY)
+        return InternedString(m_slots[slot]);
+
+    //New string : copy it into the arena
+    char* characters = m_arena.allocate(text.size());
+    std::memcpy(characters, text.data(), text.size());
+    const auto id = static_cast<uint32_t>(m_strings.size());
+    m_strings.emplace_back(characters, text.size());
+    m_hashes.push_back(hash);
+    m_slots[slot] = id;
+
+    if(m_strings.size() * 2 > m_slots.size())
+        grow();
+    return InternedString(id);
+}
+
+std::optional<InternedString> StringInterner::find(std::string_view text) const{
+    size_t slot = find_slot(text, std::hash<std::string_view>{}(text));
+    if(m_slots[slot] == EMPTY)
+        return std::nullopt;
+    return InternedString(m_slots[slot]);
+}
+
+void StringInterner::grow(){
+    std::vector<uint32_t> slots(m_slots.size() * 2, EMPTY);
+    const size_t mask = slots.size() - 1;
+    for(uint32_t id{}; id < m_strings.size(); ++id){
+        size_t slot = m_hashes[id] & mask;
+        while(slots[slot] != EMPTY)
+            slot = (slot + 1) & mask;
+        slots[slot] = id;
+    }
+    m_slots = std::move(slots);
+}
+
+size_t StringInterner::bytes_used() const{
+    return m_arena.bytes_reserved() +
+           m_strings.capacity() * sizeof(std::string_view) +
+           m_hashes.capacity() * sizeof(size_t) +
+           m_slots.capacity() * sizeof(uint32_t);
+}
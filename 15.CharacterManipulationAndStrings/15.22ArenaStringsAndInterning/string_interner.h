@@ -0,0 +1,64 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "arena.h"
+
+//Stands for a string stored once in a StringInterner : 4 bytes, compared by
+//id in one instruction, whatever the length of the string.
+class InternedString
+{
+    friend class StringInterner;
+
+public:
+    uint32_t id() const { return m_id; }
+    bool operator==(const InternedString&) const = default;
+
+private:
+    explicit InternedString(uint32_t id) : m_id(id) {}
+
+private:
+    uint32_t m_id;
+};
+
+//Keeps one copy of each distinct string, and gives every one a 32 bit id.
+//Millions of records repeating the same few thousand descriptions then
+//hold 4 byte ids instead of millions of copies.
+//Strings are never removed; they live as long as the interner. Ids from
+//different interners must not be mixed.
+class StringInterner
+{
+public:
+    StringInterner();
+
+    //The id of text, adding it if it's new
+    InternedString intern(std::string_view text);
+
+    //The id of text, if it was interned before
+    std::optional<InternedString> find(std::string_view text) const;
+
+    std::string_view view(InternedString string) const { return m_strings[string.id()]; }
+
+    size_t size() const { return m_strings.size(); }
+    size_t bytes_used() const; // Characters, plus the table
+
+private:
+    //Slot of text in m_slots : either holding its id, or the empty slot
+    //where it would go
+    size_t find_slot(std::string_view text, size_t hash) const;
+    void grow();
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    Arena m_arena;                           // The characters
+    std::vector<std::string_view> m_strings; // By id, pointing into m_arena
+    std::vector<size_t> m_hashes;            // By id, so growing doesn't rehash the text
+    std::vector<uint32_t> m_slots;           // Open addressing table of ids
+};
+
+#endif // STRING_INTERNER_H
@@ -0,0 +1,91 @@
+#include "batch_io.h"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__linux__)
+#define BATCH_IO_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const char* path)
+{
+#ifdef BATCH_IO_MMAP
+    int descriptor = ::open(path, O_RDONLY);
+    if(descriptor < 0)
+        throw std::runtime_error(std::string("can't open ") + path);
+    struct stat status {};
+    if(::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0){
+        m_size = static_cast<size_t>(status.st_size);
+        void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if(address != MAP_FAILED){
+            //Read front to back : let the kernel read ahead aggressively
+            ::madvise(address, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(address);
+            m_mapped = true;
+        }
+    }
+    ::close(descriptor);
+    if(m_mapped)
+        return;
+    m_size = 0;
+#endif
+    //Not mappable ( empty, a pipe, not Linux ) : read it all
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+        throw std::runtime_error(std::string("can't open ") + path);
+    m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+MappedFile::~MappedFile(){
+#ifdef BATCH_IO_MMAP
+    if(m_mapped)
+        ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+
+void OutputBuffer::write(std::string_view text){
+    if(text.size() > CAPACITY - m_size){
+        flush();
+        if(text.size() > CAPACITY){
+            std::fwrite(text.data(), 1, text.size(), m_file);
+            return;
+        }
+    }
+    std::memcpy(m_buffer + m_size, text.data(), text.size());
+    m_size += text.size();
+}
+
+void OutputBuffer::write(double value){
+    //The longest shortest-form double is 24 characters
+    constexpr size_t MAX_LENGTH {32};
+    if(CAPACITY - m_size < MAX_LENGTH)
+        flush();
+    auto [end, error] = std::to_chars(m_buffer + m_size, m_buffer + CAPACITY, value);
+    (void)error;
+    m_size = static_cast<size_t>(end - m_buffer);
+}
+
+void OutputBuffer::write(size_t value){
+    constexpr size_t MAX_LENGTH {20};
+    if(CAPACITY - m_size < MAX_LENGTH)
+        flush();
+    auto [end, error] = std::to_chars(m_buffer + m_size, m_buffer + CAPACITY, value);
+    (void)error;
+    m_size = static_cast<size_t>(end - m_buffer);
+}
+
+void OutputBuffer::flush(){
+    if(m_size){
+        std::fwrite(m_buffer, 1, m_size, m_file);
+        m_size = 0;
+    }
+    std::fflush(m_file);
+}
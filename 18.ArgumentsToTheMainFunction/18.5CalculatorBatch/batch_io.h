@@ -0,0 +1,106 @@
+#ifndef BATCH_IO_H
+#define BATCH_IO_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//A whole file as one string_view. On Linux the file is mapped in memory :
+//no copy, and the pages are read in as the lines are reached. Elsewhere it
+//is read into a buffer. Throws std::runtime_error if the file can't be read.
+class MappedFile
+{
+public:
+    explicit MappedFile(const char* path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view text() const { return {m_data, m_size}; }
+
+private:
+    const char* m_data {nullptr};
+    size_t m_size {};
+    bool m_mapped {false};
+    std::vector<char> m_buffer; // When the file couldn't be mapped
+};
+
+//Calls function(line) for each line of text, without the '\n' ( and '\r' ).
+template <typename Function>
+void for_each_line(std::string_view text, Function function){
+    while(!text.empty()){
+        size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        if(!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        function(line);
+        if(end == std::string_view::npos)
+            break;
+        text.remove_prefix(end + 1);
+    }
+}
+
+//Same, for a stream like stdin that can't be mapped : read in big chunks,
+//the partial line at the end of a chunk carried over to the next one.
+//Lines longer than a chunk make the buffer grow.
+template <typename Function>
+void for_each_line(std::FILE* file, Function function){
+    constexpr size_t CHUNK_SIZE {1 << 20};
+    std::vector<char> buffer(CHUNK_SIZE);
+    size_t kept {}; // Bytes of an unfinished line at the start of buffer
+
+    while(true){
+        if(kept == buffer.size())
+            buffer.resize(buffer.size() * 2);
+        size_t read = std::fread(buffer.data() + kept, 1, buffer.size() - kept, file);
+        if(read == 0)
+            break;
+        std::string_view text(buffer.data(), kept + read);
+        size_t last_newline = text.rfind('\n');
+        if(last_newline == std::string_view::npos){
+            kept += read;
+            continue;
+        }
+        for_each_line(text.substr(0, last_newline + 1), function);
+        kept = text.size() - last_newline - 1;
+        std::char_traits<char>::move(buffer.data(), buffer.data() + last_newline + 1, kept);
+    }
+    if(kept)
+        for_each_line(std::string_view(buffer.data(), kept), function);
+}
+
+
+//Collects output in a fixed buffer and hands it to fwrite when full : one
+//system call per 64 KB instead of one per line, as std::endl would do.
+//Numbers are written with std::to_chars : the shortest text that reads back
+//as the same double.
+class OutputBuffer
+{
+public:
+    explicit OutputBuffer(std::FILE* file) : m_file(file) {}
+    ~OutputBuffer() { flush(); }
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void write(std::string_view text);
+    void write(char c){
+        if(m_size == CAPACITY)
+            flush();
+        m_buffer[m_size++] = c;
+    }
+    void write(double value);
+    void write(size_t value);
+
+    void flush();
+
+private:
+    static constexpr size_t CAPACITY {64 * 1024};
+
+    std::FILE* m_file;
+    size_t m_size {};
+    char m_buffer[CAPACITY];
+};
+
+#endif // BATCH_IO_H
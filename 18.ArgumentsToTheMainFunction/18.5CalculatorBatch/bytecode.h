@@ -0,0 +1,47 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//An expression compiled for a stack machine. "2 + 3 x 4" becomes
+//    push 2, push 3, push 4, multiply, add
+//One byte per instruction. The numbers live in their own array, in the
+//order the push instructions use them, so push needs no operand.
+enum class OpCode : std::uint8_t
+{
+    push,      // Next constant onto the stack
+    add,       // Pop b, pop a, push a + b
+    subtract,
+    multiply,
+    divide,
+    modulo,    // std::fmod
+    power,     // std::pow
+    negate     // Pop a, push -a
+};
+
+struct Program
+{
+    std::vector<OpCode> code;
+    std::vector<double> constants;
+    size_t max_depth {}; // Deepest the stack gets while running
+
+    //Keeps the capacity : compiling the next expression into the same
+    //Program allocates nothing, once the vectors are big enough
+    void clear(){
+        code.clear();
+        constants.clear();
+        max_depth = 0;
+    }
+};
+
+//Fixed size stack of the virtual machine. The compiler rejects expressions
+//that would need more.
+inline constexpr size_t max_stack_depth {64};
+
+//Runs program. Division by zero gives inf or nan, like the calculators of
+//18.3 and 18.4.
+double evaluate(const Program& program);
+
+#endif // BYTECODE_H
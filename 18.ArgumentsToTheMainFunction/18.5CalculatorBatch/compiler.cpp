@@ -0,0 +1,170 @@
+#include "compiler.h"
+#include <charconv>
+
+namespace{
+
+//Precedence climbing : a binary operator binds tighter the higher its
+//precedence. parse_expression(p) reads a run of operands joined by operators
+//of precedence p or more, and leaves looser operators to its caller.
+class Parser
+{
+public:
+    Parser(std::string_view text, Program& program)
+        : m_text(text), m_program(program)
+    {
+    }
+
+    expected<void, CompileError> parse(){
+        if(!parse_expression(1))
+            return unexpected(m_error);
+        skip_spaces();
+        if(m_position != m_text.size())
+            return unexpected(CompileError{m_position + 1, m_text[m_position] == ')' ? "unmatched ')'" : "expected an operator"});
+        return {};
+    }
+
+private:
+    struct Binary
+    {
+        OpCode op;
+        int precedence;
+        bool right_associative;
+    };
+
+    static constexpr int UNARY_PRECEDENCE {3};
+    static constexpr size_t MAX_NESTING {max_stack_depth};
+
+    //The binary operator at the current position, if any
+    bool peek_binary(Binary& binary){
+        skip_spaces();
+        if(m_position == m_text.size())
+            return false;
+        switch(m_text[m_position]){
+            case '+' : binary = {OpCode::add, 1, false}; return true;
+            case '-' : binary = {OpCode::subtract, 1, false}; return true;
+            case '*' :
+            case 'x' : binary = {OpCode::multiply, 2, false}; return true;
+            case '/' : binary = {OpCode::divide, 2, false}; return true;
+            case '%' : binary = {OpCode::modulo, 2, false}; return true;
+            case '^' : binary = {OpCode::power, 4, true}; return true;
+            default : return false;
+        }
+    }
+
+    bool parse_expression(int min_precedence){
+        if(!parse_unary())
+            return false;
+        Binary binary;
+        while(peek_binary(binary) && binary.precedence >= min_precedence){
+            ++m_position;
+            if(binary.right_associative){
+                //a ^ b ^ c recurses once per ^ : counted like a parenthesis
+                if(!enter() || !parse_expression(binary.precedence))
+                    return false;
+                --m_nesting;
+            }else{
+                //Left associative : the right operand only takes tighter
+                //operators, so a - b - c groups as ( a - b ) - c
+                if(!parse_expression(binary.precedence + 1))
+                    return false;
+            }
+            emit(binary.op);
+        }
+        return true;
+    }
+
+    //A primary, with any number of unary minus / plus in front. They bind
+    //looser than ^ : -2^2 is -(2^2).
+    bool parse_unary(){
+        skip_spaces();
+        if(m_position < m_text.size() && (m_text[m_position] == '-' || m_text[m_position] == '+')){
+            const bool minus = m_text[m_position] == '-';
+            ++m_position;
+            if(!enter() || !parse_expression(UNARY_PRECEDENCE + 1))
+                return false;
+            --m_nesting;
+            if(minus)
+                emit(OpCode::negate);
+            return true;
+        }
+        return parse_primary();
+    }
+
+    bool parse_primary(){
+        skip_spaces();
+        if(m_position == m_text.size())
+            return fail("expected a number");
+
+        if(m_text[m_position] == '('){
+            ++m_position;
+            if(!enter() || !parse_expression(1))
+                return false;
+            --m_nesting;
+            skip_spaces();
+            if(m_position == m_text.size() || m_text[m_position] != ')')
+                return fail("expected ')'");
+            ++m_position;
+            return true;
+        }
+
+        double value {};
+        const char* first = m_text.data() + m_position;
+        const char* last = m_text.data() + m_text.size();
+        auto [end, error] = std::from_chars(first, last, value);
+        if(error == std::errc::invalid_argument)
+            return fail("expected a number");
+        if(error == std::errc::result_out_of_range)
+            return fail("number out of range");
+        m_position += static_cast<size_t>(end - first);
+        m_program.constants.push_back(value);
+        emit(OpCode::push);
+        return true;
+    }
+
+    //Bounds the recursion, and with it the stack depth the program needs
+    bool enter(){
+        if(++m_nesting > MAX_NESTING)
+            return fail("too deeply nested");
+        return true;
+    }
+
+    void emit(OpCode op){
+        m_program.code.push_back(op);
+        //Track the stack depth the program reaches
+        if(op == OpCode::push){
+            if(++m_depth > m_program.max_depth)
+                m_program.max_depth = m_depth;
+        }else if(op != OpCode::negate){
+            --m_depth;
+        }
+    }
+
+    bool fail(const char* message){
+        m_error = {m_position + 1, message};
+        return false;
+    }
+
+    void skip_spaces(){
+        while(m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\t'))
+            ++m_position;
+    }
+
+private:
+    std::string_view m_text;
+    Program& m_program;
+    size_t m_position {};
+    size_t m_nesting {};
+    size_t m_depth {};
+    CompileError m_error {};
+};
+
+} // namespace
+
+
+expected<void, CompileError> compile(std::string_view text, Program& program){
+    program.clear();
+    auto result = Parser(text, program).parse();
+    if(result && program.max_depth > max_stack_depth)
+        return unexpected(CompileError{1, "expression needs too deep a stack"});
+    return result;
+}
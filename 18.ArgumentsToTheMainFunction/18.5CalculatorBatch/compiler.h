@@ -0,0 +1,27 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include <cstddef>
+#include <string_view>
+#include "bytecode.h"
+#include "expected.h"
+
+//Where and why an expression didn't compile. column counts from 1.
+struct CompileError
+{
+    size_t column;
+    const char* message;
+};
+
+//Compiles text like "3.5 x (2 - 1) / 4" into program, replacing what was in
+//it. The grammar, loosest binding first :
+//    + -           left to right
+//    * x / %       left to right ( x is there because the shell expands * )
+//    - ( unary )
+//    ^             right to left : 2^3^2 is 2^9. -2^2 is -4.
+//    numbers, ( expression )
+//Numbers are parsed with std::from_chars : "1.5e3" works, whatever the locale.
+//Spaces are allowed anywhere between tokens.
+expected<void, CompileError> compile(std::string_view text, Program& program);
+
+#endif // COMPILER_H
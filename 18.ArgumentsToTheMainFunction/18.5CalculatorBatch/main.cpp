@@ -0,0 +1,312 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+#include "bytecode.h"
+#include "compiler.h"
+#include "batch_io.h"
+
+//18.4CalculatorV2 does one a op b per process launch : a script that needs a
+//million results pays for a million process startups. Here one process
+//reads expressions, one per line, and writes one result per line :
+//    calculator 3 + 4                    same as 18.4, prints 3+4=7
+//    calculator --batch expressions.txt  file mapped in memory
+//    calculator --batch < expressions.txt
+//    calculator --benchmark 1000000
+//Each line is compiled to bytecode (compiler.h), run on a small stack
+//machine (bytecode.h), and the result goes through a 64 KB output buffer.
+//Once the Program's vectors have grown to fit the longest expression,
+//nothing is allocated per line.
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Compiles and runs one line, writes the result or the error
+void process_line(std::string_view line, Program& program, OutputBuffer& out){
+    if(auto compiled = compile(line, program); compiled){
+        out.write(evaluate(program));
+    }else{
+        out.write("error : ");
+        out.write(std::string_view(compiled.error().message));
+        out.write(" at column ");
+        out.write(compiled.error().column);
+    }
+    out.write('\n');
+}
+
+//Feeds every line of source ( a string_view or a FILE* ) through
+//process_line. Returns the number of lines.
+template <typename Source>
+size_t run_batch(Source source, std::FILE* output){
+    Program program;
+    OutputBuffer out(output);
+    size_t lines {};
+    for_each_line(source, [&](std::string_view line){
+        process_line(line, program, out);
+        ++lines;
+    });
+    return lines;
+}
+
+
+//The way one would write it without thinking about speed : a string per
+//token, std::stod, a recursive walk over the tokens, std::endl per result.
+class NaiveCalculator
+{
+public:
+    double evaluate(const std::string& line){
+        m_tokens.clear();
+        m_next = 0;
+        std::string number;
+        for(char c : line){
+            if(std::isdigit(static_cast<unsigned char>(c)) || c == '.'){
+                number += c;
+                continue;
+            }
+            if(!number.empty()){
+                m_tokens.push_back(number);
+                number.clear();
+            }
+            if(c != ' ')
+                m_tokens.push_back(std::string(1, c));
+        }
+        if(!number.empty())
+            m_tokens.push_back(number);
+        return sum();
+    }
+
+private:
+    std::string peek() const { return m_next < m_tokens.size() ? m_tokens[m_next] : ""; }
+
+    double sum(){
+        double value = product();
+        while(peek() == "+" || peek() == "-")
+            value = (m_tokens[m_next++] == "+") ? value + product() : value - product();
+        return value;
+    }
+
+    double product(){
+        double value = factor();
+        while(peek() == "x" || peek() == "/"){
+            if(m_tokens[m_next++] == "x")
+                value *= factor();
+            else
+                value /= factor();
+        }
+        return value;
+    }
+
+    double factor(){
+        std::string token = m_tokens.at(m_next++);
+        if(token == "-")
+            return -factor();
+        if(token == "("){
+            double value = sum();
+            ++m_next; // ')'
+            return value;
+        }
+        return std::stod(token);
+    }
+
+    std::vector<std::string> m_tokens;
+    size_t m_next {};
+};
+
+
+//count random expressions like "12.5 x (3 - 0.25) / 7 + 1", one per line
+std::string make_expressions(size_t count){
+    std::mt19937 generator {2024};
+    std::uniform_int_distribution<int> integer(1, 999);
+    std::uniform_int_distribution<int> choice(0, 3);
+    const char operators[] {'+', '-', 'x', '/'};
+    auto number = [&]{
+        std::string text = std::to_string(integer(generator));
+        if(choice(generator) == 0)
+            text += "." + std::to_string(integer(generator) % 100);
+        return text;
+    };
+
+    std::string text;
+    for(size_t i{}; i < count; ++i){
+        text += number();
+        int terms = 2 + choice(generator);
+        for(int t{}; t < terms; ++t){
+            text += ' ';
+            text += operators[choice(generator)];
+            text += ' ';
+            if(choice(generator) == 0)
+                text += "(" + number() + " - " + number() + ")";
+            else
+                text += number();
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+void demo(){
+    const char* expressions[] {
+        "3 + 4",
+        "2 + 3 x 4",
+        "(2 + 3) x 4",
+        "10 - 4 - 3",          // Left to right : 3
+        "2 ^ 3 ^ 2",           // Right to left : 512
+        "-2 ^ 2",              // -4, as in maths
+        "7 % 3 + 1.5e1",
+        "1 / 0",
+        "0.1 + 0.2",           // Printed exactly as the double it is
+        "2 x (3 + 4",
+        "2 + * 3",
+        "12 34",
+    };
+    Program program;
+    OutputBuffer out(stdout);
+    for(const char* expression : expressions){
+        out.write("    ");
+        out.write(std::string_view(expression));
+        out.write(" -> ");
+        process_line(expression, program, out);
+    }
+    out.write("    bytecode of \"2 + 3 x 4\" :");
+    (void)compile("2 + 3 x 4", program);
+    const char* names[] {"push", "add", "subtract", "multiply", "divide", "modulo", "power", "negate"};
+    for(OpCode op : program.code){
+        out.write(' ');
+        out.write(std::string_view(names[static_cast<int>(op)]));
+    }
+    out.write("\n    stack depth : ");
+    out.write(program.max_depth);
+    out.write('\n');
+}
+
+void benchmark(size_t count){
+    std::cout << "Generating " << count << " expressions..." << std::endl;
+    std::string text = make_expressions(count);
+    std::vector<std::string> lines;
+    std::istringstream input(text);
+    for(std::string line; std::getline(input, line);)
+        lines.push_back(line);
+
+    auto report = [&](const char* name, double ms){
+        std::cout << name << " : " << ms << " ms, "
+                  << static_cast<double>(count) / ms * 1000.0 / 1e6 << " million expressions/s" << std::endl;
+    };
+
+    //Same results both ways ?
+    {
+        NaiveCalculator naive;
+        Program program;
+        size_t mismatches {};
+        for(const std::string& line : lines){
+            (void)compile(line, program);
+            double fast = evaluate(program);
+            double slow = naive.evaluate(line);
+            if(fast != slow && !(std::isnan(fast) && std::isnan(slow)))
+                ++mismatches;
+        }
+        std::cout << "Mismatches against the naive calculator : " << mismatches << std::endl;
+    }
+
+    //Writing to a file discards nothing : measure the write path, not a terminal
+    std::ofstream null_stream("/dev/null");
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if(!null_stream || !null_file)
+        throw std::runtime_error("can't open /dev/null");
+
+    report("naive, std::stod + std::endl       ", time_ms([&]{
+        NaiveCalculator naive;
+        for(const std::string& line : lines)
+            null_stream << naive.evaluate(line) << std::endl;
+    }));
+
+    report("bytecode, buffered output          ", time_ms([&]{
+        run_batch(std::string_view(text), null_file);
+    }));
+
+    double sum {};
+    report("compile + evaluate, no output      ", time_ms([&]{
+        Program program;
+        for_each_line(std::string_view(text), [&](std::string_view line){
+            (void)compile(line, program);
+            if(double result = evaluate(program); std::isfinite(result))
+                sum += result;
+        });
+    }));
+
+    //The VM alone : one program compiled once, run count times
+    Program program;
+    (void)compile(std::string_view(lines.front()), program);
+    report("evaluate only                      ", time_ms([&]{
+        for(size_t i{}; i < count; ++i){
+            sum += evaluate(program);
+            //Keep the compiler from hoisting the call out of the loop
+            asm volatile("" : : "g"(&program) : "memory");
+        }
+    }));
+    std::cout << "(checksum " << sum << ")" << std::endl;
+    std::fclose(null_file);
+}
+
+
+int main(int argc, char** argv){
+
+    //18.4 style : calculator 3 + 4, or any expression split over arguments
+    if(argc > 1 && std::strncmp(argv[1], "--", 2) != 0){
+        std::string expression;
+        for(int i{1}; i < argc; ++i){
+            expression += argv[i];
+            expression += ' ';
+        }
+        Program program;
+        OutputBuffer out(stdout);
+        out.write(std::string_view(expression.data(), expression.size() - 1));
+        out.write('=');
+        process_line(expression, program, out);
+        return 0;
+    }
+
+    try{
+        if(argc > 1 && std::strcmp(argv[1], "--batch") == 0){
+            if(argc > 2){
+                MappedFile file(argv[2]);
+                run_batch(file.text(), stdout);
+            }else{
+                run_batch(stdin, stdout);
+            }
+            return 0;
+        }
+
+        if(argc > 1 && std::strcmp(argv[1], "--benchmark") != 0){
+            std::cerr << "Usage : " << argv[0] << " a + b" << std::endl;
+            std::cerr << "        " << argv[0] << " --batch [file]" << std::endl;
+            std::cerr << "        " << argv[0] << " --benchmark [count]" << std::endl;
+            return 1;
+        }
+
+        demo();
+
+        std::cout << "----------" << std::endl;
+
+        size_t count = (argc > 2) ? std::stoul(argv[2]) : 1'000'000;
+        benchmark(count);
+    }catch(const std::exception& exception){
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include "bytecode.h"
+#include <cmath>
+
+//The whole machine : one switch per instruction, the stack in a local array
+//the compiler keeps in the cache, no checks. The compiler already made sure
+//the program is well formed and fits in the stack.
+double evaluate(const Program& program){
+    double stack[max_stack_depth];
+    double* top = stack; // One past the last value
+    const double* constant = program.constants.data();
+
+    for(OpCode op : program.code){
+        switch(op){
+            case OpCode::push :
+                *top++ = *constant++;
+                break;
+            case OpCode::add :
+                --top;
+                top[-1] += top[0];
+                break;
+            case OpCode::subtract :
+                --top;
+                top[-1] -= top[0];
+                break;
+            case OpCode::multiply :
+                --top;
+                top[-1] *= top[0];
+                break;
+            case OpCode::divide :
+                --top;
+                top[-1] /= top[0];
+                break;
+            case OpCode::modulo :
+                --top;
+                top[-1] = std::fmod(top[-1], top[0]);
+                break;
+            case OpCode::power :
+                --top;
+                top[-1] = std::pow(top[-1], top[0]);
+                break;
+            case OpCode::negate :
+                top[-1] = -top[-1];
+                break;
+        }
+    }
+    return stack[0];
+}
@@ -0,0 +1,34 @@
+#ifndef DOG_H
+#define DOG_H
+
+#include <string>
+#include <iostream>
+#include "intrusive_ptr.h"
+
+//The reference count lives inside the Dog. LocalPolicy : dogs stay on the
+//thread that created them, so the count doesn't need atomic operations.
+class Dog : public ref_counted<Dog, LocalPolicy>
+{
+public:
+    explicit Dog(std::string name_param);
+    Dog() = default;
+    ~Dog();
+    
+    std::string get_name() const{
+        return dog_name;
+    }
+    
+    void set_dog_name(const std::string & name){
+        dog_name = name;
+    }
+	
+	void print_info() const{
+		std::cout << "Dog [ name : " << dog_name << " ]" <<  std::endl;
+	}
+    
+private:
+    std::string dog_name {"Puffy"};
+};
+
+
+#endif // DOG_H
@@ -0,0 +1,244 @@
+#ifndef INTRUSIVE_PTR_H
+#define INTRUSIVE_PTR_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "ref_count_policy.h"
+
+//Intrusive reference counting : the count lives inside the object itself,
+//in a ref_counted base class, instead of in a separate control block.
+//    class Dog : public ref_counted<Dog, LocalPolicy> { ... };
+//    intrusive_ptr<Dog> dog = make_intrusive<Dog>("Fluffy");
+//  - one allocation per object, whatever way it was created.
+//  - the pointer is a single raw pointer : copying it is one increment.
+//  - a raw Dog* can be turned back into an owning intrusive_ptr at any time.
+//Weak references are supported through a small side block, created the
+//first time an intrusive_weak_ptr to the object is made.
+//The object is deleted as a Derived. If you point to it through a base class
+//of Derived, that base class needs a virtual destructor.
+
+template <typename T> class intrusive_ptr;
+template <typename T> class intrusive_weak_ptr;
+
+template <typename Derived, typename Policy = AtomicPolicy>
+class ref_counted
+{
+    template <typename> friend class intrusive_weak_ptr;
+
+public:
+    using policy_type = Policy;
+
+    long use_count() const { return m_count.get(); }
+
+protected:
+    ref_counted() = default;
+    //A copy of an object is a new object : it starts with no references
+    ref_counted(const ref_counted&) {}
+    ref_counted& operator=(const ref_counted&) { return *this; }
+    ~ref_counted() = default;
+
+private:
+    //Shared by the object and its weak references
+    struct WeakControl
+    {
+        typename Policy::Count weak_count {1}; // The object itself holds one
+        typename Policy::Guard guard;
+        Derived* object;
+    };
+
+    //Found by argument dependent lookup from intrusive_ptr
+    friend void intrusive_ptr_add_ref(const ref_counted* object){
+        object->m_count.increment();
+    }
+
+    friend void intrusive_ptr_release(const ref_counted* object){
+        if(object->m_count.decrement() == 0)
+            object->destroy();
+    }
+
+    void destroy() const{
+        if(WeakControl* control = m_weak_control.load(std::memory_order_acquire)){
+            //A weak reference being locked right now holds the guard : wait
+            //for it, then make sure no later lock can reach the object.
+            control->guard.lock();
+            control->object = nullptr;
+            control->guard.unlock();
+            release_control(control);
+        }
+        delete static_cast<const Derived*>(this);
+    }
+
+    //Returns the weak control block with one more weak reference on it
+    WeakControl* acquire_control() const{
+        WeakControl* control = m_weak_control.load(std::memory_order_acquire);
+        if(!control){
+            auto fresh = new WeakControl{};
+            fresh->object = const_cast<Derived*>(static_cast<const Derived*>(this));
+            if(m_weak_control.compare_exchange_strong(control, fresh, std::memory_order_acq_rel))
+                control = fresh;
+            else
+                delete fresh; // Another thread got there first, control is theirs
+        }
+        control->weak_count.increment();
+        return control;
+    }
+
+    static void release_control(WeakControl* control){
+        if(control->weak_count.decrement() == 0)
+            delete control;
+    }
+
+private:
+    mutable typename Policy::Count m_count {0};
+    mutable std::atomic<WeakControl*> m_weak_control {nullptr};
+};
+
+
+template <typename T>
+class intrusive_ptr
+{
+    template <typename> friend class intrusive_ptr;
+
+public:
+    using element_type = T;
+
+    intrusive_ptr() noexcept = default;
+    intrusive_ptr(std::nullptr_t) noexcept {}
+
+    //add_ref = false adopts a reference the caller already owns
+    explicit intrusive_ptr(T* pointer, bool add_ref = true)
+        : m_pointer(pointer)
+    {
+        if(m_pointer && add_ref)
+            intrusive_ptr_add_ref(m_pointer);
+    }
+
+    intrusive_ptr(const intrusive_ptr& source) noexcept
+        : intrusive_ptr(source.m_pointer)
+    {
+    }
+
+    intrusive_ptr(intrusive_ptr&& source) noexcept
+        : m_pointer(std::exchange(source.m_pointer, nullptr))
+    {
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    intrusive_ptr(const intrusive_ptr<U>& source) noexcept
+        : intrusive_ptr(source.m_pointer)
+    {
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    intrusive_ptr(intrusive_ptr<U>&& source) noexcept
+        : m_pointer(std::exchange(source.m_pointer, nullptr))
+    {
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr source) noexcept{
+        swap(source);
+        return *this;
+    }
+
+    ~intrusive_ptr(){
+        if(m_pointer)
+            intrusive_ptr_release(m_pointer);
+    }
+
+    void reset() noexcept { intrusive_ptr().swap(*this); }
+    void swap(intrusive_ptr& other) noexcept { std::swap(m_pointer, other.m_pointer); }
+
+    //Gives up ownership without touching the count
+    T* detach() noexcept { return std::exchange(m_pointer, nullptr); }
+
+    T* get() const noexcept { return m_pointer; }
+    T& operator*() const noexcept { return *m_pointer; }
+    T* operator->() const noexcept { return m_pointer; }
+    explicit operator bool() const noexcept { return m_pointer != nullptr; }
+
+    long use_count() const { return m_pointer ? m_pointer->use_count() : 0; }
+
+    template <typename U>
+    bool operator==(const intrusive_ptr<U>& other) const noexcept { return m_pointer == other.get(); }
+    bool operator==(std::nullptr_t) const noexcept { return m_pointer == nullptr; }
+
+private:
+    T* m_pointer {nullptr};
+};
+
+template <typename T, typename... Args>
+intrusive_ptr<T> make_intrusive(Args&&... args){
+    return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+
+//Doesn't keep the object alive. lock() gives an intrusive_ptr, empty if
+//the object is gone.
+template <typename T>
+class intrusive_weak_ptr
+{
+    //The ref_counted base that T derives from, whatever its policy
+    template <typename D, typename P>
+    static ref_counted<D, P>* base_of(ref_counted<D, P>* base) { return base; }
+    using Base = std::remove_pointer_t<decltype(base_of(std::declval<T*>()))>;
+    using Control = typename Base::WeakControl;
+
+public:
+    intrusive_weak_ptr() noexcept = default;
+
+    intrusive_weak_ptr(const intrusive_ptr<T>& strong)
+    {
+        if(strong)
+            m_control = static_cast<const Base*>(strong.get())->acquire_control();
+    }
+
+    intrusive_weak_ptr(const intrusive_weak_ptr& source) noexcept
+        : m_control(source.m_control)
+    {
+        if(m_control)
+            m_control->weak_count.increment();
+    }
+
+    intrusive_weak_ptr(intrusive_weak_ptr&& source) noexcept
+        : m_control(std::exchange(source.m_control, nullptr))
+    {
+    }
+
+    intrusive_weak_ptr& operator=(intrusive_weak_ptr source) noexcept{
+        std::swap(m_control, source.m_control);
+        return *this;
+    }
+
+    ~intrusive_weak_ptr(){
+        if(m_control)
+            Base::release_control(m_control);
+    }
+
+    intrusive_ptr<T> lock() const{
+        if(!m_control)
+            return {};
+        m_control->guard.lock();
+        T* object = static_cast<T*>(m_control->object);
+        bool alive = object && static_cast<const Base*>(object)->m_count.increment_if_not_zero();
+        m_control->guard.unlock();
+        return alive ? intrusive_ptr<T>(object, false) : intrusive_ptr<T>();
+    }
+
+    bool expired() const{
+        if(!m_control)
+            return true;
+        m_control->guard.lock();
+        bool gone = m_control->object == nullptr;
+        m_control->guard.unlock();
+        return gone;
+    }
+
+private:
+    Control* m_control {nullptr};
+};
+
+#endif // INTRUSIVE_PTR_H
@@ -0,0 +1,219 @@
+#ifndef LOCAL_SHARED_PTR_H
+#define LOCAL_SHARED_PTR_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//shared_ptr for objects that stay on one thread. Same interface idea as
+//std::shared_ptr / std::weak_ptr, but the counts are plain integers : no
+//atomic instructions when copying or destroying a pointer.
+//Copying a local_shared_ptr, or one of its weak pointers, to another thread
+//and using it there is a data race. Keep them confined to their thread.
+
+struct LocalControlBlock
+{
+    long strong_count {1};
+    long weak_count {1}; // All the strong references together hold one
+    void (*destroy_object)(LocalControlBlock*);
+    void (*deallocate)(LocalControlBlock*);
+};
+
+//Control block and object in a single allocation, like std::make_shared
+template <typename T>
+struct LocalInplaceBlock : LocalControlBlock
+{
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* object() { return std::launder(reinterpret_cast<T*>(storage)); }
+};
+
+//Control block for an object allocated separately, with new
+template <typename T>
+struct LocalPointerBlock : LocalControlBlock
+{
+    T* pointer;
+};
+
+
+template <typename T> class local_weak_ptr;
+
+template <typename T>
+class local_shared_ptr
+{
+    template <typename> friend class local_shared_ptr;
+    template <typename> friend class local_weak_ptr;
+    template <typename U, typename... Args>
+    friend local_shared_ptr<U> make_local_shared(Args&&... args);
+
+public:
+    using element_type = T;
+
+    local_shared_ptr() noexcept = default;
+    local_shared_ptr(std::nullptr_t) noexcept {}
+
+    //Takes ownership of an object allocated with new
+    explicit local_shared_ptr(T* pointer)
+    {
+        if(!pointer)
+            return;
+        LocalPointerBlock<T>* block;
+        try{
+            block = new LocalPointerBlock<T>{};
+        }catch(...){
+            delete pointer;
+            throw;
+        }
+        block->pointer = pointer;
+        block->destroy_object = [](LocalControlBlock* base){
+            delete static_cast<LocalPointerBlock<T>*>(base)->pointer;
+        };
+        block->deallocate = [](LocalControlBlock* base){
+            delete static_cast<LocalPointerBlock<T>*>(base);
+        };
+        m_pointer = pointer;
+        m_control = block;
+    }
+
+    local_shared_ptr(const local_shared_ptr& source) noexcept
+        : m_pointer(source.m_pointer), m_control(source.m_control)
+    {
+        if(m_control)
+            ++m_control->strong_count;
+    }
+
+    local_shared_ptr(local_shared_ptr&& source) noexcept
+        : m_pointer(std::exchange(source.m_pointer, nullptr)),
+          m_control(std::exchange(source.m_control, nullptr))
+    {
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    local_shared_ptr(const local_shared_ptr<U>& source) noexcept
+        : m_pointer(source.m_pointer), m_control(source.m_control)
+    {
+        if(m_control)
+            ++m_control->strong_count;
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    local_shared_ptr(local_shared_ptr<U>&& source) noexcept
+        : m_pointer(std::exchange(source.m_pointer, nullptr)),
+          m_control(std::exchange(source.m_control, nullptr))
+    {
+    }
+
+    local_shared_ptr& operator=(local_shared_ptr source) noexcept{
+        swap(source);
+        return *this;
+    }
+
+    ~local_shared_ptr(){
+        if(m_control && --m_control->strong_count == 0){
+            m_control->destroy_object(m_control);
+            if(--m_control->weak_count == 0)
+                m_control->deallocate(m_control);
+        }
+    }
+
+    void reset() noexcept { local_shared_ptr().swap(*this); }
+    void swap(local_shared_ptr& other) noexcept{
+        std::swap(m_pointer, other.m_pointer);
+        std::swap(m_control, other.m_control);
+    }
+
+    T* get() const noexcept { return m_pointer; }
+    T& operator*() const noexcept { return *m_pointer; }
+    T* operator->() const noexcept { return m_pointer; }
+    explicit operator bool() const noexcept { return m_pointer != nullptr; }
+    long use_count() const noexcept { return m_control ? m_control->strong_count : 0; }
+
+private:
+    //Adopts a strong reference already counted in control
+    local_shared_ptr(T* pointer, LocalControlBlock* control) noexcept
+        : m_pointer(pointer), m_control(control)
+    {
+    }
+
+private:
+    T* m_pointer {nullptr};
+    LocalControlBlock* m_control {nullptr};
+};
+
+template <typename T, typename... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args){
+    auto block = new LocalInplaceBlock<T>; // No braces : leave the storage uninitialized
+    try{
+        ::new (static_cast<void*>(block->storage)) T(std::forward<Args>(args)...);
+    }catch(...){
+        delete block;
+        throw;
+    }
+    block->destroy_object = [](LocalControlBlock* base){
+        static_cast<LocalInplaceBlock<T>*>(base)->object()->~T();
+    };
+    block->deallocate = [](LocalControlBlock* base){
+        delete static_cast<LocalInplaceBlock<T>*>(base);
+    };
+    return local_shared_ptr<T>(block->object(), block);
+}
+
+
+template <typename T>
+class local_weak_ptr
+{
+public:
+    local_weak_ptr() noexcept = default;
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    local_weak_ptr(const local_shared_ptr<U>& strong) noexcept
+        : m_pointer(strong.m_pointer), m_control(strong.m_control)
+    {
+        if(m_control)
+            ++m_control->weak_count;
+    }
+
+    local_weak_ptr(const local_weak_ptr& source) noexcept
+        : m_pointer(source.m_pointer), m_control(source.m_control)
+    {
+        if(m_control)
+            ++m_control->weak_count;
+    }
+
+    local_weak_ptr(local_weak_ptr&& source) noexcept
+        : m_pointer(std::exchange(source.m_pointer, nullptr)),
+          m_control(std::exchange(source.m_control, nullptr))
+    {
+    }
+
+    local_weak_ptr& operator=(local_weak_ptr source) noexcept{
+        std::swap(m_pointer, source.m_pointer);
+        std::swap(m_control, source.m_control);
+        return *this;
+    }
+
+    ~local_weak_ptr(){
+        if(m_control && --m_control->weak_count == 0)
+            m_control->deallocate(m_control);
+    }
+
+    bool expired() const noexcept { return !m_control || m_control->strong_count == 0; }
+    long use_count() const noexcept { return m_control ? m_control->strong_count : 0; }
+
+    local_shared_ptr<T> lock() const noexcept{
+        if(expired())
+            return {};
+        ++m_control->strong_count;
+        return local_shared_ptr<T>(m_pointer, m_control);
+    }
+
+private:
+    T* m_pointer {nullptr};
+    LocalControlBlock* m_control {nullptr};
+};
+
+#endif // LOCAL_SHARED_PTR_H
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <string>
+#include "dog.h"
+#include "person.h"
+#include "intrusive_ptr.h"
+#include "local_shared_ptr.h"
+
+//Passing by value : a copy is made, the count goes up and back down for
+//every call. noinline so the compiler can't optimize the copy away.
+template <typename Pointer>
+[[gnu::noinline]] long use_by_value(Pointer pointer){
+    return pointer->value;
+}
+
+//Small payloads for the benchmark, one per counting strategy
+struct Payload
+{
+    long value {1};
+};
+
+struct AtomicPayload : ref_counted<AtomicPayload, AtomicPolicy>
+{
+    long value {1};
+};
+
+struct LocalPayload : ref_counted<LocalPayload, LocalPolicy>
+{
+    long value {1};
+};
+
+template <typename Pointer>
+void run_benchmark(const std::string& label, const Pointer& pointer){
+    const size_t calls {50'000'000};
+    long total {};
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i{}; i < calls; ++i){
+        total += use_by_value(pointer);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "  " << label << " : "
+              << std::chrono::duration<double, std::nano>(end - start).count() / calls
+              << " ns/call (total " << total << ")" << std::endl;
+}
+
+//Copy heavy pattern : fill a vector with copies of one pointer, then drop it
+template <typename Pointer>
+void run_copy_benchmark(const std::string& label, const Pointer& pointer){
+    const size_t copies {10'000'000};
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<Pointer> many(copies, pointer);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "  " << label << " : "
+              << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms for " << copies << " copies" << std::endl;
+}
+
+
+int main(){
+
+    //intrusive_ptr : the count is inside the Dog
+    intrusive_ptr<Dog> dog_1 = make_intrusive<Dog>("Dog1");
+    std::cout << "dog_1 use count : " << dog_1.use_count() << std::endl; // 1
+    {
+        intrusive_ptr<Dog> dog_2 = dog_1;
+        std::cout << "dog_1 use count : " << dog_1.use_count() << std::endl; // 2
+
+        //A raw pointer can be turned back into an owner : the count is in the object
+        Dog* raw = dog_2.get();
+        intrusive_ptr<Dog> dog_3(raw);
+        std::cout << "dog_1 use count : " << dog_1.use_count() << std::endl; // 3
+    }
+    std::cout << "dog_1 use count : " << dog_1.use_count() << std::endl; // 1
+
+    //Weak references
+    intrusive_weak_ptr<Dog> weak_dog(dog_1);
+    if(auto locked = weak_dog.lock())
+        std::cout << "Locked weak dog : " << locked->get_name() << std::endl;
+    dog_1.reset(); // Dog1 destroyed here
+    std::cout << "weak_dog expired : " << std::boolalpha << weak_dog.expired() << std::endl;
+
+
+    std::cout << "---------" << std::endl;
+
+    //local_shared_ptr : the Person cycle from the weak_ptr lecture, with
+    //non atomic counts.
+    {
+        local_shared_ptr<Person> person_a = make_local_shared<Person>("Alison");
+        local_shared_ptr<Person> person_b = make_local_shared<Person>("Beth");
+
+        person_a->set_friend(person_b);
+        person_b->set_friend(person_a);
+
+        std::cout << person_a->get_name() << "'s friend : "
+                  << person_a->get_friend()->get_name() << std::endl;
+        std::cout << "person_a use count : " << person_a.use_count() << std::endl; // 1
+    } // Both persons destroyed : weak references don't keep them alive
+
+
+    std::cout << "---------" << std::endl;
+
+    //Benchmark : passing by value. Note : libstdc++ skips the atomic
+    //instructions in std::shared_ptr when the program never started a
+    //thread, so it only shows its real cost in multithreaded programs.
+    std::cout << std::endl;
+    std::cout << "Passing by value : " << std::endl;
+    run_benchmark("std::shared_ptr (make_shared)  ", std::make_shared<Payload>());
+    run_benchmark("intrusive_ptr, atomic count    ", make_intrusive<AtomicPayload>());
+    run_benchmark("intrusive_ptr, local count     ", make_intrusive<LocalPayload>());
+    run_benchmark("local_shared_ptr               ", make_local_shared<Payload>());
+
+    std::cout << "Copying into a vector : " << std::endl;
+    run_copy_benchmark("std::shared_ptr              ", std::make_shared<Payload>());
+    run_copy_benchmark("intrusive_ptr, atomic count  ", make_intrusive<AtomicPayload>());
+    run_copy_benchmark("intrusive_ptr, local count   ", make_intrusive<LocalPayload>());
+    run_copy_benchmark("local_shared_ptr             ", make_local_shared<Payload>());
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef PERSON_H
+#define PERSON_H
+
+
+#include <string>
+#include "local_shared_ptr.h"
+
+class Person
+{
+public:
+    Person() = default;
+    Person(std::string name);
+    ~Person();
+    
+    //Member functions
+    void set_friend(local_shared_ptr<Person> p){
+		//The assignment creates a local_weak_ptr out of p
+        m_friend = p;
+    }
+
+    local_shared_ptr<Person> get_friend() const{
+        return m_friend.lock();
+    }
+
+    std::string get_name() const{
+        return m_name;
+    }
+    
+private : 
+    local_weak_ptr<Person> m_friend; // Initialized to nullptr
+    std::string m_name {"Unnamed"};
+};
+
+
+#endif // PERSON_H
@@ -0,0 +1,84 @@
+#ifndef REF_COUNT_POLICY_H
+#define REF_COUNT_POLICY_H
+
+#include <atomic>
+
+//How reference counts are updated. std::shared_ptr always uses atomic
+//operations, because it can't know whether the object is shared across
+//threads. Our pointers let you pick :
+//  - AtomicPolicy : safe to share across threads, same cost as shared_ptr.
+//  - LocalPolicy : plain integer operations, for objects that never leave
+//    the thread that created them.
+
+struct AtomicPolicy
+{
+    class Count
+    {
+    public:
+        explicit Count(long initial = 0) : m_value(initial){}
+        void increment(){ m_value.fetch_add(1, std::memory_order_relaxed); }
+        //Returns the new value. acq_rel so the thread that destroys the object
+        //sees every write made through the other references.
+        long decrement(){ return m_value.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+        bool increment_if_not_zero(){
+            long value = m_value.load(std::memory_order_relaxed);
+            while(value != 0){
+                if(m_value.compare_exchange_weak(value, value + 1, std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed))
+                    return true;
+            }
+            return false;
+        }
+        long get() const { return m_value.load(std::memory_order_acquire); }
+    private:
+        std::atomic<long> m_value;
+    };
+
+    //Tiny spin lock, only taken when a weak reference is locked or when the
+    //last strong reference goes away while weak references exist.
+    class Guard
+    {
+    public:
+        void lock(){
+            while(m_flag.test_and_set(std::memory_order_acquire)){
+                m_flag.wait(true, std::memory_order_relaxed);
+            }
+        }
+        void unlock(){
+            m_flag.clear(std::memory_order_release);
+            m_flag.notify_one();
+        }
+    private:
+        std::atomic_flag m_flag;
+    };
+};
+
+struct LocalPolicy
+{
+    class Count
+    {
+    public:
+        explicit Count(long initial = 0) : m_value(initial){}
+        void increment(){ ++m_value; }
+        long decrement(){ return --m_value; }
+        bool increment_if_not_zero(){
+            if(m_value == 0)
+                return false;
+            ++m_value;
+            return true;
+        }
+        long get() const { return m_value; }
+    private:
+        long m_value;
+    };
+
+    //Single thread : nothing to protect
+    class Guard
+    {
+    public:
+        void lock(){}
+        void unlock(){}
+    };
+};
+
+#endif // REF_COUNT_POLICY_H
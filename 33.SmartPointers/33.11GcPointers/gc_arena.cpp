@@ -0,0 +1,121 @@
+#include "gc_arena.h"
+
+GcArena::~GcArena()
+{
+    while(m_objects){
+        GcObject* next = m_objects->m_next;
+        delete m_objects;
+        m_objects = next;
+    }
+}
+
+void GcArena::pace_allocation()
+{
+    if(m_work_per_allocation == 0)
+        return;
+    if(m_phase != Phase::idle){
+        step(m_work_per_allocation);
+    }else if(m_allocated_since_cycle >= MIN_TRIGGER &&
+             m_allocated_since_cycle >= m_trigger_ratio * m_live_after_cycle){
+        step(m_work_per_allocation);
+    }
+}
+
+void GcArena::adopt(GcObject* object)
+{
+    //New objects count as reached for the cycle in progress, if any : they
+    //can only be referenced from places the write barrier watches.
+    object->m_arena = this;
+    object->m_mark_epoch = m_epoch;
+    object->m_next = m_objects;
+    m_objects = object;
+    ++m_stats.live_objects;
+    ++m_allocated_since_cycle;
+}
+
+void GcArena::start_cycle()
+{
+    ++m_epoch; // Every existing object is now unreached
+    m_phase = Phase::marking;
+    for(RootLink* root = m_roots.next; root != &m_roots; root = root->next){
+        if(GcObject* target = root->target(root->owner))
+            shade(target);
+    }
+}
+
+size_t GcArena::mark(size_t budget)
+{
+    GcTracer tracer(*this);
+    size_t done {};
+    while(done < budget && !m_gray.empty()){
+        GcObject* object = m_gray.back();
+        m_gray.pop_back();
+        object->trace(tracer);
+        ++done;
+    }
+    if(m_gray.empty()){
+        m_phase = Phase::sweeping;
+        m_sweep_link = &m_objects;
+    }
+    return done;
+}
+
+size_t GcArena::sweep(size_t budget)
+{
+    size_t done {};
+    while(done < budget && *m_sweep_link){
+        GcObject* object = *m_sweep_link;
+        if(object->m_mark_epoch != m_epoch){
+            *m_sweep_link = object->m_next; // Unlink, the link now points to the next one
+            delete object;
+            --m_stats.live_objects;
+            ++m_stats.freed_objects;
+        }else{
+            m_sweep_link = &object->m_next;
+        }
+        ++done;
+    }
+    if(!*m_sweep_link){
+        m_phase = Phase::idle;
+        m_sweep_link = nullptr;
+        ++m_stats.cycles;
+        m_live_after_cycle = m_stats.live_objects;
+        m_allocated_since_cycle = 0;
+    }
+    return done;
+}
+
+bool GcArena::step(size_t budget)
+{
+    if(m_phase == Phase::idle)
+        start_cycle();
+    while(budget > 0 && m_phase != Phase::idle){
+        size_t done = (m_phase == Phase::marking) ? mark(budget) : sweep(budget);
+        budget = (done >= budget) ? 0 : budget - done;
+    }
+    return m_phase == Phase::idle;
+}
+
+void GcArena::collect()
+{
+    //Finish the cycle in progress, then run a complete one : objects that
+    //died during the first cycle may have been reached before they died.
+    if(m_phase != Phase::idle){
+        while(!step(1024)){}
+    }
+    while(!step(1024)){}
+}
+
+void GcArena::link_root(RootLink* root)
+{
+    root->previous = m_roots.previous;
+    root->next = &m_roots;
+    m_roots.previous->next = root;
+    m_roots.previous = root;
+}
+
+void GcArena::unlink_root(RootLink* root)
+{
+    root->previous->next = root->next;
+    root->next->previous = root->previous;
+}
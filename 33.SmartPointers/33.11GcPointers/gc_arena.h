@@ -0,0 +1,269 @@
+#ifndef GC_ARENA_H
+#define GC_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//Tracing garbage collection for object graphs with cycles. Instead of
+//reference counts and weak_ptr bookkeeping, objects live in a GcArena :
+//  - gc_ptr<T> is a plain pointer, no counting. Cycles are fine.
+//  - gc_root<T> marks an entry point into the graph, for example a local
+//    variable. Everything reachable from a root stays alive.
+//  - the arena finds unreachable objects by tracing from the roots, and
+//    frees them. The work is split in small steps (step(budget)), so the
+//    program is never paused for a whole collection.
+//Rules :
+//  - objects derive from GcObject and report their gc_ptr members in trace().
+//  - a gc_ptr that isn't a member of a traced object (a local variable for
+//    example) doesn't keep anything alive : use a gc_root while the arena
+//    may run a step ( any make() call, or an explicit step()).
+//  - destructors of collected objects must not use other collected objects :
+//    they may already be gone.
+//  - an arena and its objects belong to one thread.
+
+class GcArena;
+class GcObject;
+template <typename T> class gc_ptr;
+
+//Passed to GcObject::trace() to report outgoing references
+class GcTracer
+{
+public:
+    explicit GcTracer(GcArena& arena) : m_arena(arena){}
+
+    template <typename T>
+    void visit(const gc_ptr<T>& pointer);
+
+private:
+    GcArena& m_arena;
+};
+
+class GcObject
+{
+    friend class GcArena;
+    friend class GcTracer;
+    template <typename> friend class gc_ptr;
+
+public:
+    GcObject() = default;
+    GcObject(const GcObject&) = delete;
+    GcObject& operator=(const GcObject&) = delete;
+    virtual ~GcObject() = default;
+
+    //Call tracer.visit() on every gc_ptr member
+    virtual void trace(GcTracer& tracer) const = 0;
+
+private:
+    GcArena* m_arena {nullptr};
+    GcObject* m_next {nullptr};    // All objects of the arena, in a list
+    std::uint32_t m_mark_epoch {}; // Equal to the arena's epoch : reached this cycle
+};
+
+
+class GcArena
+{
+    friend class GcTracer;
+    template <typename> friend class gc_ptr;
+    template <typename> friend class gc_root;
+
+public:
+    enum class Phase { idle, marking, sweeping };
+
+    //Statistics about the work done, for tuning the step budget
+    struct Stats
+    {
+        size_t live_objects {};
+        size_t cycles {};
+        size_t freed_objects {};
+    };
+
+    GcArena() = default;
+    GcArena(const GcArena&) = delete;
+    GcArena& operator=(const GcArena&) = delete;
+    ~GcArena(); // Frees every object, reachable or not
+
+    template <typename T, typename... Args>
+    gc_ptr<T> make(Args&&... args);
+
+    //Does about budget units of work (one unit : tracing or sweeping one
+    //object). Starts a new cycle if none is running. Returns true when the
+    //cycle finished during this step.
+    bool step(size_t budget);
+
+    //Runs a whole cycle to the end
+    void collect();
+
+    //Automatic collection : once allocations since the last cycle reach
+    //trigger_ratio times the objects that survived it, start a cycle. Every allocation
+    //during a cycle then does work_per_allocation units of work.
+    void set_pacing(double trigger_ratio, size_t work_per_allocation){
+        m_trigger_ratio = trigger_ratio;
+        m_work_per_allocation = work_per_allocation;
+    }
+
+    Phase phase() const { return m_phase; }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    //Gray : reached but its references aren't traced yet
+    void shade(GcObject* object){
+        if(object->m_mark_epoch != m_epoch){
+            object->m_mark_epoch = m_epoch;
+            m_gray.push_back(object);
+        }
+    }
+
+    //Write barrier : while marking, a reference stored anywhere makes its
+    //target gray. Otherwise an object already traced could gain a reference
+    //to one that never gets reached.
+    void barrier(GcObject* target){
+        if(m_phase == Phase::marking)
+            shade(target);
+    }
+
+    void pace_allocation();
+    void adopt(GcObject* object);
+    void start_cycle();
+    size_t mark(size_t budget);
+    size_t sweep(size_t budget);
+
+    //Roots are kept in an intrusive list
+    struct RootLink
+    {
+        RootLink* previous;
+        RootLink* next;
+        const void* owner;
+        GcObject* (*target)(const void* owner);
+    };
+    void link_root(RootLink* root);
+    void unlink_root(RootLink* root);
+
+private:
+    Phase m_phase {Phase::idle};
+    std::uint32_t m_epoch {1};
+    GcObject* m_objects {nullptr};
+    GcObject** m_sweep_link {nullptr}; // Next link to examine while sweeping
+    std::vector<GcObject*> m_gray;
+    RootLink m_roots {&m_roots, &m_roots, nullptr, nullptr};
+    Stats m_stats;
+    static constexpr size_t MIN_TRIGGER = 1024; // Don't run cycles for tiny heaps
+    size_t m_allocated_since_cycle {};
+    size_t m_live_after_cycle {};
+    double m_trigger_ratio {1.0};
+    size_t m_work_per_allocation {0}; // 0 : no automatic collection
+};
+
+
+//Non owning pointer to an object in a GcArena
+template <typename T>
+class gc_ptr
+{
+    template <typename> friend class gc_ptr;
+
+public:
+    gc_ptr() noexcept = default;
+    gc_ptr(std::nullptr_t) noexcept {}
+
+    gc_ptr(const gc_ptr& source) noexcept
+        : m_pointer(source.m_pointer)
+    {
+        write_barrier();
+    }
+
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    gc_ptr(const gc_ptr<U>& source) noexcept
+        : m_pointer(source.m_pointer)
+    {
+        write_barrier();
+    }
+
+    gc_ptr& operator=(const gc_ptr& source) noexcept{
+        m_pointer = source.m_pointer;
+        write_barrier();
+        return *this;
+    }
+
+    T* get() const noexcept { return m_pointer; }
+    T& operator*() const noexcept { return *m_pointer; }
+    T* operator->() const noexcept { return m_pointer; }
+    explicit operator bool() const noexcept { return m_pointer != nullptr; }
+    bool operator==(const gc_ptr& other) const noexcept = default;
+
+private:
+    friend class GcArena;
+    explicit gc_ptr(T* pointer) noexcept : m_pointer(pointer){}
+
+    void write_barrier() const noexcept{
+        if(m_pointer){
+            const GcObject* object = m_pointer;
+            object->m_arena->barrier(const_cast<GcObject*>(object));
+        }
+    }
+
+private:
+    T* m_pointer {nullptr};
+};
+
+
+//Keeps the object it points to, and everything reachable from it, alive
+template <typename T>
+class gc_root
+{
+public:
+    gc_root(GcArena& arena, gc_ptr<T> pointer = nullptr)
+        : m_arena(arena), m_pointer(pointer)
+    {
+        m_link.owner = this;
+        m_link.target = [](const void* owner) -> GcObject* {
+            return static_cast<const gc_root*>(owner)->m_pointer.get();
+        };
+        m_arena.link_root(&m_link);
+    }
+
+    gc_root(const gc_root& source) : gc_root(source.m_arena, source.m_pointer){}
+
+    gc_root& operator=(const gc_root& source){
+        m_pointer = source.m_pointer; // gc_ptr assignment applies the barrier
+        return *this;
+    }
+
+    gc_root& operator=(gc_ptr<T> pointer){
+        m_pointer = pointer;
+        return *this;
+    }
+
+    ~gc_root(){
+        m_arena.unlink_root(&m_link);
+    }
+
+    const gc_ptr<T>& get() const { return m_pointer; }
+    T* operator->() const { return m_pointer.get(); }
+    T& operator*() const { return *m_pointer; }
+    operator const gc_ptr<T>&() const { return m_pointer; }
+
+private:
+    GcArena& m_arena;
+    GcArena::RootLink m_link;
+    gc_ptr<T> m_pointer;
+};
+
+
+template <typename T>
+void GcTracer::visit(const gc_ptr<T>& pointer){
+    if(pointer)
+        m_arena.shade(const_cast<GcObject*>(static_cast<const GcObject*>(pointer.get())));
+}
+
+template <typename T, typename... Args>
+gc_ptr<T> GcArena::make(Args&&... args){
+    static_assert(std::is_base_of_v<GcObject, T>, "Objects in a GcArena must derive from GcObject");
+    pace_allocation(); // Before the new object exists : it can't be collected by this work
+    T* object = new T(std::forward<Args>(args)...);
+    adopt(object);
+    return gc_ptr<T>(object);
+}
+
+#endif // GC_ARENA_H
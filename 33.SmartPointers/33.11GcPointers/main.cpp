@@ -0,0 +1,185 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include "person.h"
+#include "gc_arena.h"
+
+//Graph nodes for the benchmark : every node is on a big ring, plus one
+//edge to a random node. Lots of cycles.
+struct GcNode : GcObject
+{
+    gc_ptr<GcNode> next;
+    gc_ptr<GcNode> jump;
+    long value {};
+
+    virtual void trace(GcTracer& tracer) const override{
+        tracer.visit(next);
+        tracer.visit(jump);
+    }
+};
+
+//The same graph the std way : a vector owns the nodes, edges are weak_ptrs
+//so the cycles don't leak.
+struct SharedNode
+{
+    std::weak_ptr<SharedNode> next;
+    std::weak_ptr<SharedNode> jump;
+    long value {};
+};
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start){
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+//Runs a cycle in steps of budget units, reporting the longest step
+void incremental_cycle(GcArena& arena, size_t budget, const std::string& label){
+    double longest {};
+    size_t steps {};
+    auto start = Clock::now();
+    bool done {false};
+    while(!done){
+        auto step_start = Clock::now();
+        done = arena.step(budget);
+        longest = std::max(longest, elapsed_ms(step_start));
+        ++steps;
+    }
+    std::cout << "  " << label << " : " << elapsed_ms(start) << " ms in " << steps
+              << " steps, longest pause " << longest * 1000 << " us, live objects "
+              << arena.stats().live_objects << std::endl;
+}
+
+
+int main(){
+
+    //The Person cycle from the weak_ptr lecture, with no weak_ptr at all
+    {
+        GcArena arena;
+        {
+            gc_root<Person> person_a(arena, arena.make<Person>("Alison"));
+            gc_root<Person> person_b(arena, arena.make<Person>("Beth"));
+
+            person_a->set_friend(person_b);
+            person_b->set_friend(person_a);
+
+            std::cout << person_a->get_name() << "'s friend : "
+                      << person_a->get_friend()->get_name() << std::endl;
+
+            arena.collect(); // Both reachable from the roots : nothing freed
+            std::cout << "Live objects after collect : " << arena.stats().live_objects << std::endl;
+        }
+        //Roots gone : the cycle is unreachable
+        std::cout << "Collecting : " << std::endl;
+        arena.collect();
+        std::cout << "Live objects after collect : " << arena.stats().live_objects << std::endl;
+    }
+
+
+    std::cout << "---------" << std::endl;
+
+    const size_t count {1'000'000};
+    const size_t hops {10'000'000};
+    std::mt19937 generator {42};
+    std::uniform_int_distribution<size_t> pick {0, count - 1};
+    std::vector<size_t> jumps(count);
+    for(auto& j : jumps)
+        j = pick(generator);
+
+    std::cout << std::endl;
+    std::cout << "Cyclic graph of " << count << " nodes : " << std::endl;
+
+    {
+        GcArena arena; // No automatic collection while building
+        auto start = Clock::now();
+        //Plain gc_ptrs are fine while building : no collection step can run
+        std::vector<gc_ptr<GcNode>> nodes(count);
+        for(size_t i{}; i < count; ++i){
+            nodes[i] = arena.make<GcNode>();
+            nodes[i]->value = static_cast<long>(i);
+        }
+        for(size_t i{}; i < count; ++i){
+            nodes[i]->next = nodes[(i + 1) % count];
+            nodes[i]->jump = nodes[jumps[i]];
+        }
+        gc_root<GcNode> root(arena, nodes[0]);
+        nodes = {};
+        std::cout << "  gc_ptr build : " << elapsed_ms(start) << " ms" << std::endl;
+
+        start = Clock::now();
+        long sum {};
+        gc_ptr<GcNode> current = root;
+        for(size_t i{}; i < hops; ++i){
+            sum += current->value;
+            current = (i % 2) ? current->jump : current->next;
+        }
+        std::cout << "  gc_ptr traversal : " << elapsed_ms(start) << " ms for " << hops
+                  << " hops (sum " << sum << ")" << std::endl;
+
+        incremental_cycle(arena, 10'000, "gc cycle, graph alive   ");
+        root = nullptr;
+        incremental_cycle(arena, 10'000, "gc cycle, graph dropped ");
+    }
+
+    {
+        auto start = Clock::now();
+        std::vector<std::shared_ptr<SharedNode>> owners(count);
+        for(size_t i{}; i < count; ++i){
+            owners[i] = std::make_shared<SharedNode>();
+            owners[i]->value = static_cast<long>(i);
+        }
+        for(size_t i{}; i < count; ++i){
+            owners[i]->next = owners[(i + 1) % count];
+            owners[i]->jump = owners[jumps[i]];
+        }
+        std::cout << "  shared/weak build : " << elapsed_ms(start) << " ms" << std::endl;
+
+        start = Clock::now();
+        long sum {};
+        std::shared_ptr<SharedNode> current = owners[0];
+        for(size_t i{}; i < hops; ++i){
+            sum += current->value;
+            current = ((i % 2) ? current->jump : current->next).lock();
+        }
+        std::cout << "  shared/weak traversal : " << elapsed_ms(start) << " ms for " << hops
+                  << " hops (sum " << sum << ")" << std::endl;
+
+        current.reset();
+        start = Clock::now();
+        owners = {};
+        std::cout << "  shared/weak teardown (single pause) : " << elapsed_ms(start) << " ms" << std::endl;
+    }
+
+    //Churn : keep replacing edges with fresh nodes, with automatic
+    //collection running in small increments as we allocate.
+    {
+        GcArena arena;
+        arena.set_pacing(1.0, 256);
+        gc_root<GcNode> root(arena, arena.make<GcNode>());
+        gc_root<GcNode> cursor(arena, root.get());
+        double longest {};
+        auto start = Clock::now();
+        for(size_t i{}; i < count * 4; ++i){
+            auto alloc_start = Clock::now();
+            gc_ptr<GcNode> fresh = arena.make<GcNode>();
+            longest = std::max(longest, elapsed_ms(alloc_start));
+            fresh->next = root;
+            if(i % 1000 == 0){
+                root = fresh;     // Keep a few, the rest becomes garbage
+                cursor = fresh;
+            }else{
+                cursor->jump = fresh;
+            }
+        }
+        std::cout << "  churn, " << count * 4 << " allocations : " << elapsed_ms(start)
+                  << " ms, longest allocation pause " << longest * 1000 << " us, "
+                  << arena.stats().cycles << " cycles, live objects "
+                  << arena.stats().live_objects << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef PERSON_H
+#define PERSON_H
+
+
+#include <string>
+#include "gc_arena.h"
+
+class Person : public GcObject
+{
+public:
+    Person() = default;
+    Person(std::string name);
+    ~Person();
+    
+    //Member functions
+    void set_friend(gc_ptr<Person> p){
+		//Plain pointer : no weak_ptr needed to break the cycle
+        m_friend = p;
+    }
+
+    gc_ptr<Person> get_friend() const{
+        return m_friend; // No lock() : the friend is alive as long as we are reachable
+    }
+
+    std::string get_name() const{
+        return m_name;
+    }
+
+    //Tell the collector about our references
+    virtual void trace(GcTracer& tracer) const override{
+        tracer.visit(m_friend);
+    }
+    
+private : 
+    gc_ptr<Person> m_friend; // Initialized to nullptr
+    std::string m_name {"Unnamed"};
+};
+
+
+#endif // PERSON_H
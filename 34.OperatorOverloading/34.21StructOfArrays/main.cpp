@@ -0,0 +1,109 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+#include "point.h"
+#include "point_soa.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Translate and length over a plain array of Points, using the operators
+[[gnu::noinline]] void translate(std::vector<Point>& points, const Point& offset){
+    for(Point& point : points)
+        point = point + offset;
+}
+
+[[gnu::noinline]] void lengths(const std::vector<Point>& points, std::vector<double>& out){
+    for(size_t i{}; i < points.size(); ++i)
+        out[i] = points[i].length();
+}
+
+
+int main(int argc, char** argv){
+
+    PointVector points;
+    points.push_back(Point(10,10));
+    points.push_back(Point(20,20));
+    points.push_back(Point(3,4));
+
+    //Elements come out as Points
+    std::cout << "points[0] : " << static_cast<Point>(points[0]) << std::endl; // (10,10)
+    std::cout << "points[0] + points[1] : " << (points[0] + points[1]) << std::endl; // (30,30)
+    std::cout << "points[2].length() : " << points[2].length() << std::endl; // 5
+
+    //... and write through, like a Point& would
+    ++points[0];
+    std::cout << "After ++points[0] : " << static_cast<Point>(points[0]) << std::endl; // (11,11)
+    Point old = points[1]++;
+    std::cout << "points[1]++ returned : " << old << std::endl; // (20,20)
+    std::cout << "points[1] is now : " << static_cast<Point>(points[1]) << std::endl; // (21,21)
+    points[2] = points[0] + Point(1,1);
+    std::cout << "points[2] = points[0] + Point(1,1) : " << static_cast<Point>(points[2]) << std::endl; // (12,12)
+
+    translate(points, 100, 0);
+    scale(points, 0.5);
+    std::cout << "After translate(100,0) and scale(0.5) : " << std::endl;
+    for(auto point : points)
+        std::cout << "    " << static_cast<Point>(point) << std::endl;
+
+    //The columns themselves
+    std::cout << "x column :";
+    for(double x : points.column<0>())
+        std::cout << " " << x;
+    std::cout << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : array of structs against structure of arrays. Default 10M
+    //points, can be changed from the command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 10'000'000;
+    const int rounds {10};
+    std::cout << std::endl;
+    std::cout << count << " points, " << rounds << " rounds : " << std::endl;
+
+    std::vector<Point> aos;
+    aos.reserve(count);
+    PointVector soa;
+    soa.reserve(count);
+    for(size_t i{}; i < count; ++i){
+        Point point(static_cast<double>(i % 1000), static_cast<double>(i % 777));
+        aos.push_back(point);
+        soa.push_back(point);
+    }
+    std::vector<double> out(count);
+
+    double aos_translate = time_ms([&]{
+        for(int round{}; round < rounds; ++round)
+            translate(aos, Point(1.5, -1.5));
+    });
+    double soa_translate = time_ms([&]{
+        for(int round{}; round < rounds; ++round)
+            translate(soa, 1.5, -1.5);
+    });
+    std::cout << "translate, std::vector<Point> : " << aos_translate << " ms" << std::endl;
+    std::cout << "translate, soa_vector<Point>  : " << soa_translate << " ms" << std::endl;
+
+    double aos_lengths = time_ms([&]{
+        for(int round{}; round < rounds; ++round)
+            lengths(aos, out);
+    });
+    double aos_check = out[count / 2];
+    double soa_lengths = time_ms([&]{
+        for(int round{}; round < rounds; ++round)
+            lengths(soa, out);
+    });
+    std::cout << "lengths, std::vector<Point>   : " << aos_lengths << " ms" << std::endl;
+    std::cout << "lengths, soa_vector<Point>    : " << soa_lengths << " ms" << std::endl;
+    std::cout << "Same results : " << std::boolalpha << (aos_check == out[count / 2]
+              && static_cast<Point>(soa[count / 2]).length() == aos[count / 2].length()) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef POINT_H
+#define POINT_H
+#include <iostream>
+
+template <typename T> struct soa_traits;
+
+
+class Point
+{
+	friend std::ostream& operator<<(std::ostream& os, const Point& p);
+	friend Point operator+(const Point& left , const Point& right);
+	friend void operator++(Point& operand);
+	friend struct soa_traits<Point>; // Lists the members for soa_vector<Point>
+	
+public:
+	Point() = default;
+	Point(double x, double y) : 
+		m_x(x), m_y(y){
+	}
+	~Point() = default;
+
+	double length() const;   // Function to calculate distance from the point(0,0)
+
+private : 
+	double m_x{}; 
+	double m_y{}; 
+};
+Point operator++(Point& operand,int);
+
+
+inline std::ostream& operator<<(std::ostream& os, const Point& p){
+	os << "Point [ x : " << p.m_x << ", y : " << p.m_y << "]";	
+	return os;
+}
+
+inline Point operator+(const Point& left , const Point& right){
+	return Point( left.m_x + right.m_x, left.m_y + right.m_y);
+}
+
+
+#endif // POINT_H
@@ -0,0 +1,49 @@
+#include <cmath>
+#include "point_soa.h"
+
+//At -O2 GCC only vectorizes loops whose trip count it knows, so the columns
+//are walked in blocks of a fixed size, with a scalar loop for the tail.
+static constexpr size_t block_size {8};
+
+//Helper : the same operation over one column
+template <typename Operation>
+static void for_each_value(std::span<double> column, Operation operation){
+    double* values = column.data();
+    const size_t count = column.size();
+    size_t i{};
+    for(; i + block_size <= count; i += block_size){
+        for(size_t j{}; j < block_size; ++j)
+            values[i + j] = operation(values[i + j]);
+    }
+    for(; i < count; ++i)
+        values[i] = operation(values[i]);
+}
+
+void translate(PointVector& points, double dx, double dy){
+    for_each_value(points.column<0>(), [dx](double x){ return x + dx; });
+    for_each_value(points.column<1>(), [dy](double y){ return y + dy; });
+}
+
+void scale(PointVector& points, double factor){
+    for_each_value(points.column<0>(), [factor](double x){ return x * factor; });
+    for_each_value(points.column<1>(), [factor](double y){ return y * factor; });
+}
+
+//The squares and sums are vectorized. std::sqrt stays scalar unless errno
+//reporting is turned off ( -fno-math-errno ).
+void lengths(const PointVector& points, std::span<double> out){
+    const double* x = points.column<0>().data();
+    const double* y = points.column<1>().data();
+    double* result = out.data();
+    const size_t count = points.size();
+    size_t i{};
+    for(; i + block_size <= count; i += block_size){
+        double squares[block_size];
+        for(size_t j{}; j < block_size; ++j)
+            squares[j] = x[i + j] * x[i + j] + y[i + j] * y[i + j];
+        for(size_t j{}; j < block_size; ++j)
+            result[i + j] = std::sqrt(squares[j]);
+    }
+    for(; i < count; ++i)
+        result[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+}
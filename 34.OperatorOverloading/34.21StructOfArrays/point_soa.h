@@ -0,0 +1,51 @@
+#ifndef POINT_SOA_H
+#define POINT_SOA_H
+
+#include <cmath>
+#include <span>
+#include <tuple>
+#include "point.h"
+#include "soa_vector.h"
+
+template <>
+struct soa_traits<Point>
+{
+    static constexpr auto members = std::make_tuple(&Point::m_x, &Point::m_y);
+
+    //What points[i] can do, like a Point& would
+    template <typename Self>
+    struct Methods
+    {
+        double& x() const { return self().template get<0>(); }
+        double& y() const { return self().template get<1>(); }
+
+        double length() const{
+            return std::sqrt(x() * x() + y() * y());
+        }
+
+        const Self& operator++() const{
+            ++x();
+            ++y();
+            return self();
+        }
+
+        Point operator++(int) const{
+            Point old = self();
+            ++self();
+            return old;
+        }
+
+    private:
+        const Self& self() const { return static_cast<const Self&>(*this); }
+    };
+};
+
+using PointVector = soa_vector<Point>;
+
+//Bulk operations, one pass over each column. Each loop reads and writes
+//plain contiguous doubles : the compiler vectorizes them.
+void translate(PointVector& points, double dx, double dy);
+void scale(PointVector& points, double factor);
+void lengths(const PointVector& points, std::span<double> out);
+
+#endif // POINT_SOA_H
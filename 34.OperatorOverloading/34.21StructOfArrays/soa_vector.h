@@ -0,0 +1,180 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+//Structure of arrays storage. A std::vector<Point> stores x,y,x,y,... ; a
+//soa_vector<Point> stores all the x's in one array and all the y's in
+//another. Loops that touch one member of every element then read contiguous
+//doubles, which the compiler can process a full SIMD register at a time.
+//
+//The element type describes its members in a soa_traits specialization :
+//    template <>
+//    struct soa_traits<Point>
+//    {
+//        static constexpr auto members = std::make_tuple(&Point::m_x, &Point::m_y);
+//
+//        //Member functions added to the element proxy, soa_reference<Point>.
+//        //Self is the proxy type, which gives access to get<I>().
+//        template <typename Self>
+//        struct Methods { ... };
+//    };
+//T must be constructible from its members, in that order.
+//See point_soa.h for a complete example.
+template <typename T> struct soa_traits;
+
+template <typename T> class soa_vector;
+
+
+//The type of the member a pointer to data member points to
+template <typename Pointer> struct member_type;
+template <typename Class, typename Field>
+struct member_type<Field Class::*> { using type = Field; };
+
+template <typename Members> struct soa_columns;
+template <typename... Pointers>
+struct soa_columns<std::tuple<Pointers...>>
+{
+    using type = std::tuple<std::vector<typename member_type<Pointers>::type>...>;
+};
+
+
+//Stands for one element of a soa_vector : its members are scattered over
+//the columns, so there is no T object to hand out a reference to.
+//Converts to a T (a copy), can be assigned a T, and gets the member
+//functions of soa_traits<T>::Methods.
+template <typename T>
+class soa_reference : public soa_traits<T>::template Methods<soa_reference<T>>
+{
+public:
+    soa_reference(soa_vector<T>& owner, size_t index)
+        : m_owner(&owner), m_index(index)
+    {
+    }
+    soa_reference(const soa_reference&) = default;
+
+    //Reference to the I'th member of this element
+    template <size_t I>
+    auto& get() const { return m_owner->template column<I>()[m_index]; }
+
+    operator T() const{
+        return gather(std::make_index_sequence<soa_vector<T>::member_count>{});
+    }
+
+    //Assigns through to the element, like assigning to a T&
+    const soa_reference& operator=(const T& value) const{
+        scatter(value, std::make_index_sequence<soa_vector<T>::member_count>{});
+        return *this;
+    }
+    const soa_reference& operator=(const soa_reference& other) const{
+        return *this = static_cast<T>(other);
+    }
+
+    size_t index() const { return m_index; }
+
+private:
+    template <size_t... I>
+    T gather(std::index_sequence<I...>) const{
+        return T(get<I>()...);
+    }
+
+    template <size_t... I>
+    void scatter(const T& value, std::index_sequence<I...>) const{
+        ((get<I>() = value.*std::get<I>(soa_traits<T>::members)), ...);
+    }
+
+private:
+    soa_vector<T>* m_owner;
+    size_t m_index;
+};
+
+
+template <typename T>
+class soa_vector
+{
+    using Members = std::remove_const_t<decltype(soa_traits<T>::members)>;
+    using Columns = typename soa_columns<Members>::type;
+
+public:
+    static constexpr size_t member_count = std::tuple_size_v<Members>;
+
+    //Iterates over elements, handing out soa_reference proxies
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = soa_reference<T>;
+
+        iterator() = default;
+        iterator(soa_vector* owner, size_t index) : m_owner(owner), m_index(index) {}
+
+        reference operator*() const { return reference(*m_owner, m_index); }
+        iterator& operator++() { ++m_index; return *this; }
+        iterator operator++(int) { iterator old = *this; ++m_index; return old; }
+        bool operator==(const iterator& other) const { return m_index == other.m_index; }
+
+    private:
+        soa_vector* m_owner {nullptr};
+        size_t m_index {};
+    };
+
+    soa_vector() = default;
+    explicit soa_vector(size_t count){
+        resize(count);
+    }
+
+    void push_back(const T& value){
+        std::apply([](auto&... column){ (column.emplace_back(), ...); }, m_columns);
+        (*this)[size() - 1] = value;
+    }
+
+    void reserve(size_t count){
+        std::apply([count](auto&... column){ (column.reserve(count), ...); }, m_columns);
+    }
+
+    void resize(size_t count){
+        std::apply([count](auto&... column){ (column.resize(count), ...); }, m_columns);
+    }
+
+    void clear(){
+        std::apply([](auto&... column){ (column.clear(), ...); }, m_columns);
+    }
+
+    size_t size() const { return std::get<0>(m_columns).size(); }
+    bool empty() const { return size() == 0; }
+
+    soa_reference<T> operator[](size_t index){
+        return soa_reference<T>(*this, index);
+    }
+
+    //Const access gives a copy : there is nothing to refer to
+    T operator[](size_t index) const{
+        return static_cast<T>(soa_reference<T>(const_cast<soa_vector&>(*this), index));
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+
+    //All the values of the I'th member, contiguous. Bulk operations work here.
+    template <size_t I>
+    std::span<typename std::tuple_element_t<I, Columns>::value_type> column(){
+        return std::get<I>(m_columns);
+    }
+
+    template <size_t I>
+    std::span<const typename std::tuple_element_t<I, Columns>::value_type> column() const{
+        return std::get<I>(m_columns);
+    }
+
+private:
+    Columns m_columns;
+};
+
+#endif // SOA_VECTOR_H
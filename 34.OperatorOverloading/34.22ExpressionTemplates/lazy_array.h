@@ -0,0 +1,192 @@
+#ifndef LAZY_ARRAY_H
+#define LAZY_ARRAY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+//Expression templates. With whole array operators that return arrays,
+//    result = a + b * c - d;
+//builds two temporary arrays ( b * c, then ... + a ) before the last one is
+//copied into result : three passes over memory and three allocations.
+//Here the operators return small expression objects instead, that only
+//remember what to compute :
+//    minus< plus< lazy_array, multiplies<lazy_array, lazy_array> >, lazy_array >
+//Nothing is computed until the expression is assigned to a lazy_array. The
+//assignment then runs a single loop, computing each element with the
+//element type's own operators :
+//    result[i] = a[i] + b[i] * c[i] - d[i];
+//Expressions hold references to the arrays they use : assign them right
+//away, don't keep them in auto variables past the arrays' lifetime.
+//All the arrays in one expression must have the same size.
+
+//Anything that can be indexed as part of an expression
+template <typename E>
+concept Expression = requires { typename std::remove_cvref_t<E>::is_expression; };
+
+template <typename T> class lazy_array;
+
+//Arrays are stored by reference, sub expressions by value
+template <typename E>
+struct operand_storage { using type = E; };
+template <typename T>
+struct operand_storage<lazy_array<T>> { using type = const lazy_array<T>&; };
+
+template <typename E>
+using operand_storage_t = typename operand_storage<E>::type;
+
+
+//A single value used with every element, as in a * 2
+template <typename T>
+class scalar_expression
+{
+public:
+    using is_expression = void;
+    using value_type = T;
+
+    explicit scalar_expression(const T& value) : m_value(value) {}
+
+    const T& operator[](size_t) const { return m_value; }
+    size_t size() const { return 0; } // Takes the size of the other operand
+
+private:
+    T m_value;
+};
+
+
+template <typename Operation, typename Left, typename Right>
+class binary_expression
+{
+public:
+    using is_expression = void;
+    using value_type = std::remove_cvref_t<decltype(Operation{}(std::declval<Left>()[0],
+                                                                std::declval<Right>()[0]))>;
+
+    binary_expression(const Left& left, const Right& right)
+        : m_left(left), m_right(right)
+    {
+    }
+
+    value_type operator[](size_t index) const{
+        return Operation{}(m_left[index], m_right[index]);
+    }
+
+    size_t size() const { return std::max(m_left.size(), m_right.size()); }
+
+private:
+    operand_storage_t<Left> m_left;
+    operand_storage_t<Right> m_right;
+};
+
+
+template <typename T>
+class lazy_array
+{
+public:
+    using is_expression = void;
+    using value_type = T;
+
+    lazy_array() = default;
+    explicit lazy_array(size_t count, const T& value = T{}) : m_data(count, value) {}
+    lazy_array(std::initializer_list<T> values) : m_data(values) {}
+
+    //Evaluates the expression, in one pass
+    template <Expression E>
+    lazy_array(const E& expression){
+        assign(expression);
+    }
+
+    template <Expression E>
+    lazy_array& operator=(const E& expression){
+        assign(expression);
+        return *this;
+    }
+
+    //Element by element compound operators, also in one pass.
+    //Element i of the expression may only read element i of *this.
+    template <Expression E>
+    lazy_array& operator+=(const E& expression){
+        for(size_t i{}; i < m_data.size(); ++i)
+            m_data[i] = m_data[i] + expression[i];
+        return *this;
+    }
+
+    template <Expression E>
+    lazy_array& operator-=(const E& expression){
+        for(size_t i{}; i < m_data.size(); ++i)
+            m_data[i] = m_data[i] - expression[i];
+        return *this;
+    }
+
+    const T& operator[](size_t index) const { return m_data[index]; }
+    T& operator[](size_t index) { return m_data[index]; }
+    size_t size() const { return m_data.size(); }
+
+    auto begin() const { return m_data.begin(); }
+    auto end() const { return m_data.end(); }
+
+private:
+    template <typename E>
+    void assign(const E& expression){
+        //Writing element i only after reading element i of every operand
+        //makes a = a + b safe : no need for a temporary array.
+        const size_t count = expression.size();
+        m_data.resize(count);
+        T* data = m_data.data();
+        for(size_t i{}; i < count; ++i)
+            data[i] = expression[i];
+    }
+
+private:
+    std::vector<T> m_data;
+};
+
+
+//Scalars on either side get wrapped in a scalar_expression
+template <typename Operation, typename Left, typename Right>
+auto make_expression(const Left& left, const Right& right){
+    if constexpr (Expression<Left> && Expression<Right>)
+        return binary_expression<Operation, Left, Right>(left, right);
+    else if constexpr (Expression<Left>)
+        return binary_expression<Operation, Left, scalar_expression<typename Left::value_type>>(
+            left, scalar_expression<typename Left::value_type>(right));
+    else
+        return binary_expression<Operation, scalar_expression<typename Right::value_type>, Right>(
+            scalar_expression<typename Right::value_type>(left), right);
+}
+
+//At least one side must be an expression; the other one may be a value
+template <typename Left, typename Right>
+    requires Expression<Left> || Expression<Right>
+auto operator+(const Left& left, const Right& right){
+    return make_expression<std::plus<>>(left, right);
+}
+
+template <typename Left, typename Right>
+    requires Expression<Left> || Expression<Right>
+auto operator-(const Left& left, const Right& right){
+    return make_expression<std::minus<>>(left, right);
+}
+
+template <typename Left, typename Right>
+    requires Expression<Left> || Expression<Right>
+auto operator*(const Left& left, const Right& right){
+    return make_expression<std::multiplies<>>(left, right);
+}
+
+template <typename Left, typename Right>
+    requires Expression<Left> || Expression<Right>
+auto operator/(const Left& left, const Right& right){
+    return make_expression<std::divides<>>(left, right);
+}
+
+template <typename Left, typename Right>
+    requires Expression<Left> || Expression<Right>
+auto operator%(const Left& left, const Right& right){
+    return make_expression<std::modulus<>>(left, right);
+}
+
+#endif // LAZY_ARRAY_H
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+#include "point.h"
+#include "number.h"
+#include "lazy_array.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Whole array operators the usual way : each one runs its own loop and
+//returns a new array.
+template <typename T, typename Operation>
+std::vector<T> eager(const std::vector<T>& left, const std::vector<T>& right, Operation operation){
+    std::vector<T> result(left.size());
+    for(size_t i{}; i < left.size(); ++i)
+        result[i] = operation(left[i], right[i]);
+    return result;
+}
+
+template <typename T>
+std::vector<T> operator+(const std::vector<T>& left, const std::vector<T>& right){
+    return eager(left, right, std::plus<>{});
+}
+
+template <typename T>
+std::vector<T> operator-(const std::vector<T>& left, const std::vector<T>& right){
+    return eager(left, right, std::minus<>{});
+}
+
+template <typename T>
+std::vector<T> operator*(const std::vector<T>& left, const std::vector<T>& right){
+    return eager(left, right, std::multiplies<>{});
+}
+
+
+int main(int argc, char** argv){
+
+    lazy_array<Number> a {1, 2, 3, 4};
+    lazy_array<Number> b {10, 20, 30, 40};
+    lazy_array<Number> c {2, 2, 2, 2};
+    lazy_array<Number> d {1, 1, 1, 1};
+
+    //One loop : result[i] = a[i] + b[i] * c[i] - d[i]
+    lazy_array<Number> result = a + b * c - d;
+    for(const Number& n : result)
+        std::cout << n << std::endl; // 20, 41, 62, 83
+
+    //Values mix in : they apply to every element
+    result = (a + 1) * 3 % 4;
+    std::cout << "(a + 1) * 3 % 4 :";
+    for(const Number& n : result)
+        std::cout << " " << n.get_wrapped_int(); // 2 1 0 3
+    std::cout << std::endl;
+
+    //Compound operators from 34.10, fused the same way
+    result += a * a;
+    std::cout << "result += a * a :";
+    for(const Number& n : result)
+        std::cout << " " << n.get_wrapped_int(); // 3 5 9 19
+    std::cout << std::endl;
+
+    //Any element type with the operators works : Points use their own + and -
+    lazy_array<Point> p1 {Point(10,10), Point(20,20)};
+    lazy_array<Point> p2 {Point(1,1), Point(2,2)};
+    lazy_array<Point> p3 = p1 + p2 - Point(5,5);
+    std::cout << p3[0] << std::endl; // (6,6)
+    std::cout << p3[1] << std::endl; // (17,17)
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : a + b * c - d over big arrays. Default 10M elements, can be
+    //changed from the command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 10'000'000;
+    const int rounds {5};
+    std::cout << std::endl;
+    std::cout << "a + b * c - d, " << count << " Numbers, " << rounds << " rounds : " << std::endl;
+
+    {
+        std::vector<Number> ea(count), eb(count), ec(count), ed(count), eresult;
+        lazy_array<Number> la(count), lb(count), lc(count), ld(count), lresult;
+        for(size_t i{}; i < count; ++i){
+            int value = static_cast<int>(i % 1000);
+            ea[i] = la[i] = value;
+            eb[i] = lb[i] = value + 1;
+            ec[i] = lc[i] = 3;
+            ed[i] = ld[i] = value / 2;
+        }
+
+        double eager_time = time_ms([&]{
+            for(int round{}; round < rounds; ++round)
+                eresult = ea + eb * ec - ed;
+        });
+        double lazy_time = time_ms([&]{
+            for(int round{}; round < rounds; ++round)
+                lresult = la + lb * lc - ld;
+        });
+        std::cout << "eager, a temporary array per operator : " << eager_time << " ms" << std::endl;
+        std::cout << "expression templates, one pass        : " << lazy_time << " ms" << std::endl;
+        std::cout << "Same results : " << std::boolalpha
+                  << (eresult[count / 2].get_wrapped_int() == lresult[count / 2].get_wrapped_int()) << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "a + b - c + d, " << count << " Points, " << rounds << " rounds : " << std::endl;
+    {
+        std::vector<Point> ea(count), eb(count), ec(count), ed(count), eresult;
+        lazy_array<Point> la(count), lb(count), lc(count), ld(count), lresult;
+        for(size_t i{}; i < count; ++i){
+            double value = static_cast<double>(i % 1000);
+            ea[i] = la[i] = Point(value, value);
+            eb[i] = lb[i] = Point(1, 2);
+            ec[i] = lc[i] = Point(value / 2, 0);
+            ed[i] = ld[i] = Point(3, 4);
+        }
+
+        double eager_time = time_ms([&]{
+            for(int round{}; round < rounds; ++round)
+                eresult = ea + eb - ec + ed;
+        });
+        double lazy_time = time_ms([&]{
+            for(int round{}; round < rounds; ++round)
+                lresult = la + lb - lc + ld;
+        });
+        std::cout << "eager, a temporary array per operator : " << eager_time << " ms" << std::endl;
+        std::cout << "expression templates, one pass        : " << lazy_time << " ms" << std::endl;
+        std::cout << "Middle element : " << eresult[count / 2] << " / " << lresult[count / 2] << std::endl;
+    }
+
+    return 0;
+}
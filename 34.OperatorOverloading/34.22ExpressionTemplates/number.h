@@ -0,0 +1,54 @@
+#ifndef NUMBER_H
+#define NUMBER_H
+#include <iostream>
+
+//Number from 34.11, with the constructor and the arithmetic operators
+//defined inline : the benchmark should measure temporaries, not calls.
+class Number
+{
+    friend std::ostream& operator<<(std::ostream& out , const Number& number);
+
+    //Arithmetic operators
+    friend Number operator+(const Number& left_operand, const Number& right_operand);
+    friend Number operator-(const Number& left_operand, const Number& right_operand);
+    friend Number operator*(const Number& left_operand, const Number& right_operand);
+    friend Number operator/(const Number& left_operand, const Number& right_operand);
+    friend Number operator%(const Number& left_operand, const Number& right_operand);
+		
+public:
+	Number() = default;
+	Number(int value ) : m_wrapped_int(value){
+	}
+
+    explicit operator double()const{
+        return (static_cast <double> (m_wrapped_int));
+    }
+ 
+    //getter
+    int get_wrapped_int() const{
+        return m_wrapped_int;
+    }
+     
+    ~Number() = default;
+    
+private : 
+    int m_wrapped_int{0};
+};
+
+inline Number operator+(const Number& left_operand, const Number& right_operand){
+ return Number(left_operand.m_wrapped_int + right_operand.m_wrapped_int);    
+}
+inline Number operator-(const Number& left_operand, const Number& right_operand){
+ return Number(left_operand.m_wrapped_int - right_operand.m_wrapped_int);    
+}
+inline Number operator*(const Number& left_operand, const Number& right_operand){
+ return Number(left_operand.m_wrapped_int * right_operand.m_wrapped_int);    
+}
+inline Number operator/(const Number& left_operand, const Number& right_operand){
+ return Number(left_operand.m_wrapped_int / right_operand.m_wrapped_int);    
+}
+inline Number operator%(const Number& left_operand, const Number& right_operand){
+ return Number(left_operand.m_wrapped_int % right_operand.m_wrapped_int);    
+}
+
+#endif // NUMBER_H
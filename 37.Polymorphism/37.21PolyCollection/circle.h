@@ -0,0 +1,23 @@
+#ifndef CIRCLE_H
+#define CIRCLE_H
+#include "oval.h"
+
+class Circle final : public Oval
+{
+public:
+    Circle() = default;
+    Circle(double radius,std::string_view description);
+    ~Circle();
+    
+    virtual void draw() const{
+        std::cout << "Circle::draw() called. Drawing " << m_description <<
+            " with radius : " << get_x_rad() << std::endl;        
+    }
+
+    virtual double area() const override{
+        return 3.14159265358979 * get_x_rad() * get_x_rad();
+    }
+
+};
+
+#endif // CIRCLE_H
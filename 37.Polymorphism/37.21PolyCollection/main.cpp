@@ -0,0 +1,141 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include "shape.h"
+#include "oval.h"
+#include "circle.h"
+#include "poly_collection.h"
+
+using ShapeCollection = poly_collection<Shape, Circle, Oval>;
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//The same random sequence of circles and ovals for every container, so the
+//virtual call targets are as unpredictable as in real data.
+std::vector<bool> make_kinds(size_t count){
+    std::vector<bool> is_circle(count);
+    std::mt19937 generator {42};
+    std::bernoulli_distribution coin {0.5};
+    for(size_t i{}; i < count; ++i)
+        is_circle[i] = coin(generator);
+    return is_circle;
+}
+
+
+int main(int argc, char** argv){
+
+    ShapeCollection shapes;
+    shapes.emplace<Circle>(7.2,"circle1");
+    shapes.emplace<Oval>(13.3,1.2,"Oval1");
+    shapes.emplace<Circle>(11.2,"circle2");
+    shapes.emplace<Oval>(31.3,15.2,"Oval2");
+    shapes.insert(Circle(12.2,"circle3"));
+    shapes.insert(Oval(53.3,9.2,"Oval3"));
+
+    //Segment by segment : all circles, then all ovals
+    std::cout << "Segment order : " << std::endl;
+    shapes.for_each([](const auto& shape){
+        using Exact = std::remove_cvref_t<decltype(shape)>;
+        shape.Exact::draw(); // Qualified call : no virtual dispatch
+    });
+
+    std::cout << std::endl;
+    std::cout << "Insertion order : " << std::endl;
+    shapes.for_each_in_order([](const auto& shape){
+        shape.draw();
+    });
+
+    std::cout << std::endl;
+    std::cout << "Through the base class, shapes[3] : ";
+    shapes[3].draw();
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : sum the areas of many shapes. Default 10M, can be changed
+    //from the command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 10'000'000;
+    std::vector<bool> is_circle = make_kinds(count);
+    std::cout << std::endl;
+    std::cout << "Summing areas of " << count << " shapes : " << std::endl;
+
+    {
+        auto shared_shapes = std::make_unique<std::shared_ptr<Shape>[]>(count);
+        for(size_t i{}; i < count; ++i){
+            if(is_circle[i])
+                shared_shapes[i] = std::make_shared<Circle>(1.0 + i % 7, "");
+            else
+                shared_shapes[i] = std::make_shared<Oval>(1.0 + i % 5, 2.0, "");
+        }
+        double total {};
+        double ms = time_ms([&]{
+            for(size_t i{}; i < count; ++i)
+                total += shared_shapes[i]->area();
+        });
+        std::cout << "  shared_ptr<Shape>[]          : " << ms << " ms (total " << total << ")" << std::endl;
+    }
+
+    {
+        std::vector<std::unique_ptr<Shape>> unique_shapes;
+        unique_shapes.reserve(count);
+        for(size_t i{}; i < count; ++i){
+            if(is_circle[i])
+                unique_shapes.push_back(std::make_unique<Circle>(1.0 + i % 7, ""));
+            else
+                unique_shapes.push_back(std::make_unique<Oval>(1.0 + i % 5, 2.0, ""));
+        }
+        double total {};
+        double ms = time_ms([&]{
+            for(const auto& shape : unique_shapes)
+                total += shape->area();
+        });
+        std::cout << "  vector<unique_ptr<Shape>>    : " << ms << " ms (total " << total << ")" << std::endl;
+    }
+
+    {
+        ShapeCollection collection;
+        collection.reserve_index(count);
+        for(size_t i{}; i < count; ++i){
+            if(is_circle[i])
+                collection.emplace<Circle>(1.0 + i % 7, "");
+            else
+                collection.emplace<Oval>(1.0 + i % 5, 2.0, "");
+        }
+
+        double total {};
+        double ms = time_ms([&]{
+            collection.for_each([&](const Shape& shape){ total += shape.area(); });
+        });
+        std::cout << "  poly_collection, virtual     : " << ms << " ms (total " << total << ")" << std::endl;
+
+        total = 0;
+        ms = time_ms([&]{
+            collection.for_each([&](const auto& shape){
+                using Exact = std::remove_cvref_t<decltype(shape)>;
+                total += shape.Exact::area();
+            });
+        });
+        std::cout << "  poly_collection, devirtual   : " << ms << " ms (total " << total << ")" << std::endl;
+
+        total = 0;
+        ms = time_ms([&]{
+            collection.for_each_in_order([&](const auto& shape){
+                using Exact = std::remove_cvref_t<decltype(shape)>;
+                total += shape.Exact::area();
+            });
+        });
+        std::cout << "  poly_collection, in order    : " << ms << " ms (total " << total << ")" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef OVAL_H
+#define OVAL_H
+#include "shape.h"
+class Oval : public Shape
+{
+public:
+    Oval()= default;
+    Oval(double x_radius, double y_radius,
+                std::string_view description);
+    virtual ~Oval();
+    
+    virtual void draw() const{
+        std::cout << "Oval::draw() called. Drawing " << m_description <<
+            " with m_x_radius : " << m_x_radius << " and m_y_radius : " << m_y_radius 
+                    << std::endl;
+    }
+
+    virtual double area() const override{
+        return 3.14159265358979 * m_x_radius * m_y_radius;
+    }
+
+public:
+    double get_x_rad() const{
+        return m_x_radius;
+    }
+    
+    double get_y_rad() const{
+        return m_y_radius;
+    }
+ 
+private : 
+    double m_x_radius{0.0};
+    double m_y_radius{0.0};
+};
+
+#endif // OVAL_H
@@ -0,0 +1,169 @@
+#ifndef POLY_COLLECTION_H
+#define POLY_COLLECTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//A collection of polymorphic objects that stores them by value. Each
+//concrete type gets its own contiguous segment ( a std::vector<Circle>,
+//a std::vector<Oval>, ...) instead of one heap allocation per object :
+//  - no make_shared, no control block, no reference counting.
+//  - objects of the same type sit next to each other in memory.
+//  - for_each() walks one segment at a time, handing the callback the
+//    exact type. The callback can then call member functions without going
+//    through the vtable :
+//        shapes.for_each([](const auto& shape){
+//            using Exact = std::remove_cvref_t<decltype(shape)>;
+//            shape.Exact::draw(); // Qualified call : no virtual dispatch
+//        });
+//Insertion order is kept in a separate index, for code that needs it.
+//Like std::vector, inserting may invalidate references to stored objects.
+template <typename Base, typename... Types>
+class poly_collection
+{
+    static_assert((std::is_base_of_v<Base, Types> && ...),
+                  "Every stored type must derive from Base");
+    static_assert(sizeof...(Types) <= 255, "Too many types for the insertion index");
+
+public:
+    //Where the i'th inserted object lives
+    struct Location
+    {
+        std::uint8_t type_index;
+        std::uint32_t position; // Index inside that type's segment
+    };
+
+    //Position of T in Types..., at compile time
+    template <typename T>
+    static constexpr size_t index_of(){
+        static_assert((std::is_same_v<T, Types> || ...),
+                      "Type not registered in this poly_collection");
+        size_t index {};
+        ((std::is_same_v<T, Types> ? false : (++index, true)) && ...);
+        return index;
+    }
+
+    //The object goes into its segment first, then into the index. Whatever
+    //throws, every Location in the index points to a real object.
+    template <typename T>
+    T& insert(T object){
+        auto& seg = segment<T>();
+        seg.push_back(std::move(object));
+        add_to_order<T>(seg);
+        return seg.back();
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args){
+        auto& seg = segment<T>();
+        seg.emplace_back(std::forward<Args>(args)...);
+        add_to_order<T>(seg);
+        return seg.back();
+    }
+
+    template <typename T>
+    void reserve(size_t count){
+        segment<T>().reserve(count);
+    }
+
+    void reserve_index(size_t count){
+        m_order.reserve(count);
+    }
+
+    //The segment storing all objects of type T
+    template <typename T>
+    std::vector<T>& segment(){
+        return std::get<std::vector<T>>(m_segments);
+    }
+
+    template <typename T>
+    const std::vector<T>& segment() const{
+        return std::get<std::vector<T>>(m_segments);
+    }
+
+    size_t size() const { return m_order.size(); }
+    bool empty() const { return m_order.empty(); }
+
+    void clear(){
+        std::apply([](auto&... seg){ (seg.clear(), ...); }, m_segments);
+        m_order.clear();
+    }
+
+    //Segment by segment, exact types
+    template <typename Function>
+    void for_each(Function&& function){
+        std::apply([&](auto&... seg){
+            (for_each_in(seg, function), ...);
+        }, m_segments);
+    }
+
+    template <typename Function>
+    void for_each(Function&& function) const{
+        std::apply([&](const auto&... seg){
+            (for_each_in(seg, function), ...);
+        }, m_segments);
+    }
+
+    //Insertion order. Each element still reaches the callback with its
+    //exact type, but the jumps between segments cost locality.
+    template <typename Function>
+    void for_each_in_order(Function&& function) const{
+        for(const Location& location : m_order){
+            visit(location, function);
+        }
+    }
+
+    //Access by insertion index, through the base class
+    const Base& operator[](size_t index) const{
+        const Base* result {nullptr};
+        visit(m_order[index], [&](const Base& object){ result = &object; });
+        return *result;
+    }
+
+    Base& operator[](size_t index){
+        return const_cast<Base&>(std::as_const(*this)[index]);
+    }
+
+    const std::vector<Location>& insertion_order() const { return m_order; }
+
+private:
+    template <typename Segment, typename Function>
+    static void for_each_in(Segment& seg, Function& function){
+        for(auto& object : seg){
+            function(object);
+        }
+    }
+
+    //Calls function with the object a Location points to. The fold expands
+    //to a chain of comparisons, one per type : no function pointers involved.
+    template <typename Function>
+    void visit(const Location& location, Function&& function) const{
+        size_t index {};
+        ((index++ == location.type_index
+            ? (function(std::get<std::vector<Types>>(m_segments)[location.position]), true)
+            : false) || ...);
+    }
+
+    //Records the object just added at the back of seg. If the index can't
+    //grow, the object is taken back out.
+    template <typename T>
+    void add_to_order(std::vector<T>& seg){
+        try{
+            m_order.push_back({static_cast<std::uint8_t>(index_of<T>()),
+                               static_cast<std::uint32_t>(seg.size() - 1)});
+        }catch(...){
+            seg.pop_back();
+            throw;
+        }
+    }
+
+private:
+    std::tuple<std::vector<Types>...> m_segments;
+    std::vector<Location> m_order;
+};
+
+#endif // POLY_COLLECTION_H
@@ -0,0 +1,11 @@
+#include "shape.h"
+
+Shape::Shape(std::string_view description) 
+    : m_description(description)
+{
+}
+
+Shape::~Shape()
+{
+}
+
@@ -0,0 +1,27 @@
+#ifndef SHAPE_H
+#define SHAPE_H
+
+#include <string>
+#include <string_view>
+#include <iostream>
+class Shape
+{
+public:
+    Shape() = default;
+    Shape(std::string_view description);
+    virtual ~Shape();
+    
+     virtual void draw() const{
+        std::cout << "Shape::draw() called. Drawing " << m_description << std::endl;
+    }
+
+    //Cheap virtual function, used to measure dispatch cost without printing
+    virtual double area() const{
+        return 0.0;
+    }
+    
+protected : 
+    std::string m_description{""};
+};
+
+#endif // SHAPE_H
@@ -0,0 +1,8 @@
+#include "animal.h"
+
+Animal::Animal(const std::string& description)
+    : m_description(description)
+{
+}
+
+
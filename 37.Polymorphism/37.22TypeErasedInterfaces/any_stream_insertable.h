@@ -0,0 +1,48 @@
+#ifndef ANY_STREAM_INSERTABLE_H
+#define ANY_STREAM_INSERTABLE_H
+
+#include <iostream>
+#include "poly.h"
+
+//The StreamInsertable interface, as a poly Interface instead of an abstract
+//base class. Any type with a stream_insert(std::ostream&) const member
+//function, or an operator<<, can be stored : Animal and friends, but also
+//types that don't inherit from anything.
+struct StreamInsertableInterface
+{
+    struct VTable
+    {
+        void (*stream_insert)(const void* self, std::ostream& out);
+    };
+
+    template <typename T>
+    static constexpr VTable vtable_for {
+        [](const void* self, std::ostream& out){
+            const T& object = *static_cast<const T*>(self);
+            if constexpr (requires { object.stream_insert(out); })
+                object.stream_insert(out);
+            else
+                out << object;
+        }
+    };
+
+    template <typename Self>
+    struct Methods
+    {
+        void stream_insert(std::ostream& out) const{
+            const Self& self = static_cast<const Self&>(*this);
+            self.vtable().stream_insert(self.object(), out);
+        }
+    };
+};
+
+//80 bytes of inline storage : enough for the Animal hierarchy (a vptr and
+//two std::strings), so none of the demo types needs the heap.
+using any_stream_insertable = poly<StreamInsertableInterface, 80>;
+
+inline std::ostream& operator<<(std::ostream& out, const any_stream_insertable& operand){
+    operand.stream_insert(out);
+    return out;
+}
+
+#endif // ANY_STREAM_INSERTABLE_H
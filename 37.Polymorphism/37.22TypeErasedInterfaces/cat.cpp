@@ -0,0 +1,8 @@
+#include "cat.h"
+
+Cat::Cat(const std::string& fur_style, const std::string& description)
+    : Feline(fur_style, description)
+{
+}
+
+
@@ -0,0 +1,172 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <streambuf>
+#include "stream_insertable.h"
+#include "animal.h"
+#include "feline.h"
+#include "dog.h"
+#include "cat.h"
+#include "bird.h"
+#include "pigeon.h"
+#include "crow.h"
+#include "any_stream_insertable.h"
+
+//Doesn't inherit from StreamInsertable : it just has the right member function
+class Point{
+public : 
+    Point() = default;
+    Point(double x , double y)
+        : m_x(x), m_y(y)
+    {
+    }
+
+    void stream_insert(std::ostream& out)const{
+        out << "Point [x: " << m_x << ",y: " << m_y << "]";
+    }
+
+private : 
+    double m_x{};
+    double m_y{};
+};
+
+//Small event records, the kind of objects we hold by the million. The
+//ClickEvent versions inherit the interface, for the pointer based benchmark.
+struct LoginEvent
+{
+    int user_id;
+};
+
+std::ostream& operator<<(std::ostream& out, const LoginEvent& event){
+    out << "Login [" << event.user_id << "]";
+    return out;
+}
+
+class ClickEvent : public StreamInsertable
+{
+public:
+    ClickEvent(int x, int y) : m_x(x), m_y(y){}
+    virtual void stream_insert(std::ostream& out)const override{
+        out << "Click [" << m_x << "," << m_y << "]";
+    }
+private:
+    int m_x;
+    int m_y;
+};
+
+class LoginEventObject : public StreamInsertable
+{
+public:
+    LoginEventObject(int user_id) : m_user_id(user_id){}
+    virtual void stream_insert(std::ostream& out)const override{
+        out << "Login [" << m_user_id << "]";
+    }
+private:
+    int m_user_id;
+};
+
+
+//Stream buffer that only counts characters : we want to measure the
+//dispatch and object layout, not the terminal.
+class CountingBuffer : public std::streambuf
+{
+public:
+    size_t count() const { return m_count; }
+protected:
+    virtual int_type overflow(int_type ch) override{
+        ++m_count;
+        return ch;
+    }
+    virtual std::streamsize xsputn(const char*, std::streamsize n) override{
+        m_count += static_cast<size_t>(n);
+        return n;
+    }
+private:
+    size_t m_count{};
+};
+
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+int main(){
+
+    //Value semantics : no make_shared, no pointers
+    std::vector<any_stream_insertable> things;
+    things.push_back(Dog("stripes","dog2"));
+    things.push_back(Cat("black stripes","cat2"));
+    things.push_back(Crow("black wings","crow2"));
+    things.push_back(Pigeon("white wings","pigeon2"));
+    things.push_back(Point(10,20));
+    things.push_back(LoginEvent{42});
+
+    std::cout << "Printing out things : " << std::endl;
+    for(const auto& thing : things){
+        std::cout << thing << " (inline : " << std::boolalpha << thing.stored_inline() << ")" << std::endl;
+    }
+
+    //Copies are real copies, like any value
+    any_stream_insertable copy = things[0];
+    copy = Pigeon("grey wings","pigeon3");
+    std::cout << "things[0] : " << things[0] << ", copy : " << copy << std::endl;
+
+    std::cout << "sizeof(any_stream_insertable) : " << sizeof(any_stream_insertable) << std::endl;
+
+
+    std::cout << "--------------" << std::endl;
+
+    //Benchmark : a million heterogeneous events, built and streamed
+    const size_t count {1'000'000};
+    CountingBuffer buffer;
+    std::ostream sink(&buffer);
+
+    std::cout << std::endl;
+    std::cout << "Building and streaming " << count << " events : " << std::endl;
+    {
+        std::vector<std::shared_ptr<StreamInsertable>> events;
+        double build = time_ms([&]{
+            events.reserve(count);
+            for(size_t i{}; i < count; ++i){
+                if(i % 2)
+                    events.push_back(std::make_shared<ClickEvent>(static_cast<int>(i), 2));
+                else
+                    events.push_back(std::make_shared<LoginEventObject>(static_cast<int>(i)));
+            }
+        });
+        double stream = time_ms([&]{
+            for(const auto& event : events)
+                sink << *event;
+        });
+        double destroy = time_ms([&]{ events = {}; });
+        std::cout << "  vector<shared_ptr<StreamInsertable>> build : " << build
+                  << " ms, stream : " << stream << " ms, destroy : " << destroy << " ms" << std::endl;
+    }
+    {
+        std::vector<any_stream_insertable> events;
+        double build = time_ms([&]{
+            events.reserve(count);
+            for(size_t i{}; i < count; ++i){
+                if(i % 2)
+                    events.push_back(ClickEvent(static_cast<int>(i), 2));
+                else
+                    events.push_back(LoginEvent{static_cast<int>(i)});
+            }
+        });
+        double stream = time_ms([&]{
+            for(const auto& event : events)
+                sink << event;
+        });
+        double destroy = time_ms([&]{ events = {}; });
+        std::cout << "  vector<any_stream_insertable>        build : " << build
+                  << " ms, stream : " << stream << " ms, destroy : " << destroy << " ms" << std::endl;
+    }
+    std::cout << "  characters written : " << buffer.count() << std::endl;
+
+    return 0;
+}
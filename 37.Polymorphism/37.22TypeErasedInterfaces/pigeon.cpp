@@ -0,0 +1,8 @@
+#include "pigeon.h"
+
+Pigeon::Pigeon(const std::string& wing_color, const std::string& description)
+    : Bird(wing_color,description)
+{
+}
+
+
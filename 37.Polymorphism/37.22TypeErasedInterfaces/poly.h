@@ -0,0 +1,159 @@
+#ifndef POLY_H
+#define POLY_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//Runtime polymorphism with value semantics. A poly<Interface> holds any
+//object that satisfies Interface, by value :
+//  - objects that fit in the inline buffer are stored inside the poly itself,
+//    no heap allocation. Bigger ones go to the heap.
+//  - the dispatch table lives in static storage, one per stored type. The
+//    objects themselves don't need a vptr, nor a common base class.
+//  - a poly can be copied and moved like any value.
+//
+//An Interface is a class that describes the operations to erase :
+//    struct MyInterface
+//    {
+//        struct VTable { ... function pointers taking const void* self ... };
+//
+//        template <typename T>
+//        static constexpr VTable vtable_for { ... cast self to const T* and call ... };
+//
+//        //Member functions added to poly<MyInterface>. Self is the poly type,
+//        //which gives access to object() and vtable().
+//        template <typename Self>
+//        struct Methods { ... };
+//    };
+//See any_stream_insertable.h for a complete example.
+
+//Copy, move and destroy for the stored object, plus the interface functions
+template <typename Interface>
+struct PolyTable
+{
+    void (*copy)(void* dest_buffer, void*& dest_heap, const void* source);
+    void (*move)(void* dest_buffer, void*& dest_heap, void* source_buffer, void*& source_heap) noexcept;
+    void (*destroy)(void* buffer, void* heap) noexcept;
+    typename Interface::VTable interface;
+};
+
+template <typename T, size_t Capacity>
+inline constexpr bool fits_inline_v = sizeof(T) <= Capacity &&
+                                      alignof(T) <= alignof(std::max_align_t) &&
+                                      std::is_nothrow_move_constructible_v<T>;
+
+template <typename Interface, typename T, size_t Capacity>
+inline constexpr PolyTable<Interface> poly_table_for {
+    //copy
+    [](void* dest_buffer, void*& dest_heap, const void* source){
+        if constexpr (fits_inline_v<T, Capacity>)
+            ::new (dest_buffer) T(*static_cast<const T*>(source));
+        else
+            dest_heap = new T(*static_cast<const T*>(source));
+    },
+    //move : inline objects are move constructed, heap objects change owner
+    [](void* dest_buffer, void*& dest_heap, void* source_buffer, void*& source_heap) noexcept{
+        if constexpr (fits_inline_v<T, Capacity>){
+            ::new (dest_buffer) T(std::move(*static_cast<T*>(source_buffer)));
+            static_cast<T*>(source_buffer)->~T();
+        }else{
+            dest_heap = source_heap;
+            source_heap = nullptr;
+        }
+    },
+    //destroy
+    [](void* buffer, void* heap) noexcept{
+        if constexpr (fits_inline_v<T, Capacity>)
+            static_cast<T*>(buffer)->~T();
+        else
+            delete static_cast<T*>(heap);
+    },
+    Interface::template vtable_for<T>
+};
+
+
+template <typename Interface, size_t Capacity = 64>
+class poly : public Interface::template Methods<poly<Interface, Capacity>>
+{
+public:
+    template <typename T,
+              typename D = std::decay_t<T>,
+              typename = std::enable_if_t<!std::is_same_v<D, poly>>>
+    poly(T&& object)
+        : m_table(&poly_table_for<Interface, D, Capacity>)
+    {
+        if constexpr (fits_inline_v<D, Capacity>)
+            ::new (static_cast<void*>(m_buffer)) D(std::forward<T>(object));
+        else
+            m_heap = new D(std::forward<T>(object));
+    }
+
+    poly(const poly& source)
+        : m_table(source.m_table)
+    {
+        m_table->copy(m_buffer, m_heap, source.object());
+    }
+
+    //A moved from poly keeps its type, but the stored object is moved from
+    //(or gone, for heap objects). Only assigning to it or destroying it is valid.
+    poly(poly&& source) noexcept
+        : m_table(source.m_table)
+    {
+        m_table->move(m_buffer, m_heap, source.m_buffer, source.m_heap);
+        source.m_table = &empty_table;
+    }
+
+    poly& operator=(const poly& source){
+        if(this != &source){
+            poly copy(source); // Copying may throw : leave *this intact if it does
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    poly& operator=(poly&& source) noexcept{
+        if(this != &source){
+            m_table->destroy(m_buffer, m_heap);
+            m_table = source.m_table;
+            m_heap = nullptr;
+            m_table->move(m_buffer, m_heap, source.m_buffer, source.m_heap);
+            source.m_table = &empty_table;
+        }
+        return *this;
+    }
+
+    ~poly(){
+        m_table->destroy(m_buffer, m_heap);
+    }
+
+    //Used by Interface::Methods to reach the object and its functions
+    const void* object() const{
+        return m_heap ? m_heap : static_cast<const void*>(m_buffer);
+    }
+    void* object(){
+        return m_heap ? m_heap : static_cast<void*>(m_buffer);
+    }
+    const typename Interface::VTable& vtable() const{
+        return m_table->interface;
+    }
+
+    bool stored_inline() const { return m_heap == nullptr; }
+
+private:
+    //State of a moved from poly : nothing to copy, move or destroy
+    static constexpr PolyTable<Interface> empty_table {
+        [](void*, void*&, const void*){},
+        [](void*, void*&, void*, void*&) noexcept {},
+        [](void*, void*) noexcept {},
+        {}
+    };
+
+private:
+    const PolyTable<Interface>* m_table;
+    void* m_heap {nullptr};
+    alignas(std::max_align_t) unsigned char m_buffer[Capacity];
+};
+
+#endif // POLY_H
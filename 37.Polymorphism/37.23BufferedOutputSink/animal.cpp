@@ -0,0 +1,11 @@
+#include "animal.h"
+
+Animal::Animal(const std::string& description)
+    : m_description(description)
+{
+}
+
+Animal::~Animal()
+{
+}
+
@@ -0,0 +1,266 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include "output_sink.h"
+
+//std::format style formatting into an OutputSink ( GCC 12 has no <format> ) :
+//    print(sink, "Point [x: {},y: {}]\n", x, y);
+//    print(sink, "{:>8.2f} {:x} {:<10}|\n", 3.14159, 255, "left");
+//The format string is checked when the program compiles, like std::format :
+//a wrong number of {} or a spec that doesn't fit its argument, say {:x} on
+//a double, is a compile error. Having been parsed at compile time, the
+//format costs nothing to parse when printing.
+//Replacement fields : {} or {:[<|>][width][.precision][type]}, type being
+//    d  integer, in decimal         x  integer, in hexadecimal
+//    f  fixed   e  scientific       g  general ( floating point )
+//    s  string or bool
+//No type : the natural form, shortest round trip for floating point.
+//Numbers align right by default, everything else left. {{ and }} are
+//literal braces.
+
+//Calling this in a constant expression is what makes the compile error.
+//The compiler prints the call, so the message shows up in the error.
+inline void format_error(const char* /*message*/) {}
+
+enum class ArgumentKind { integer, floating, string, boolean, character, object };
+
+template <typename T>
+constexpr ArgumentKind argument_kind(){
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool>)
+        return ArgumentKind::boolean;
+    else if constexpr (std::is_same_v<U, char>)
+        return ArgumentKind::character;
+    else if constexpr (std::is_integral_v<U>)
+        return ArgumentKind::integer;
+    else if constexpr (std::is_floating_point_v<U>)
+        return ArgumentKind::floating;
+    else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+        return ArgumentKind::string;
+    else
+        return ArgumentKind::object;
+}
+
+struct FormatSpec
+{
+    char align {};          // '<', '>', or 0 for the default
+    unsigned width {};
+    int precision {-1};     // -1 : none
+    char type {};           // 0 for none
+};
+
+//One replacement field, and the literal text before it
+struct FormatField
+{
+    size_t literal_begin;
+    size_t literal_end;
+    FormatSpec spec;
+};
+
+template <typename... Args>
+class basic_format_string
+{
+public:
+    static constexpr size_t FIELD_COUNT {sizeof...(Args)};
+
+    template <typename String>
+        requires std::is_convertible_v<const String&, std::string_view>
+    consteval basic_format_string(const String& text)
+        : m_text(text)
+    {
+        constexpr ArgumentKind kinds[] {argument_kind<Args>()..., ArgumentKind::object};
+        size_t field {};
+        size_t literal_begin {};
+        size_t i {};
+        while(i < m_text.size()){
+            char c = m_text[i];
+            if(c == '}'){
+                if(i + 1 == m_text.size() || m_text[i + 1] != '}')
+                    format_error("single '}' in format string, write '}}'");
+                m_has_escapes = true;
+                i += 2;
+                continue;
+            }
+            if(c != '{'){
+                ++i;
+                continue;
+            }
+            if(i + 1 < m_text.size() && m_text[i + 1] == '{'){
+                m_has_escapes = true;
+                i += 2;
+                continue;
+            }
+            if(field == FIELD_COUNT)
+                format_error("more {} than arguments");
+            FormatField& current = m_fields[field];
+            current.literal_begin = literal_begin;
+            current.literal_end = i;
+            i = parse_spec(i + 1, current.spec, kinds[field]);
+            literal_begin = i;
+            ++field;
+        }
+        if(field != FIELD_COUNT)
+            format_error("fewer {} than arguments");
+        m_tail_begin = literal_begin;
+    }
+
+    std::string_view text() const { return m_text; }
+    const FormatField& field(size_t index) const { return m_fields[index]; }
+    size_t tail_begin() const { return m_tail_begin; }
+    bool has_escapes() const { return m_has_escapes; }
+
+private:
+    //Parses what follows a '{', returns the position after the '}'
+    consteval size_t parse_spec(size_t i, FormatSpec& spec, ArgumentKind kind){
+        auto at = [&](size_t position) { return position < m_text.size() ? m_text[position] : '\0'; };
+        if(at(i) == ':'){
+            ++i;
+            if(at(i) == '<' || at(i) == '>')
+                spec.align = m_text[i++];
+            while(at(i) >= '0' && at(i) <= '9')
+                spec.width = spec.width * 10 + static_cast<unsigned>(m_text[i++] - '0');
+            if(at(i) == '.'){
+                ++i;
+                if(at(i) < '0' || at(i) > '9')
+                    format_error("missing precision after '.'");
+                spec.precision = 0;
+                while(at(i) >= '0' && at(i) <= '9')
+                    spec.precision = spec.precision * 10 + (m_text[i++] - '0');
+                if(kind != ArgumentKind::floating)
+                    format_error("precision is for floating point arguments");
+            }
+            if(at(i) != '}' && at(i) != '\0')
+                spec.type = m_text[i++];
+        }
+        if(at(i) != '}')
+            format_error("unterminated replacement field");
+
+        switch(spec.type){
+            case '\0' :
+                break;
+            case 'd' :
+            case 'x' :
+                if(kind != ArgumentKind::integer)
+                    format_error("d and x are for integer arguments");
+                break;
+            case 'f' :
+            case 'e' :
+            case 'g' :
+                if(kind != ArgumentKind::floating)
+                    format_error("f, e and g are for floating point arguments");
+                break;
+            case 's' :
+                if(kind != ArgumentKind::string && kind != ArgumentKind::boolean)
+                    format_error("s is for string and bool arguments");
+                break;
+            default :
+                format_error("unknown format type");
+        }
+        if(kind == ArgumentKind::object && spec.width)
+            format_error("width is not supported for objects");
+        return i + 1;
+    }
+
+private:
+    std::string_view m_text;
+    std::array<FormatField, FIELD_COUNT> m_fields {};
+    size_t m_tail_begin {};
+    bool m_has_escapes {false};
+};
+
+//type_identity stops the format string from taking part in deducing Args
+template <typename... Args>
+using format_string = basic_format_string<std::type_identity_t<Args>...>;
+
+
+//Literal text, with {{ and }} turned back into single braces
+inline void write_literal(OutputSink& sink, std::string_view text, bool has_escapes){
+    if(!has_escapes){
+        sink.write(text);
+        return;
+    }
+    for(size_t i{}; i < text.size(); ++i){
+        sink.put(text[i]);
+        if((text[i] == '{' || text[i] == '}') && i + 1 < text.size() && text[i + 1] == text[i])
+            ++i;
+    }
+}
+
+//Pads text to the spec's width
+inline void write_aligned(OutputSink& sink, std::string_view text, const FormatSpec& spec, char default_align){
+    size_t padding = (spec.width > text.size()) ? spec.width - text.size() : 0;
+    char align = spec.align ? spec.align : default_align;
+    if(align == '>')
+        for(size_t i{}; i < padding; ++i) sink.put(' ');
+    sink.write(text);
+    if(align == '<')
+        for(size_t i{}; i < padding; ++i) sink.put(' ');
+}
+
+template <typename T>
+void write_argument(OutputSink& sink, const T& value, const FormatSpec& spec){
+    constexpr ArgumentKind kind = argument_kind<T>();
+    if constexpr (kind == ArgumentKind::integer || kind == ArgumentKind::floating){
+        char text[64];
+        std::to_chars_result result;
+        if constexpr (kind == ArgumentKind::integer){
+            result = std::to_chars(text, text + sizeof(text), value, spec.type == 'x' ? 16 : 10);
+        }else{
+            //The shortest round trip form, unless asked for something else
+            std::chars_format format = (spec.type == 'f') ? std::chars_format::fixed
+                                     : (spec.type == 'e') ? std::chars_format::scientific
+                                     : std::chars_format::general;
+            if(spec.precision >= 0)
+                result = std::to_chars(text, text + sizeof(text), value, format, spec.precision);
+            else if(spec.type)
+                result = std::to_chars(text, text + sizeof(text), value, format);
+            else
+                result = std::to_chars(text, text + sizeof(text), value);
+            if(result.ec != std::errc{}){
+                //Huge fixed output, like {:.50f} of 1e300 : fall back to scientific
+                result = std::to_chars(text, text + sizeof(text), value, std::chars_format::scientific);
+            }
+        }
+        std::string_view digits(text, static_cast<size_t>(result.ptr - text));
+        if(spec.width == 0)
+            sink.write(digits);
+        else
+            write_aligned(sink, digits, spec, '>');
+    }else if constexpr (kind == ArgumentKind::string){
+        write_aligned(sink, std::string_view(value), spec, '<');
+    }else if constexpr (kind == ArgumentKind::boolean){
+        write_aligned(sink, value ? "true" : "false", spec, '<');
+    }else if constexpr (kind == ArgumentKind::character){
+        write_aligned(sink, std::string_view(&value, 1), spec, '<');
+    }else{
+        static_assert(SinkWritable<T> || StreamInsertableLike<T>,
+                      "print needs a write_to(OutputSink&) or stream_insert(std::ostream&) member");
+        sink << value;
+    }
+}
+
+template <typename... Args>
+void print(OutputSink& sink, format_string<Args...> format, const Args&... args){
+    std::string_view text = format.text();
+    size_t index {};
+    [[maybe_unused]] auto write_field = [&](const auto& value){
+        const FormatField& field = format.field(index++);
+        write_literal(sink, text.substr(field.literal_begin, field.literal_end - field.literal_begin), format.has_escapes());
+        write_argument(sink, value, field.spec);
+    };
+    (write_field(args), ...);
+    write_literal(sink, text.substr(format.tail_begin()), format.has_escapes());
+}
+
+//Same, into this thread's stdout sink
+template <typename... Args>
+void print(format_string<Args...> format, const Args&... args){
+    print(stdout_sink(), format, args...);
+}
+
+#endif // FORMAT_H
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include "stream_insertable.h"
+#include "animal.h"
+#include "feline.h"
+#include "dog.h"
+#include "cat.h"
+#include "bird.h"
+#include "pigeon.h"
+#include "crow.h"
+#include "output_sink.h"
+#include "format.h"
+
+class Point : public StreamInsertable{
+public : 
+    Point() = default;
+    Point(double x , double y)
+        : m_x(x), m_y(y)
+    {
+    }
+
+    virtual void stream_insert(std::ostream& out)const override{
+        out << "Point [x: " << m_x << ",y: " << m_y << "]";
+    }
+
+    //Fast path, picked by the sink over stream_insert
+    void write_to(OutputSink& sink)const{
+        print(sink, "Point [x: {},y: {}]", m_x, m_y);
+    }
+
+private : 
+    double m_x{};
+    double m_y{};
+};
+
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+int main(int argc, char** argv){
+
+    OutputSink& out = stdout_sink();
+
+    Point p1(10,20);
+    out << "p1 : " << p1 << '\n';
+    //Through the StreamInsertable interface : stream_insert writes into the sink's buffer,
+    //but still formats through std::ostream
+    const StreamInsertable& insertable = p1;
+    out << "p1 as StreamInsertable : " << insertable << '\n';
+
+    std::vector<std::shared_ptr<Animal>> animals {
+        std::make_shared<Dog>("stripes","dog2"),
+        std::make_shared<Cat>("black stripes","cat2"),
+        std::make_shared<Crow>("black wings","crow2"),
+        std::make_shared<Pigeon>("white wings","pigeon2")
+    };
+    for(size_t i{}; i < animals.size(); ++i)
+        print(out, "animals[{}] : {}\n", i, *animals[i]);
+
+    print(out, "{:>10.3f}|{:<6}|{:>6}|{:x}|{:e}|{{braces}}\n", 3.14159265, "left", 42, 255, 0.000123);
+    print(out, "{} {} {} {}\n", true, 'c', 0.1 + 0.2, std::string("string"));
+    //Compile errors, like std::format :
+    //print(out, "{} {}\n", 1);           // fewer {} than arguments
+    //print(out, "{:x}\n", 1.5);          // d and x are for integer arguments
+    //print(out, "{:.2f}\n", "text");     // precision is for floating point arguments
+
+    //Explicit flush point : everything above reaches stdout before std::cout is used
+    out.flush();
+    std::cout << "std::cout after out.flush()" << std::endl;
+
+    //Each thread formats into its own buffer, no locking. A line never gets
+    //split : each thread's text arrives whole, when the thread flushes.
+    {
+        std::vector<std::thread> threads;
+        for(int t{}; t < 3; ++t){
+            threads.emplace_back([t]{
+                OutputSink& thread_out = stdout_sink();
+                for(int i{}; i < 3; ++i)
+                    print(thread_out, "thread {} line {}\n", t, i);
+                thread_out.flush();
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    print(out, "----------\n");
+    out.flush();
+
+    //Benchmark : dumping points to a file, the way the tree does it now, and
+    //through the sink. /dev/null : measure the formatting and the system
+    //calls, not a disk.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 10'000'000;
+    std::vector<Point> points;
+    points.reserve(count);
+    for(size_t i{}; i < count; ++i){
+        //Small values : std::ostream and std::to_chars print them the same way
+        double x = static_cast<double>(i % 1000);
+        points.emplace_back(x, x * 0.5);
+    }
+
+    //writes : calls handing text to the file, each one a system call
+    auto report = [&](const char* name, double ms, std::string writes){
+        print(out, "{:<44} : {:>8.1f} ms, {:>6.2f} M elements/s, writes : {}\n",
+              name, ms, static_cast<double>(count) / ms / 1000.0, writes);
+        out.flush();
+    };
+
+    std::ofstream file_stream("/dev/null");
+    if(!file_stream)
+        throw std::runtime_error("can't open /dev/null");
+    report("std::ofstream, << std::endl", time_ms([&]{
+        for(const auto& point : points)
+            file_stream << point << std::endl;
+    }), std::to_string(count));
+
+    report("std::ofstream, << '\\n'", time_ms([&]{
+        for(const auto& point : points)
+            file_stream << point << '\n';
+        file_stream.flush();
+    }), "one per std::filebuf buffer");
+
+    //stream_insert through the sink only drops the system calls and the
+    //flushes : the numbers still go through std::ostream, which is most of
+    //the time left. Moving the call site to print (or write_to) is what
+    //removes the formatting cost.
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    {
+        OutputSink sink(null_file);
+        double ms = time_ms([&]{
+            for(const auto& point : points)
+                sink << static_cast<const StreamInsertable&>(point) << '\n';
+            sink.flush();
+        });
+        report("OutputSink, StreamInsertable::stream_insert", ms, std::to_string(sink.write_calls()));
+    }
+    {
+        OutputSink sink(null_file);
+        double ms = time_ms([&]{
+            for(const auto& point : points)
+                print(sink, "{}\n", point);
+            sink.flush();
+        });
+        report("OutputSink, print(\"{}\\n\", point)", ms, std::to_string(sink.write_calls()));
+    }
+    std::fclose(null_file);
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "output_sink.h"
+#include <algorithm>
+#include <climits>
+
+OutputSink::OutputSink(std::FILE* file, size_t capacity)
+    : m_file(file)
+{
+    capacity = std::clamp(capacity, MIN_CAPACITY, static_cast<size_t>(INT_MAX));
+    m_buffer.reset(new char[capacity]);
+    setp(m_buffer.get(), m_buffer.get() + capacity);
+}
+
+OutputSink::~OutputSink(){
+    flush();
+}
+
+std::ostream& OutputSink::stream(){
+    //Attached once, for good : stream_insert writes straight at pptr()
+    if(!m_stream)
+        m_stream = std::make_unique<std::ostream>(static_cast<std::streambuf*>(this));
+    return *m_stream;
+}
+
+void OutputSink::flush_buffer(){
+    if(pptr() != pbase()){
+        std::fwrite(pbase(), 1, size(), m_file);
+        ++m_write_calls;
+        setp(pbase(), epptr());
+    }
+}
+
+void OutputSink::flush(){
+    flush_buffer();
+    std::fflush(m_file);
+}
+
+void OutputSink::write_large(std::string_view text){
+    flush_buffer();
+    if(text.size() >= capacity()){
+        //Bigger than the buffer : no point copying it
+        std::fwrite(text.data(), 1, text.size(), m_file);
+        ++m_write_calls;
+        return;
+    }
+    std::memcpy(pptr(), text.data(), text.size());
+    advance(text.size());
+}
+
+OutputSink::int_type OutputSink::overflow(int_type ch){
+    //The buffer is full : give it to the file and start again at the front
+    flush_buffer();
+    if(!traits_type::eq_int_type(ch, traits_type::eof())){
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize OutputSink::xsputn(const char* text, std::streamsize count){
+    write(std::string_view(text, static_cast<size_t>(count)));
+    return count;
+}
+
+OutputSink& stdout_sink(){
+    thread_local OutputSink sink(stdout);
+    return sink;
+}
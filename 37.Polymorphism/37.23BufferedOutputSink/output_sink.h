@@ -0,0 +1,161 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+#include <type_traits>
+
+//std::cout << p << std::endl writes the line, then flushes : one write
+//system call per line, plus the locale and sentry work of every <<.
+//OutputSink collects text in a large buffer and only hands it to the file
+//when the buffer is full, or at the flush points you choose :
+//    OutputSink& out = stdout_sink();
+//    for(const auto& point : points)
+//        print(out, "{}\n", point);
+//    out.flush();
+//Numbers are written with std::to_chars. Objects with a stream_insert
+//(std::ostream&) member, like the StreamInsertable hierarchy, are written
+//through a std::ostream that stays attached to the sink's buffer : no copy,
+//no flush, no per object setup. That only saves the system calls : the
+//ostream still formats the numbers, locale and all. Hot call sites gain
+//the rest by moving to write_to(OutputSink&) or print.
+//The sink is the ostream's std::streambuf, and its put area is the whole
+//buffer : pptr() is where the next byte goes, for the sink's own writes as
+//much as for the ostream's.
+class OutputSink : private std::streambuf
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY {1 << 20};
+    static constexpr size_t MIN_CAPACITY {64}; // Room for any number
+
+    //The sink doesn't own file, and flushes into it when destroyed
+    explicit OutputSink(std::FILE* file, size_t capacity = DEFAULT_CAPACITY);
+    ~OutputSink();
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    void write(std::string_view text){
+        if(text.size() <= free_space()){
+            std::memcpy(pptr(), text.data(), text.size());
+            advance(text.size());
+        }else{
+            write_large(text);
+        }
+    }
+
+    void put(char c){
+        if(pptr() == epptr())
+            flush_buffer();
+        *pptr() = c;
+        pbump(1);
+    }
+
+    //At least count free bytes, for formatting in place. count must not be
+    //more than the capacity.
+    char* reserve(size_t count){
+        if(count > free_space())
+            flush_buffer();
+        return pptr();
+    }
+    void commit(char* end) { advance(static_cast<size_t>(end - pptr())); }
+
+    //Numbers, shortest round trip form for floating point
+    template <typename T>
+        requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>) && (!std::is_same_v<T, char>)
+    void write(T value){
+        constexpr size_t MAX_LENGTH {std::is_floating_point_v<T> ? 32 : 24};
+        char* first = reserve(MAX_LENGTH);
+        commit(std::to_chars(first, first + MAX_LENGTH, value).ptr);
+    }
+
+    //A std::ostream writing into this sink, for stream_insert. Created the
+    //first time it is needed.
+    std::ostream& stream();
+
+    //Writes the buffer to the file, and flushes the file
+    void flush();
+
+    size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+    size_t capacity() const { return static_cast<size_t>(epptr() - pbase()); }
+    size_t write_calls() const { return m_write_calls; } // fwrite calls so far
+
+protected:
+    virtual int_type overflow(int_type ch) override;
+    virtual std::streamsize xsputn(const char* text, std::streamsize count) override;
+
+private:
+    size_t free_space() const { return static_cast<size_t>(epptr() - pptr()); }
+    //pbump takes an int : capacity is kept below INT_MAX
+    void advance(size_t count) { pbump(static_cast<int>(count)); }
+    void flush_buffer();
+    void write_large(std::string_view text);
+
+private:
+    std::FILE* m_file;
+    std::unique_ptr<char[]> m_buffer;
+    size_t m_write_calls {};
+    std::unique_ptr<std::ostream> m_stream;
+};
+
+//This thread's sink to stdout. Each thread has its own buffer, so threads
+//never wait for each other while formatting. A thread's text reaches stdout
+//in blocks, when its buffer fills, when it calls flush(), and when it ends.
+//Mixing it with std::cout : flush() first, or the order is lost.
+OutputSink& stdout_sink();
+
+
+//<< for quick dumps, like an ostream. No std::endl : write '\n', and flush
+//at the end.
+inline OutputSink& operator<<(OutputSink& sink, std::string_view text){
+    sink.write(text);
+    return sink;
+}
+
+inline OutputSink& operator<<(OutputSink& sink, const char* text){
+    sink.write(std::string_view(text));
+    return sink;
+}
+
+inline OutputSink& operator<<(OutputSink& sink, char c){
+    sink.put(c);
+    return sink;
+}
+
+inline OutputSink& operator<<(OutputSink& sink, bool value){
+    sink.write(value ? std::string_view("true") : std::string_view("false"));
+    return sink;
+}
+
+template <typename T>
+    requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>) && (!std::is_same_v<T, char>)
+OutputSink& operator<<(OutputSink& sink, T value){
+    sink.write(value);
+    return sink;
+}
+
+//A type can write itself straight into the sink with a write_to(OutputSink&)
+//member. Otherwise its stream_insert(std::ostream&) is used.
+template <typename T>
+concept SinkWritable = requires (const T& object, OutputSink& sink) { object.write_to(sink); };
+
+template <typename T>
+concept StreamInsertableLike = requires (const T& object, std::ostream& out) { object.stream_insert(out); };
+
+template <typename T>
+    requires SinkWritable<T> || StreamInsertableLike<T>
+OutputSink& operator<<(OutputSink& sink, const T& object){
+    if constexpr (SinkWritable<T>){
+        object.write_to(sink);
+    }else{
+        object.stream_insert(sink.stream());
+    }
+    return sink;
+}
+
+#endif // OUTPUT_SINK_H
@@ -0,0 +1,185 @@
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include "expected.h"
+
+//final : catch_as_expected stores a copy, so nothing may derive from it
+class DivideByZeroException final : public std::exception {
+public :   
+    DivideByZeroException(int a, int b) noexcept : std::exception(),m_a(a),m_b(b){}
+	
+     virtual const char* what() const noexcept override {
+               return"divide by zero detected, dividing ";
+     }
+     
+     int get_a() const{
+         return m_a;
+     }
+     
+     int get_b() const{
+         return m_b;
+     }
+     
+private : 
+     int m_a{};
+     int m_b{};
+    
+};
+
+//Exception version, as in the previous lecture
+[[gnu::noinline]] int divide( int a, int b){
+    
+    if(b==0)
+        throw DivideByZeroException(a,b);
+        
+    return a/b;
+}
+
+//Error code version : a small value describing what went wrong
+enum class MathError { divide_by_zero, negative_input };
+
+const char* to_string(MathError error){
+    switch(error){
+        case MathError::divide_by_zero : return "divide by zero";
+        case MathError::negative_input : return "negative input";
+    }
+    return "unknown error";
+}
+
+[[gnu::noinline]] expected<int, MathError> checked_divide(int a, int b){
+    if(b == 0)
+        return unexpected(MathError::divide_by_zero);
+    return a/b;
+}
+
+expected<int, MathError> checked_sqrt(int value){
+    if(value < 0)
+        return unexpected(MathError::negative_input);
+    int root {};
+    while((root + 1) * (root + 1) <= value)
+        ++root;
+    return root;
+}
+
+//TRY : errors go back to the caller, values get names
+expected<int, MathError> root_of_quotient(int a, int b){
+    TRY(quotient, checked_divide(a, b));
+    TRY(root, checked_sqrt(quotient));
+    return root;
+}
+
+
+int main(){
+
+    //Basic use
+    auto result = checked_divide(10, 0);
+    if(!result)
+        std::cout << "checked_divide(10,0) failed : " << to_string(result.error()) << std::endl;
+    std::cout << "checked_divide(10,2) : " << *checked_divide(10, 2) << std::endl;
+    std::cout << "checked_divide(10,0).value_or(-1) : "
+              << checked_divide(10, 0).value_or(-1) << std::endl;
+
+    std::cout << "--------" << std::endl;
+
+    //Chaining
+    auto describe = [](int a, int b){
+        return checked_divide(a, b)
+            .and_then(checked_sqrt)
+            .transform([](int root){ return "root : " + std::to_string(root); })
+            .or_else([](MathError error) -> expected<std::string, MathError> {
+                return std::string("recovered from ") + to_string(error);
+            });
+    };
+    std::cout << "100 / 4 : " << *describe(100, 4) << std::endl;
+    std::cout << "100 / 0 : " << *describe(100, 0) << std::endl;
+    std::cout << "-100 / 4 : " << *describe(-100, 4) << std::endl;
+
+    auto via_try = root_of_quotient(81, 0);
+    std::cout << "root_of_quotient(81,0) : " << (via_try ? "ok" : to_string(via_try.error())) << std::endl;
+
+    std::cout << "--------" << std::endl;
+
+    //Converting at API boundaries
+    auto caught = catch_as_expected<DivideByZeroException>([]{ return divide(10, 0); });
+    if(!caught)
+        std::cout << "Exception turned into an error : " << caught.error().what()
+                  << caught.error().get_a() << " by " << caught.error().get_b() << std::endl;
+
+    try{
+        value_or_throw(checked_divide(7, 0), [](MathError){
+            return DivideByZeroException(7, 0);
+        });
+    }catch(const DivideByZeroException& ex){
+        std::cout << "Error turned into an exception : " << ex.what() << std::endl;
+    }
+
+    //Operations with nothing to return : expected<void, E>
+    auto check_divisor = [](int b) -> expected<void, MathError> {
+        if(b == 0)
+            return unexpected(MathError::divide_by_zero);
+        return {};
+    };
+    auto checked = check_divisor(0)
+        .transform([]{ return std::string("divisor ok"); })
+        .transform_error([](MathError error){ return std::string(to_string(error)); });
+    std::cout << "check_divisor(0) : " << (checked ? *checked : checked.error()) << std::endl;
+    try{
+        value_or_throw(check_divisor(0), [](MathError){ return DivideByZeroException(7, 0); });
+    }catch(const DivideByZeroException& ex){
+        std::cout << "Void error turned into an exception : " << ex.what() << std::endl;
+    }
+
+    try{
+        checked_divide(7, 0).value();
+    }catch(const bad_expected_access<MathError>& ex){
+        std::cout << "value() on an error : " << to_string(ex.error()) << std::endl;
+    }
+
+    std::cout << "--------" << std::endl;
+
+    //Benchmark : throw/catch versus expected, for several failure rates
+    const size_t calls {2'000'000};
+    std::cout << std::endl;
+    std::cout << "Cost per call (ns), " << calls << " calls : " << std::endl;
+    for(double failure_rate : {0.0, 0.01, 0.05, 0.2, 0.5}){
+        std::vector<int> divisors(calls);
+        std::mt19937 generator {42};
+        std::bernoulli_distribution fails {failure_rate};
+        for(auto& d : divisors)
+            d = fails(generator) ? 0 : 3;
+
+        long throw_sum {};
+        size_t throw_failures {};
+        auto start = std::chrono::steady_clock::now();
+        for(int d : divisors){
+            try{
+                throw_sum += divide(1000, d);
+            }catch(const DivideByZeroException&){
+                ++throw_failures;
+            }
+        }
+        auto mid = std::chrono::steady_clock::now();
+        long expected_sum {};
+        size_t expected_failures {};
+        for(int d : divisors){
+            auto quotient = checked_divide(1000, d);
+            if(quotient)
+                expected_sum += *quotient;
+            else
+                ++expected_failures;
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "  failure rate " << failure_rate * 100 << "% : throw "
+                  << std::chrono::duration<double, std::nano>(mid - start).count() / calls
+                  << ", expected "
+                  << std::chrono::duration<double, std::nano>(end - mid).count() / calls
+                  << " (failures " << throw_failures << " / " << expected_failures
+                  << (throw_sum == expected_sum ? ", same sums" : ", SUMS DIFFER") << ")" << std::endl;
+    }
+
+    return 0;
+}
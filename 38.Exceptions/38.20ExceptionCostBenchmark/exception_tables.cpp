@@ -0,0 +1,193 @@
+#include "exception_tables.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+
+//Provided by libgcc, not declared in any public header
+struct dwarf_eh_bases
+{
+    void* tbase;
+    void* dbase;
+    void* func;
+};
+extern "C" const void* _Unwind_Find_FDE(void* pc, dwarf_eh_bases* bases);
+
+namespace{
+
+//DW_EH_PE pointer encodings
+constexpr std::uint8_t DW_EH_PE_omit = 0xff;
+constexpr std::uint8_t DW_EH_PE_indirect = 0x80;
+
+std::uint64_t read_uleb128(const std::uint8_t*& p){
+    std::uint64_t result {};
+    unsigned shift {};
+    std::uint8_t byte;
+    do{
+        byte = *p++;
+        result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+    }while(byte & 0x80);
+    return result;
+}
+
+std::int64_t read_sleb128(const std::uint8_t*& p){
+    std::int64_t result {};
+    unsigned shift {};
+    std::uint8_t byte;
+    do{
+        byte = *p++;
+        result |= static_cast<std::int64_t>(byte & 0x7f) << shift;
+        shift += 7;
+    }while(byte & 0x80);
+    if(shift < 64 && (byte & 0x40))
+        result |= -(static_cast<std::int64_t>(1) << shift);
+    return result;
+}
+
+template <typename T>
+T read_raw(const std::uint8_t*& p){
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+//Reads a pointer in the given encoding. apply_base = false reads the raw
+//value, for lengths and offsets that use the encoding's format only.
+std::uint64_t read_encoded(std::uint8_t encoding, const std::uint8_t*& p,
+                                const dwarf_eh_bases& bases, bool apply_base = true){
+    const std::uint8_t* field = p;
+    std::uint64_t value {};
+    switch(encoding & 0x0f){
+        case 0x00 : value = read_raw<std::uint64_t>(p); break; // absptr (64 bit targets)
+        case 0x01 : value = read_uleb128(p); break;
+        case 0x02 : value = read_raw<std::uint16_t>(p); break;
+        case 0x03 : value = read_raw<std::uint32_t>(p); break;
+        case 0x04 : value = read_raw<std::uint64_t>(p); break;
+        case 0x09 : value = static_cast<std::uint64_t>(read_sleb128(p)); break;
+        case 0x0a : value = static_cast<std::uint64_t>(read_raw<std::int16_t>(p)); break;
+        case 0x0b : value = static_cast<std::uint64_t>(read_raw<std::int32_t>(p)); break;
+        case 0x0c : value = static_cast<std::uint64_t>(read_raw<std::int64_t>(p)); break;
+    }
+    if(!apply_base || value == 0)
+        return value;
+    switch(encoding & 0x70){
+        case 0x10 : value += reinterpret_cast<std::uintptr_t>(field); break;              // pcrel
+        case 0x20 : value += reinterpret_cast<std::uintptr_t>(bases.tbase); break;        // textrel
+        case 0x30 : value += reinterpret_cast<std::uintptr_t>(bases.dbase); break;        // datarel
+        case 0x40 : value += reinterpret_cast<std::uintptr_t>(bases.func); break;         // funcrel
+    }
+    if(encoding & DW_EH_PE_indirect)
+        value = *reinterpret_cast<const std::uint64_t*>(value);
+    return value;
+}
+
+//What the CIE tells us about how its FDEs are encoded
+struct CieInfo
+{
+    bool has_augmentation_data {false};
+    std::uint8_t fde_encoding {0x00};
+    std::uint8_t lsda_encoding {DW_EH_PE_omit};
+};
+
+CieInfo parse_cie(const std::uint8_t* cie, const dwarf_eh_bases& bases){
+    CieInfo info;
+    const std::uint8_t* p = cie;
+    std::uint32_t length = read_raw<std::uint32_t>(p);
+    if(length == 0xffffffff)
+        p += 8; // 64 bit DWARF length
+    p += 4;     // CIE id
+    std::uint8_t version = *p++;
+    const char* augmentation = reinterpret_cast<const char*>(p);
+    p += std::strlen(augmentation) + 1;
+    read_uleb128(p); // Code alignment
+    read_sleb128(p); // Data alignment
+    if(version == 1)
+        ++p;             // Return address register
+    else
+        read_uleb128(p);
+
+    if(augmentation[0] != 'z')
+        return info;
+    info.has_augmentation_data = true;
+    read_uleb128(p); // Augmentation data length
+    for(const char* a = augmentation + 1; *a; ++a){
+        switch(*a){
+            case 'P' : {
+                std::uint8_t encoding = *p++;
+                read_encoded(encoding & ~DW_EH_PE_indirect, p, bases, false); // Personality
+                break;
+            }
+            case 'L' : info.lsda_encoding = *p++; break;
+            case 'R' : info.fde_encoding = *p++; break;
+            default : break; // 'S', 'B' : no data
+        }
+    }
+    return info;
+}
+
+} // namespace
+
+ExceptionTableInfo inspect_function(const void* function){
+    ExceptionTableInfo info;
+    dwarf_eh_bases bases {};
+    auto fde = static_cast<const std::uint8_t*>(
+        _Unwind_Find_FDE(const_cast<void*>(function), &bases));
+    if(!fde)
+        return info;
+
+    //FDE : length, offset back to its CIE, pc begin, pc range, augmentation
+    const std::uint8_t* p = fde;
+    std::uint32_t length = read_raw<std::uint32_t>(p);
+    if(length == 0xffffffff)
+        p += 8;
+    const std::uint8_t* cie_pointer_field = p;
+    std::uint32_t cie_offset = read_raw<std::uint32_t>(p);
+    CieInfo cie = parse_cie(cie_pointer_field - cie_offset, bases);
+
+    std::uint64_t pc_begin = read_encoded(cie.fde_encoding, p, bases);
+    std::uint64_t pc_range = read_encoded(cie.fde_encoding & 0x0f, p, bases, false);
+    info.found = true;
+    info.code_bytes = static_cast<size_t>(pc_range);
+
+    if(!cie.has_augmentation_data || cie.lsda_encoding == DW_EH_PE_omit)
+        return info;
+    read_uleb128(p); // Augmentation data length
+    std::uint64_t lsda_address = read_encoded(cie.lsda_encoding, p, bases);
+    if(lsda_address == 0)
+        return info;
+    info.has_lsda = true;
+
+    //LSDA header, then the call site table
+    const std::uint8_t* lsda = reinterpret_cast<const std::uint8_t*>(lsda_address);
+    dwarf_eh_bases function_bases = bases;
+    function_bases.func = reinterpret_cast<void*>(pc_begin);
+    std::uint8_t lpstart_encoding = *lsda++;
+    if(lpstart_encoding != DW_EH_PE_omit)
+        read_encoded(lpstart_encoding, lsda, function_bases);
+    std::uint8_t ttype_encoding = *lsda++;
+    if(ttype_encoding != DW_EH_PE_omit)
+        read_uleb128(lsda);
+    std::uint8_t call_site_encoding = *lsda++;
+    std::uint64_t table_length = read_uleb128(lsda);
+    const std::uint8_t* table_end = lsda + table_length;
+    while(lsda < table_end){
+        read_encoded(call_site_encoding, lsda, function_bases, false); // Start
+        read_encoded(call_site_encoding, lsda, function_bases, false); // Length
+        std::uint64_t landing_pad = read_encoded(call_site_encoding, lsda, function_bases, false);
+        read_uleb128(lsda);                                            // Action
+        ++info.call_sites;
+        if(landing_pad != 0)
+            ++info.landing_pads;
+    }
+    return info;
+}
+
+#else
+
+ExceptionTableInfo inspect_function(const void*){
+    return {};
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef EXCEPTION_TABLES_H
+#define EXCEPTION_TABLES_H
+
+#include <cstddef>
+
+//Looks at the unwind information the compiler generated for a function :
+//how big its code is, and whether it has landing pads ( code that runs when
+//an exception goes through the function : destructor calls, catch blocks).
+//A noexcept hot function is expected to have none. If one shows up, someone
+//added a try block or a throwing call with cleanup, and the function pays
+//for it in code size and layout.
+//Reads the DWARF .eh_frame / .gcc_except_table data, so it only works with
+//GCC or Clang on ELF platforms (Linux). Elsewhere, found stays false.
+
+struct ExceptionTableInfo
+{
+    bool found {false};        // Unwind information located for the function
+    size_t code_bytes {};      // Size of the function's machine code
+    bool has_lsda {false};     // Has a language specific data area (exception table)
+    size_t call_sites {};      // Entries in the call site table
+    size_t landing_pads {};    // Call sites that lead to a landing pad
+};
+
+ExceptionTableInfo inspect_function(const void* function);
+
+template <typename Function>
+ExceptionTableInfo inspect_function(Function* function){
+    return inspect_function(reinterpret_cast<const void*>(function));
+}
+
+#endif // EXCEPTION_TABLES_H
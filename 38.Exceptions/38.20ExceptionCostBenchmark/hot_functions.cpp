@@ -0,0 +1,71 @@
+#include "hot_functions.h"
+#include "exceptions.h"
+
+//Opaque to the optimizer : the object is destroyed through a volatile
+//counter, so the destructor can't be removed.
+static volatile int live_resources {};
+
+Resource::Resource(int id) : m_id(id)
+{
+    live_resources = live_resources + 1;
+}
+
+Resource::~Resource()
+{
+    live_resources = live_resources - 1;
+}
+
+void may_throw(int value){
+    if(value < 0)
+        throw Warning("negative value");
+}
+
+long sum_values(const long* values, size_t count) noexcept{
+    long sum {};
+    for(size_t i{}; i < count; ++i)
+        sum += values[i];
+    return sum;
+}
+
+size_t count_words(std::string_view text) noexcept{
+    size_t words {};
+    bool in_word {false};
+    for(char c : text){
+        bool letter = (c != ' ' && c != '\n' && c != '\t');
+        if(letter && !in_word)
+            ++words;
+        in_word = letter;
+    }
+    return words;
+}
+
+//If may_throw() throws, resource must be destroyed on the way out :
+//the compiler adds a landing pad that runs ~Resource().
+long process_may_throw(int value){
+    Resource resource(value);
+    may_throw(value);
+    return resource.id() * 2;
+}
+
+//noexcept : an exception escaping means std::terminate, nothing to clean up.
+long process_noexcept(int value) noexcept{
+    Resource resource(value);
+    may_throw(value);
+    return resource.id() * 2;
+}
+
+//Allocating a std::string may throw std::bad_alloc
+std::string format_label(int value) noexcept{
+    std::string label = "label ";
+    label += std::to_string(value);
+    return label;
+}
+
+//A try block inside a noexcept function : a real landing pad
+long guarded_process(int value) noexcept{
+    try{
+        return process_may_throw(value);
+    }catch(...){
+        return -1;
+    }
+}
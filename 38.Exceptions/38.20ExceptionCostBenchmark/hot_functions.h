@@ -0,0 +1,42 @@
+#ifndef HOT_FUNCTIONS_H
+#define HOT_FUNCTIONS_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+//Functions whose generated code we inspect. They live in their own
+//translation unit so the compiler can't inline them into main().
+
+//Has a non trivial destructor : needs cleanup when an exception goes by
+class Resource
+{
+public:
+    explicit Resource(int id);
+    ~Resource();
+    int id() const { return m_id; }
+private:
+    int m_id;
+};
+
+//Throws a Warning when value is negative. The compiler can't see that
+//from the call sites.
+void may_throw(int value);
+
+//Hot loops that must stay free of exception handling code
+long sum_values(const long* values, size_t count) noexcept;
+size_t count_words(std::string_view text) noexcept;
+
+//Same body, with and without noexcept, to compare the generated code
+long process_may_throw(int value);
+long process_noexcept(int value) noexcept;
+
+//noexcept, but with a std::string to clean up. GCC needs no landing pad
+//for it, the unwinder calls std::terminate when nothing is listed.
+std::string format_label(int value) noexcept;
+
+//noexcept function that grew a try block : a real landing pad. The check
+//must report one here, or it isn't reading the tables right.
+long guarded_process(int value) noexcept;
+
+#endif // HOT_FUNCTIONS_H
@@ -0,0 +1,247 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <exception>
+#include "exceptions.h"
+#include "hot_functions.h"
+#include "exception_tables.h"
+
+//Benchmark harness for the exception lectures. Measures what throwing and
+//catching really costs, and how noexcept changes the generated code.
+//    ./main                 prints the report ( markdown )
+//    ./main report.md       also writes it to report.md
+//    ./main --check         fails ( exit code 1 ) if a hot noexcept function
+//                           has landing pads. Meant to run after each build.
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Function>
+double ns_per_iteration(size_t iterations, Function function){
+    auto start = Clock::now();
+    for(size_t i{}; i < iterations; ++i)
+        function(i);
+    auto end = Clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+//Throws from the bottom of a call chain depth frames deep. Left alone, GCC
+//turns the recursion into a loop ( return f(n - 1) + 1 is a tail call with
+//an accumulator to it ), or even into a single throw : one frame to unwind,
+//whatever the depth. The empty asm after the call is work the compiler
+//can't see through, so every call stays a real call with its own frame.
+//noipa keeps callers from reasoning about the function too.
+[[gnu::noipa]] int throw_at_depth(int depth){
+    if(depth == 0)
+        throw CriticalError("bottom reached");
+    int result = throw_at_depth(depth - 1);
+    asm volatile("" : "+r"(result));
+    return result + 1;
+}
+
+//Same, but every frame owns an object that must be destroyed on the way up
+[[gnu::noipa]] int throw_at_depth_with_cleanup(int depth){
+    Resource resource(depth);
+    if(depth == 0)
+        throw CriticalError("bottom reached");
+    return throw_at_depth_with_cleanup(depth - 1) + resource.id();
+}
+
+[[gnu::noinline]] void throw_critical(){
+    throw CriticalError("critical");
+}
+
+//Inner handler rethrows to the outer one, like the rethrow lecture
+[[gnu::noinline]] void rethrow_inner(bool copy){
+    try{
+        throw_critical();
+    }catch(SomethingIsWrong& ex){
+        if(copy)
+            throw ex; // Copies ( and slices ) the exception
+        throw;        // Rethrows the original object
+    }
+}
+
+//Nested try blocks on the path that doesn't throw, like 38.6
+[[gnu::noinline]] long nested_try(int value){
+    try{
+        try{
+            return process_may_throw(value);
+        }catch(int){
+            return -1;
+        }
+    }catch(SomethingIsWrong&){
+        return -2;
+    }
+}
+
+[[gnu::noinline]] long no_try(int value){
+    return process_may_throw(value);
+}
+
+volatile long sink {}; // Keeps results alive
+
+
+void throw_cost_by_depth(std::ostream& report){
+    report << "## Throw and catch latency by stack depth\n\n";
+    report << "| depth | plain frames (ns) | frames with cleanup (ns) |\n";
+    report << "|---|---|---|\n";
+    for(int depth : {1, 4, 16, 64, 256}){
+        const size_t iterations = 200'000 / depth + 1000;
+        double plain = ns_per_iteration(iterations, [depth](size_t){
+            try{ sink = throw_at_depth(depth); }catch(const CriticalError&){ sink = sink + 1; }
+        });
+        double cleanup = ns_per_iteration(iterations, [depth](size_t){
+            try{ sink = throw_at_depth_with_cleanup(depth); }catch(const CriticalError&){ sink = sink + 1; }
+        });
+        report << "| " << depth << " | " << plain << " | " << cleanup << " |\n";
+    }
+    report << "\n";
+}
+
+void catch_cost_by_handler(std::ostream& report){
+    const size_t iterations {200'000};
+    report << "## Catch cost by handler type ( throwing CriticalError )\n\n";
+    report << "| handler | ns per throw |\n|---|---|\n";
+    report << "| exact type `CriticalError&` | " << ns_per_iteration(iterations, [](size_t){
+        try{ throw_critical(); }catch(const CriticalError&){ sink = sink + 1; }
+    }) << " |\n";
+    report << "| base class `SomethingIsWrong&` (3 levels up) | " << ns_per_iteration(iterations, [](size_t){
+        try{ throw_critical(); }catch(const SomethingIsWrong&){ sink = sink + 1; }
+    }) << " |\n";
+    report << "| catch all `...` | " << ns_per_iteration(iterations, [](size_t){
+        try{ throw_critical(); }catch(...){ sink = sink + 1; }
+    }) << " |\n";
+    report << "| base class after 3 non matching handlers | " << ns_per_iteration(iterations, [](size_t){
+        try{ throw_critical(); }
+        catch(int){ sink = 0; }
+        catch(double){ sink = 0; }
+        catch(const std::exception&){ sink = 0; }
+        catch(const SomethingIsWrong&){ sink = sink + 1; }
+    }) << " |\n\n";
+}
+
+void rethrow_cost(std::ostream& report){
+    const size_t iterations {200'000};
+    report << "## Rethrow cost\n\n";
+    report << "| pattern | ns per throw |\n|---|---|\n";
+    report << "| single catch | " << ns_per_iteration(iterations, [](size_t){
+        try{ throw_critical(); }catch(SomethingIsWrong&){ sink = sink + 1; }
+    }) << " |\n";
+    report << "| inner catch + `throw;` | " << ns_per_iteration(iterations, [](size_t){
+        try{ rethrow_inner(false); }catch(SomethingIsWrong&){ sink = sink + 1; }
+    }) << " |\n";
+    report << "| inner catch + `throw ex;` (copy) | " << ns_per_iteration(iterations, [](size_t){
+        try{ rethrow_inner(true); }catch(SomethingIsWrong&){ sink = sink + 1; }
+    }) << " |\n\n";
+}
+
+void happy_path_cost(std::ostream& report){
+    const size_t iterations {20'000'000};
+    report << "## Cost when nothing is thrown\n\n";
+    report << "| call | ns per call |\n|---|---|\n";
+    report << "| no try block | " << ns_per_iteration(iterations, [](size_t i){
+        sink = no_try(static_cast<int>(i & 0xff));
+    }) << " |\n";
+    report << "| nested try blocks | " << ns_per_iteration(iterations, [](size_t i){
+        sink = nested_try(static_cast<int>(i & 0xff));
+    }) << " |\n";
+    report << "| process_may_throw | " << ns_per_iteration(iterations, [](size_t i){
+        sink = process_may_throw(static_cast<int>(i & 0xff));
+    }) << " |\n";
+    report << "| process_noexcept | " << ns_per_iteration(iterations, [](size_t i){
+        sink = process_noexcept(static_cast<int>(i & 0xff));
+    }) << " |\n\n";
+}
+
+void code_layout(std::ostream& report){
+    struct Entry { const char* name; ExceptionTableInfo info; };
+    const Entry entries[] {
+        {"process_may_throw", inspect_function(&process_may_throw)},
+        {"process_noexcept", inspect_function(&process_noexcept)},
+        {"nested_try", inspect_function(&nested_try)},
+        {"sum_values (noexcept)", inspect_function(&sum_values)},
+        {"count_words (noexcept)", inspect_function(&count_words)},
+        {"format_label (noexcept)", inspect_function(&format_label)},
+        {"guarded_process (noexcept)", inspect_function(&guarded_process)},
+    };
+    report << "## Generated code and exception tables\n\n";
+    report << "| function | code bytes | exception table | call sites | landing pads |\n";
+    report << "|---|---|---|---|---|\n";
+    for(const Entry& entry : entries){
+        if(!entry.info.found){
+            report << "| " << entry.name << " | unavailable on this platform | | | |\n";
+            continue;
+        }
+        report << "| " << entry.name << " | " << entry.info.code_bytes << " | "
+               << (entry.info.has_lsda ? "yes" : "no") << " | " << entry.info.call_sites
+               << " | " << entry.info.landing_pads << " |\n";
+    }
+    report << "\n";
+}
+
+//Hot functions marked noexcept that must not have landing pads. They call
+//nothing that can throw, so no compiler has a reason to add one.
+//process_noexcept is not on the list : GCC gives it no landing pad, but
+//Clang gives it one that only calls std::terminate, which is fine.
+int check_hot_functions(){
+    struct Hot { const char* name; const void* address; };
+    const Hot hot_functions[] {
+        {"sum_values", reinterpret_cast<const void*>(&sum_values)},
+        {"count_words", reinterpret_cast<const void*>(&count_words)},
+    };
+    int failures {};
+    for(const Hot& hot : hot_functions){
+        ExceptionTableInfo info = inspect_function(hot.address);
+        if(!info.found){
+            std::cout << "SKIP " << hot.name << " : no unwind information available" << std::endl;
+            continue;
+        }
+        if(info.landing_pads > 0){
+            std::cout << "FAIL " << hot.name << " : " << info.landing_pads
+                      << " landing pad(s) in a noexcept hot function" << std::endl;
+            ++failures;
+        }else{
+            std::cout << "ok   " << hot.name << " (" << info.code_bytes << " bytes)" << std::endl;
+        }
+    }
+
+    //The check itself : the catch block of guarded_process must be seen,
+    //or a broken table reader would pass every function.
+    ExceptionTableInfo guarded = inspect_function(&guarded_process);
+    if(!guarded.found){
+        std::cout << "SKIP guarded_process : no unwind information available" << std::endl;
+    }else if(guarded.landing_pads == 0){
+        std::cout << "FAIL guarded_process : its catch block was not detected" << std::endl;
+        ++failures;
+    }else{
+        std::cout << "ok   guarded_process : " << guarded.landing_pads
+                  << " landing pad(s) detected" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+    if(argc > 1 && std::string_view(argv[1]) == "--check")
+        return check_hot_functions();
+
+    std::ostringstream report;
+    report << "# Exception cost report\n\n";
+    throw_cost_by_depth(report);
+    catch_cost_by_handler(report);
+    rethrow_cost(report);
+    happy_path_cost(report);
+    code_layout(report);
+
+    std::cout << report.str();
+    if(argc > 1){
+        std::ofstream file(argv[1]);
+        file << report.str();
+        std::cout << "Report written to " << argv[1] << std::endl;
+    }
+
+    return 0;
+}
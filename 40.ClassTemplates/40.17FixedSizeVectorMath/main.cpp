@@ -0,0 +1,156 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include "vec.h"
+#include "mat.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Precomputed at compile time : the transform for each of 8 animation steps
+constexpr std::array<mat4f, 8> make_step_table(){
+    std::array<mat4f, 8> table {};
+    mat4f step = translation(vec3f{1.0f, 0.5f, 0.0f}) * scaling(vec3f{1.0f, 1.0f, 2.0f});
+    table[0] = mat4f::identity();
+    for(size_t i{1}; i < table.size(); ++i)
+        table[i] = table[i - 1] * step;
+    return table;
+}
+constexpr auto step_table = make_step_table();
+
+//What the compiler checked for us
+static_assert(dot(vec3f{1, 2, 3}, vec3f{4, 5, 6}) == 32.0f);
+static_assert(cross(vec3f{1, 0, 0}, vec3f{0, 1, 0}) == vec3f{0, 0, 1});
+static_assert(length(vec3d{3, 4, 0}) == 5.0);
+static_assert(step_table[2] * vec4f{0, 0, 1, 1} == vec4f{2, 1, 4, 1});
+static_assert(sizeof(vec3f) == 16 && alignof(vec4f) == 16); // Padded to one SSE register
+static_assert(alignof(mat4f) == 16);
+
+//Integer roots at the limits of each type, where value / 2 + 1 would
+//overflow if doubled, and a double loses the last digits
+template <typename T>
+constexpr bool is_floor_sqrt(T value, T root){
+    return root <= value / root && (root + 1) > value / (root + 1);
+}
+constexpr std::int64_t big_int64 {9'223'372'030'926'249'000};
+static_assert(constexpr_sqrt(std::numeric_limits<std::int32_t>::max()) == 46340);
+static_assert(constexpr_sqrt(std::numeric_limits<std::uint32_t>::max()) == 65535u);
+static_assert(constexpr_sqrt(std::numeric_limits<std::int64_t>::max()) == 3037000499);
+static_assert(constexpr_sqrt(std::numeric_limits<std::uint64_t>::max()) == 4294967295u);
+static_assert(constexpr_sqrt(big_int64) == 3037000498);
+static_assert(is_floor_sqrt(big_int64, constexpr_sqrt(big_int64)));
+
+//The same values at run time must give the same roots
+template <typename T>
+bool same_root_at_run_time(T value, T expected){
+    volatile T opaque {value}; // Not a constant any more
+    return constexpr_sqrt(static_cast<T>(opaque)) == expected;
+}
+
+bool check_integer_roots(){
+    return same_root_at_run_time(std::numeric_limits<std::int32_t>::max(), constexpr_sqrt(std::numeric_limits<std::int32_t>::max()))
+        && same_root_at_run_time(std::numeric_limits<std::uint32_t>::max(), constexpr_sqrt(std::numeric_limits<std::uint32_t>::max()))
+        && same_root_at_run_time(std::numeric_limits<std::int64_t>::max(), constexpr_sqrt(std::numeric_limits<std::int64_t>::max()))
+        && same_root_at_run_time(std::numeric_limits<std::uint64_t>::max(), constexpr_sqrt(std::numeric_limits<std::uint64_t>::max()))
+        && same_root_at_run_time(big_int64, constexpr_sqrt(big_int64))
+        && same_root_at_run_time(std::int64_t{3037000499} * 3037000499, std::int64_t{3037000499})
+        && same_root_at_run_time(std::uint64_t{4294967295} * 4294967295 - 1, std::uint64_t{4294967294});
+}
+
+
+//The same transform with sizes known only at run time : loops and
+//checked accesses, the way generic dynamic size code is written
+using DynamicMatrix = std::vector<std::vector<float>>;
+
+std::vector<float> multiply(const DynamicMatrix& matrix, const std::vector<float>& vector){
+    if(matrix.empty() || matrix[0].size() != vector.size())
+        throw std::invalid_argument("Matrix and vector sizes don't match");
+    std::vector<float> result(matrix.size());
+    for(size_t r{}; r < matrix.size(); ++r){
+        float sum {};
+        for(size_t c{}; c < vector.size(); ++c)
+            sum += matrix.at(r).at(c) * vector.at(c);
+        result.at(r) = sum;
+    }
+    return result;
+}
+
+
+int main(int argc, char** argv){
+
+    vec3f a {1.0f, 2.0f, 2.0f};
+    vec3f b {0.0f, 1.0f, 0.0f};
+    std::cout << "a : " << a << std::endl;
+    std::cout << "a + b : " << (a + b) << std::endl;
+    std::cout << "a * 2 : " << (a * 2.0f) << std::endl;
+    std::cout << "dot(a, b) : " << dot(a, b) << std::endl;
+    std::cout << "cross(a, b) : " << cross(a, b) << std::endl;
+    std::cout << "length(a) : " << length(a) << std::endl;
+    std::cout << "normalize(a) : " << normalize(a) << std::endl;
+
+    //A 2x3 times a 3x2 is a 2x2. mat<float,2,3> * mat<float,2,3> doesn't compile.
+    mat<float, 2, 3> m1 {{ {1, 2, 3}, {4, 5, 6} }};
+    std::cout << "m1 * transpose(m1) : " << (m1 * transpose(m1)) << std::endl;
+
+    std::cout << "step_table[3], computed at compile time : " << step_table[3] << std::endl;
+    std::cout << "Integer roots at the type limits, same at run time : " << std::boolalpha
+              << check_integer_roots() << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : transform many points by a 4x4 matrix. Default 10M points,
+    //can be changed from the command line.
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 10'000'000;
+    std::cout << std::endl;
+    std::cout << "Transforming " << count << " points : " << std::endl;
+
+    const mat4f transform = step_table[5];
+
+    std::vector<vec4f> points(count);
+    for(size_t i{}; i < count; ++i)
+        points[i] = vec4f{static_cast<float>(i % 100), static_cast<float>(i % 37), 1.0f, 1.0f};
+    std::vector<vec4f> fixed_result(count);
+
+    DynamicMatrix dynamic_transform(4, std::vector<float>(4));
+    for(size_t r{}; r < 4; ++r)
+        for(size_t c{}; c < 4; ++c)
+            dynamic_transform[r][c] = transform[r][c];
+    std::vector<std::vector<float>> dynamic_points(count);
+    for(size_t i{}; i < count; ++i)
+        dynamic_points[i] = {points[i][0], points[i][1], points[i][2], points[i][3]};
+    std::vector<std::vector<float>> dynamic_result(count);
+
+    double dynamic_time = time_ms([&]{
+        for(size_t i{}; i < count; ++i)
+            dynamic_result[i] = multiply(dynamic_transform, dynamic_points[i]);
+    });
+    double fixed_time = time_ms([&]{
+        for(size_t i{}; i < count; ++i)
+            fixed_result[i] = transform * points[i];
+    });
+    std::cout << "dynamic sizes ( std::vector, loops, at() ) : " << dynamic_time << " ms" << std::endl;
+    std::cout << "mat4f * vec4f                              : " << fixed_time << " ms" << std::endl;
+    std::cout << "Same results : " << std::boolalpha
+              << (dynamic_result[count / 2][0] == fixed_result[count / 2][0]
+                  && dynamic_result[count / 2][2] == fixed_result[count / 2][2]) << std::endl;
+
+    double normalize_time = time_ms([&]{
+        for(size_t i{}; i < count; ++i)
+            fixed_result[i] = normalize(fixed_result[i]);
+    });
+    std::cout << "normalize vec4f                            : " << normalize_time << " ms" << std::endl;
+
+    return 0;
+}
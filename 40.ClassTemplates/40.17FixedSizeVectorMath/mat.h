@@ -0,0 +1,86 @@
+#ifndef MAT_H
+#define MAT_H
+
+#include <cstddef>
+#include <iostream>
+#include "vec.h"
+
+//R x C matrix, stored row by row : each row is a vec<T, C>, so rows get the
+//same alignment and unrolled operations as vectors. Multiplying matrices of
+//the wrong shapes is a compile time error.
+template <typename T, size_t R, size_t C>
+struct mat
+{
+    vec<T, C> rows[R];
+
+    static constexpr size_t row_count() { return R; }
+    static constexpr size_t column_count() { return C; }
+
+    constexpr vec<T, C>& operator[](size_t row) { return rows[row]; }
+    constexpr const vec<T, C>& operator[](size_t row) const { return rows[row]; }
+
+    static constexpr mat identity() requires (R == C){
+        mat result {};
+        unroll<R>([&](size_t i){ result[i][i] = T{1}; });
+        return result;
+    }
+
+    constexpr bool operator==(const mat&) const = default;
+};
+
+template <typename T, size_t R, size_t C>
+constexpr mat<T, C, R> transpose(const mat<T, R, C>& operand){
+    mat<T, C, R> result {};
+    unroll<R>([&](size_t r){
+        unroll<C>([&](size_t c){ result[c][r] = operand[r][c]; });
+    });
+    return result;
+}
+
+//Each result row is a sum of rows of right, scaled by a row of left :
+//whole vec operations, no column gathering.
+template <typename T, size_t R, size_t K, size_t C>
+constexpr mat<T, R, C> operator*(const mat<T, R, K>& left, const mat<T, K, C>& right){
+    mat<T, R, C> result {};
+    unroll<R>([&](size_t r){
+        unroll<K>([&](size_t k){ result[r] += right[k] * left[r][k]; });
+    });
+    return result;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr vec<T, R> operator*(const mat<T, R, C>& left, const vec<T, C>& right){
+    vec<T, R> result {};
+    unroll<R>([&](size_t r){ result[r] = dot(left[r], right); });
+    return result;
+}
+
+template <typename T, size_t R, size_t C>
+inline std::ostream& operator<<(std::ostream& out, const mat<T, R, C>& operand){
+    out << "mat" << R << "x" << C << " [" << std::endl;
+    for(size_t r{}; r < R; ++r)
+        out << "    " << operand[r] << std::endl;
+    out << "]";
+    return out;
+}
+
+//Transforms for homogeneous coordinates ( x, y, z, 1 )
+template <typename T>
+constexpr mat<T, 4, 4> translation(const vec<T, 3>& offset){
+    auto result = mat<T, 4, 4>::identity();
+    unroll<3>([&](size_t i){ result[i][3] = offset[i]; });
+    return result;
+}
+
+template <typename T>
+constexpr mat<T, 4, 4> scaling(const vec<T, 3>& factors){
+    auto result = mat<T, 4, 4>::identity();
+    unroll<3>([&](size_t i){ result[i][i] = factors[i]; });
+    return result;
+}
+
+using mat3f = mat<float, 3, 3>;
+using mat4f = mat<float, 4, 4>;
+using mat4d = mat<double, 4, 4>;
+
+#endif // MAT_H
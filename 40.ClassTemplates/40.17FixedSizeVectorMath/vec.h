@@ -0,0 +1,221 @@
+#ifndef VEC_H
+#define VEC_H
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//Fixed size vectors, with the size as a non type template parameter :
+//    vec<float, 3> position {1.0f, 2.0f, 3.0f};
+//Because N is known at compile time :
+//  - every operation is unrolled : no loop counter, no bounds checks.
+//  - the storage is aligned to the next power of two ( up to 64 bytes ), so a
+//    vec<float, 4> fills exactly one SSE register and a vec<float, 3> is
+//    padded to one.
+//  - everything is constexpr : vecs can be computed at compile time, for
+//    constants and precomputed tables.
+
+//Calls function(0), function(1), ..., function(N - 1), without a loop
+template <size_t N, typename Function>
+constexpr void unroll(Function&& function){
+    [&]<size_t... I>(std::index_sequence<I...>){
+        (function(I), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+template <typename T, size_t N>
+constexpr size_t vec_alignment(){
+    size_t bytes = std::bit_ceil(sizeof(T) * N);
+    return bytes < alignof(T) ? alignof(T) : (bytes > 64 ? 64 : bytes);
+}
+
+//Integer square root, rounded down, for value >= 2. Newton from value / 2 + 1,
+//which is above the root : the estimates go down until they reach it, and
+//current + value / current stays below value / 2 + 1 + sqrt(value), which
+//never overflows.
+template <typename T>
+constexpr T integer_sqrt(T value){
+    T current = static_cast<T>(value / 2 + 1);
+    T next = static_cast<T>((current + value / current) / 2);
+    while(next < current){
+        current = next;
+        next = static_cast<T>((current + value / current) / 2);
+    }
+    return current;
+}
+
+//std::sqrt can't be used in constant expressions before C++26 : Newton's
+//method at compile time ( within one ulp of std::sqrt ), the hardware
+//instruction at run time.
+//Integers get the integer square root, rounded down, at compile time and at
+//run time alike. Negative integers throw std::domain_error. At compile
+//time, negative, infinite and NaN floating point inputs are rejected too :
+//the throw makes it a compile error.
+template <typename T>
+constexpr T constexpr_sqrt(T value){
+    if constexpr (std::is_integral_v<T>){
+        if(value < T{0})
+            throw std::domain_error("constexpr_sqrt of a negative number");
+        if(value < T{2})
+            return value;
+        if(std::is_constant_evaluated())
+            return integer_sqrt(value);
+        //A double has 53 bits : for big 64 bit values its root can be off by
+        //one either way. value / root compares without squaring, so without
+        //overflow.
+        T root = static_cast<T>(std::sqrt(static_cast<double>(value)));
+        while(root > value / root)
+            --root;
+        while(root + 1 <= value / (root + 1))
+            ++root;
+        return root;
+    }else{
+        if(!std::is_constant_evaluated())
+            return std::sqrt(value);
+        if(value != value || value > std::numeric_limits<T>::max()) // NaN, or infinite
+            throw std::domain_error("constexpr_sqrt of a non finite number");
+        if(value < T{0})
+            throw std::domain_error("constexpr_sqrt of a negative number");
+        if(value == T{0})
+            return value;
+        //Each step halves the error at first, then doubles the correct
+        //digits. Stop when a step no longer gets closer : the last two
+        //estimates may alternate between neighbors. A thousand steps covers
+        //the halving from the largest double.
+        auto distance = [](T a, T b){ return a > b ? a - b : b - a; };
+        T current = value;
+        T last_change = std::numeric_limits<T>::infinity();
+        for(int step{}; step < 1100; ++step){
+            T next = (current + value / current) / T{2};
+            T change = distance(next, current);
+            if(change >= last_change){
+                //Alternating : keep the one whose square is closer
+                if(distance(next * next, value) < distance(current * current, value))
+                    current = next;
+                break;
+            }
+            current = next;
+            last_change = change;
+        }
+        return current;
+    }
+}
+
+
+template <typename T, size_t N>
+struct alignas(vec_alignment<T, N>()) vec
+{
+    static_assert(std::is_arithmetic_v<T>, "vec holds numbers");
+    static_assert(N > 0, "vec can't be empty");
+
+    T data[N];
+
+    static constexpr size_t size() { return N; }
+
+    constexpr T& operator[](size_t index) { return data[index]; }
+    constexpr const T& operator[](size_t index) const { return data[index]; }
+
+    constexpr vec& operator+=(const vec& right){
+        unroll<N>([&](size_t i){ data[i] += right.data[i]; });
+        return *this;
+    }
+    constexpr vec& operator-=(const vec& right){
+        unroll<N>([&](size_t i){ data[i] -= right.data[i]; });
+        return *this;
+    }
+    constexpr vec& operator*=(T factor){
+        unroll<N>([&](size_t i){ data[i] *= factor; });
+        return *this;
+    }
+    constexpr vec& operator/=(T divisor){
+        unroll<N>([&](size_t i){ data[i] /= divisor; });
+        return *this;
+    }
+
+    constexpr bool operator==(const vec&) const = default;
+};
+
+//Free operators, reusing the compound ones
+template <typename T, size_t N>
+constexpr vec<T, N> operator+(vec<T, N> left, const vec<T, N>& right){
+    return left += right;
+}
+
+template <typename T, size_t N>
+constexpr vec<T, N> operator-(vec<T, N> left, const vec<T, N>& right){
+    return left -= right;
+}
+
+template <typename T, size_t N>
+constexpr vec<T, N> operator-(vec<T, N> operand){
+    unroll<N>([&](size_t i){ operand[i] = -operand[i]; });
+    return operand;
+}
+
+template <typename T, size_t N>
+constexpr vec<T, N> operator*(vec<T, N> left, T factor){
+    return left *= factor;
+}
+
+template <typename T, size_t N>
+constexpr vec<T, N> operator*(T factor, vec<T, N> right){
+    return right *= factor;
+}
+
+template <typename T, size_t N>
+constexpr vec<T, N> operator/(vec<T, N> left, T divisor){
+    return left /= divisor;
+}
+
+template <typename T, size_t N>
+constexpr T dot(const vec<T, N>& left, const vec<T, N>& right){
+    T result {};
+    unroll<N>([&](size_t i){ result += left[i] * right[i]; });
+    return result;
+}
+
+template <typename T>
+constexpr vec<T, 3> cross(const vec<T, 3>& left, const vec<T, 3>& right){
+    return {left[1] * right[2] - left[2] * right[1],
+            left[2] * right[0] - left[0] * right[2],
+            left[0] * right[1] - left[1] * right[0]};
+}
+
+template <typename T, size_t N>
+constexpr T length_squared(const vec<T, N>& operand){
+    return dot(operand, operand);
+}
+
+template <typename T, size_t N>
+constexpr T length(const vec<T, N>& operand){
+    return constexpr_sqrt(length_squared(operand));
+}
+
+//Same direction, length 1. The zero vector stays zero.
+template <typename T, size_t N>
+constexpr vec<T, N> normalize(const vec<T, N>& operand){
+    T operand_length = length(operand);
+    return operand_length == T{0} ? operand : operand / operand_length;
+}
+
+template <typename T, size_t N>
+inline std::ostream& operator<<(std::ostream& out, const vec<T, N>& operand){
+    out << "vec" << N << " [";
+    for(size_t i{}; i < N; ++i)
+        out << (i ? ", " : " ") << operand[i];
+    out << " ]";
+    return out;
+}
+
+using vec2f = vec<float, 2>;
+using vec3f = vec<float, 3>;
+using vec4f = vec<float, 4>;
+using vec3d = vec<double, 3>;
+using vec4d = vec<double, 4>;
+
+#endif // VEC_H
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <type_traits>
+#include <stdexcept>
+#include "boxcontainer.h"
+#include "static_box.h"
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//Works at compile time too
+constexpr static_box<int,8> make_primes(){
+	static_box<int,8> primes;
+	for(int candidate{2}; !primes.full(); ++candidate){
+		bool is_prime {true};
+		for(int p : primes)
+			if(candidate % p == 0)
+				is_prime = false;
+		if(is_prime)
+			primes.add(candidate);
+	}
+	return primes;
+}
+constexpr auto primes = make_primes();
+static_assert(primes[7] == 19);
+
+static_assert(std::is_trivially_copyable_v<static_box<int,16>>);
+static_assert(!std::is_trivially_copyable_v<static_box<std::string,16>>);
+static_assert(sizeof(static_box<int,16>) == 16 * sizeof(int) + sizeof(size_t));
+
+
+//A per request scratch collection : fill, use, throw away
+[[gnu::noinline]] long scratch_with_box_container(int request){
+	BoxContainer<int> scratch(32); // Sized up front : no expanding
+	for(int i{}; i < 32; ++i)
+		scratch.add(request + i);
+	long sum {};
+	for(size_t i{}; i < scratch.size(); ++i)
+		sum += scratch.get_item(i);
+	return sum;
+}
+
+[[gnu::noinline]] long scratch_with_static_box(int request){
+	static_box<int,32> scratch;
+	for(int i{}; i < 32; ++i)
+		scratch.add(request + i);
+	long sum {};
+	for(int value : scratch)
+		sum += value;
+	return sum;
+}
+
+
+int main(){
+
+	static_box<int,5> int_box1;
+	int_box1.add(10);
+	int_box1.add(21);
+	int_box1.add(10);
+	int_box1.add(55);
+	std::cout << "int_box1 : " << int_box1 << std::endl;
+	
+	int_box1.remove_item(55);
+	std::cout << "int_box1 : " << int_box1 << std::endl;
+	
+	size_t removed = int_box1.remove_all(10);
+	std::cout << removed  << " items removed" << std::endl;
+	std::cout << "int_box1 : " << int_box1 << std::endl;
+
+	//Overflow is explicit
+	std::cout << std::endl;
+	static_box<std::string,3> string_box;
+	for(const char* word : {"Hello", "static", "box", "overflow"}){
+		if(!string_box.try_add(word))
+			std::cout << "No room for \"" << word << "\"" << std::endl;
+	}
+	std::cout << "string_box : " << string_box << std::endl;
+	try{
+		string_box.add("again");
+	}catch(const std::length_error& ex){
+		std::cout << "add() threw : " << ex.what() << std::endl;
+	}
+
+	//operator+= and operator+
+	std::cout << std::endl;
+	static_box<int,5> int_box2;
+	int_box2.add(100);
+	int_box2.add(200);
+	int_box2 += int_box1;
+	std::cout << "int_box2 : " << int_box2 << std::endl;
+	static_box<int,5> int_box3 = int_box1 + int_box1;
+	std::cout << "int_box3 : " << int_box3 << std::endl;
+	
+	//Copies are plain copies of the items
+	static_box<int,5> int_box4 = int_box3;
+	std::cout << "int_box4 : " << int_box4 << std::endl;
+
+	std::cout << "primes, computed at compile time : " << primes << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+	//Benchmark : many short lived scratch collections of 32 ints
+	const int requests {10'000'000};
+	long heap_total {};
+	long static_total {};
+	double heap_time = time_ms([&]{
+		for(int r{}; r < requests; ++r)
+			heap_total += scratch_with_box_container(r);
+	});
+	double static_time = time_ms([&]{
+		for(int r{}; r < requests; ++r)
+			static_total += scratch_with_static_box(r);
+	});
+	std::cout << std::endl;
+	std::cout << requests << " scratch collections of 32 ints : " << std::endl;
+	std::cout << "BoxContainer<int> ( heap )   : " << heap_time << " ms" << std::endl;
+	std::cout << "static_box<int,32> ( stack ) : " << static_time << " ms" << std::endl;
+	std::cout << "Same results : " << std::boolalpha << (heap_total == static_total) << std::endl;
+
+    return 0;
+}
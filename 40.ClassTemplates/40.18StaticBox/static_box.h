@@ -0,0 +1,165 @@
+#ifndef STATIC_BOX_H
+#define STATIC_BOX_H
+
+#include <concepts>
+#include <iostream>
+#include <stdexcept>
+
+//BoxContainer with its maximum as a non type template parameter, and the
+//items stored inside the object itself : no heap at all. A static_box<int,16>
+//on the stack is the items plus a size.
+//  - Same add / remove_item / remove_all / operator+= API as BoxContainer.
+//  - The capacity is fixed : adding to a full box is an error. add() and
+//    operator+= throw std::length_error, try_add() and try_append() return
+//    false and leave the box untouched.
+//  - Everything is constexpr.
+//  - Copying is a plain member wise copy : if T is trivially copyable, so is
+//    the static_box.
+//Like BoxContainer, T must be default constructible : all N slots exist
+//from the start.
+template <std::default_initializable T, size_t N>
+class static_box 
+{
+public:
+	constexpr static_box() = default;
+
+	// Helper getter methods
+	constexpr size_t size( ) const { return m_size; }
+	static constexpr size_t capacity() { return N; }
+	constexpr bool full() const { return m_size == N; }
+	constexpr bool empty() const { return m_size == 0; }
+	
+	constexpr T get_item(size_t index) const{
+		return m_items[index];
+	}
+	constexpr const T& operator[](size_t index) const { return m_items[index]; }
+	constexpr T& operator[](size_t index) { return m_items[index]; }
+
+	constexpr const T* begin() const { return m_items; }
+	constexpr const T* end() const { return m_items + m_size; }
+	
+	//Method to add items to the box
+	constexpr void add(const T& item);
+	[[nodiscard]] constexpr bool try_add(const T& item);
+	constexpr bool remove_item(const T& item);
+	constexpr size_t remove_all(const T& item);
+	constexpr void clear();
+
+	//Adds all the items of operand, or none if they don't all fit
+	template <size_t M>
+	[[nodiscard]] constexpr bool try_append(const static_box<T,M>& operand);
+	//In class operators
+	template <size_t M>
+	constexpr void operator +=(const static_box<T,M>& operand);
+
+private : 
+	T m_items[N] {};
+	size_t m_size {0};
+};
+
+//Free operators
+template <typename T, size_t N>
+constexpr static_box<T,N> operator +(const static_box<T,N>& left, const static_box<T,N>& right);
+
+template <typename T, size_t N>
+inline std::ostream& operator<<(std::ostream& out, const static_box<T,N>& operand){
+    
+	out << "static_box : [ size :  " << operand.size()
+		<< ", capacity : " << operand.capacity() << ", items : " ;
+			
+	for(size_t i{0}; i < operand.size(); ++i){
+		out << operand.get_item(i) << " " ;
+	}
+	out << "]";
+    
+    return out;
+}
+
+
+template <std::default_initializable T, size_t N>
+constexpr bool static_box<T,N>::try_add(const T& item){
+	if(m_size == N)
+		return false;
+	m_items[m_size] = item;
+	++m_size;
+	return true;
+}
+
+template <std::default_initializable T, size_t N>
+constexpr void static_box<T,N>::add(const T& item){
+	if(!try_add(item))
+		throw std::length_error("static_box is full");
+}
+
+
+template <std::default_initializable T, size_t N>
+constexpr bool static_box<T,N>::remove_item(const T& item){
+	
+	//Find the target item
+	size_t index {N};
+	for(size_t i{0}; i < m_size ; ++i){
+		if (m_items[i] == item){
+			index = i;
+			break; // No need for the loop to go on
+		}
+	}
+	
+	if(index >= m_size)
+		return false; // Item not found in our box here
+		
+	//Overshadow item at index with last element and decrement m_size.
+	//The freed slot gets a fresh T, so it doesn't hold on to resources.
+	m_items[index] = m_items[m_size-1];
+	m_items[m_size-1] = T{};
+	m_size--;
+	return true;
+}
+
+
+template <std::default_initializable T, size_t N>
+constexpr size_t static_box<T,N>::remove_all(const T& item){
+	size_t remove_count{};
+	while(remove_item(item))
+		++remove_count;
+	return remove_count;
+}
+
+template <std::default_initializable T, size_t N>
+constexpr void static_box<T,N>::clear(){
+	for(size_t i{} ; i < m_size; ++i){
+		m_items[i] = T{};
+	}
+	m_size = 0;
+}
+
+template <std::default_initializable T, size_t N>
+template <size_t M>
+constexpr bool static_box<T,N>::try_append(const static_box<T,M>& operand){
+	if(m_size + operand.size() > N)
+		return false;
+	
+	//Copy over the elements
+	for(size_t i{} ; i < operand.size(); ++i){
+		m_items [m_size + i] = operand[i];
+	}
+	
+	m_size += operand.size();
+	return true;
+}
+
+template <std::default_initializable T, size_t N>
+template <size_t M>
+constexpr void static_box<T,N>::operator +=(const static_box<T,M>& operand){
+	if(!try_append(operand))
+		throw std::length_error("static_box is full");
+}
+
+template <typename T, size_t N>
+constexpr static_box<T,N> operator +(const static_box<T,N>& left, const static_box<T,N>& right){
+	static_box<T,N> result;
+	result += left; 
+	result += right;
+	return result;	
+}
+
+#endif // STATIC_BOX_H
@@ -0,0 +1,68 @@
+#ifndef FUNCTION_REF_H
+#define FUNCTION_REF_H
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+//A non owning reference to a function like entity. It's just two pointers :
+//one to the callable and one to a small trampoline function that knows the
+//callable's real type. Nothing is copied or allocated, so the callable must
+//outlive the function_ref. Perfect for callback parameters like the
+//modifier in modify(), where the callable is only used during the call.
+
+template <typename Signature>
+class function_ref; // Only the function type specialization below is defined
+
+template <typename R, typename... Args>
+class function_ref<R(Args...)>
+{
+public:
+    //Plain functions : we keep the function pointer itself
+    template <typename F>
+        requires std::is_function_v<F> && std::is_invocable_r_v<R, F&, Args...>
+    function_ref(F* function) noexcept
+    {
+        m_object.function = reinterpret_cast<void(*)()>(function);
+        m_callback = [](Object object, Args... args) -> R {
+            return std::invoke(reinterpret_cast<F*>(object.function),
+                               std::forward<Args>(args)...);
+        };
+    }
+
+    //Functors and lambda functions : we keep their address
+    template <typename F,
+              typename D = std::remove_reference_t<F>>
+        requires (!std::is_same_v<std::remove_cv_t<D>, function_ref>) &&
+                 (!std::is_pointer_v<D>) && (!std::is_function_v<D>) &&
+                 std::is_invocable_r_v<R, D&, Args...>
+    function_ref(F&& callable) noexcept
+    {
+        m_object.pointer = const_cast<void*>(static_cast<const void*>(std::addressof(callable)));
+        m_callback = [](Object object, Args... args) -> R {
+            return std::invoke(*static_cast<D*>(object.pointer), std::forward<Args>(args)...);
+        };
+    }
+
+    function_ref(const function_ref&) noexcept = default;
+    function_ref& operator=(const function_ref&) noexcept = default;
+
+    R operator()(Args... args) const
+    {
+        return m_callback(m_object, std::forward<Args>(args)...);
+    }
+
+private:
+    //Object pointers and function pointers can't portably share a void*
+    union Object
+    {
+        void* pointer;
+        void (*function)();
+    };
+
+    Object m_object;
+    R (*m_callback)(Object, Args...);
+};
+
+#endif // FUNCTION_REF_H
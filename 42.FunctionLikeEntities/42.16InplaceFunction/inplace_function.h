@@ -0,0 +1,189 @@
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <functional>
+
+//A std::function look alike that never touches the heap. The callable is
+//stored inside a fixed size buffer that lives in the wrapper object itself.
+//Callables that don't fit are rejected at compile time, instead of silently
+//falling back to a heap allocation like std::function does.
+
+//The operations we need on the stored callable are gathered in a table
+//of function pointers. There is one static table per stored callable type,
+//so the wrapper only carries a single pointer to it.
+template <typename R, typename... Args>
+struct InplaceVTable
+{
+    R (*invoke)(void* storage, Args&&... args);
+    void (*copy)(void* dest, const void* source);  // nullptr for move only callables
+    void (*move)(void* dest, void* source);         // Move constructs and destroys source
+    void (*destroy)(void* storage);
+};
+
+template <typename F, bool Copyable, typename R, typename... Args>
+inline constexpr InplaceVTable<R, Args...> inplace_vtable_for {
+    //invoke
+    [](void* storage, Args&&... args) -> R {
+        return std::invoke(*static_cast<F*>(storage), std::forward<Args>(args)...);
+    },
+    //copy
+    [](){
+        if constexpr (Copyable){
+            return +[](void* dest, const void* source){
+                ::new (dest) F(*static_cast<const F*>(source));
+            };
+        }else{
+            return static_cast<void(*)(void*, const void*)>(nullptr);
+        }
+    }(),
+    //move
+    [](void* dest, void* source){
+        ::new (dest) F(std::move(*static_cast<F*>(source)));
+        static_cast<F*>(source)->~F();
+    },
+    //destroy
+    [](void* storage){
+        static_cast<F*>(storage)->~F();
+    }
+};
+
+
+template <typename Signature, size_t Capacity, bool Copyable>
+class basic_inplace_function; // Only the function type specialization below is defined
+
+template <typename R, typename... Args, size_t Capacity, bool Copyable>
+class basic_inplace_function<R(Args...), Capacity, Copyable>
+{
+    using VTable = InplaceVTable<R, Args...>;
+
+public:
+    static constexpr size_t capacity = Capacity;
+
+    basic_inplace_function() = default;
+    basic_inplace_function(std::nullptr_t) {}
+
+    template <typename F,
+              typename D = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<D, basic_inplace_function> &&
+                                          std::is_invocable_r_v<R, D&, Args...>>>
+    basic_inplace_function(F&& callable)
+    {
+        static_assert(sizeof(D) <= Capacity,
+                      "Callable too big for this inplace_function, increase Capacity");
+        static_assert(alignof(D) <= alignof(std::max_align_t),
+                      "Callable is over aligned for inplace_function storage");
+        static_assert(!Copyable || std::is_copy_constructible_v<D>,
+                      "inplace_function needs a copyable callable, use move_only_inplace_function");
+        static_assert(std::is_nothrow_move_constructible_v<D>,
+                      "inplace_function requires a nothrow move constructible callable");
+
+        //Function pointers can be null : treat that as an empty wrapper
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<F>> ||
+                      std::is_member_pointer_v<std::remove_cvref_t<F>>){
+            if(callable == nullptr)
+                return;
+        }
+
+        ::new (static_cast<void*>(m_storage)) D(std::forward<F>(callable));
+        m_vtable = &inplace_vtable_for<D, Copyable, R, Args...>;
+    }
+
+    basic_inplace_function(const basic_inplace_function& source) requires Copyable
+    {
+        if(source.m_vtable){
+            source.m_vtable->copy(m_storage, source.m_storage);
+            m_vtable = source.m_vtable;
+        }
+    }
+
+    basic_inplace_function(basic_inplace_function&& source) noexcept
+    {
+        move_from(source);
+    }
+
+    basic_inplace_function& operator=(const basic_inplace_function& source) requires Copyable
+    {
+        if(this != &source){
+            basic_inplace_function copy(source); // The copy may throw, leave *this untouched
+            reset();
+            move_from(copy);
+        }
+        return *this;
+    }
+
+    basic_inplace_function& operator=(basic_inplace_function&& source) noexcept
+    {
+        if(this != &source){
+            reset();
+            move_from(source);
+        }
+        return *this;
+    }
+
+    basic_inplace_function& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~basic_inplace_function()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept { return m_vtable != nullptr; }
+
+    R operator()(Args... args) const
+    {
+        if(!m_vtable)
+            throw std::bad_function_call();
+        return m_vtable->invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+    void swap(basic_inplace_function& other) noexcept
+    {
+        basic_inplace_function tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    void reset() noexcept
+    {
+        if(m_vtable){
+            m_vtable->destroy(m_storage);
+            m_vtable = nullptr;
+        }
+    }
+
+    //Precondition : *this is empty
+    void move_from(basic_inplace_function& source) noexcept
+    {
+        if(source.m_vtable){
+            source.m_vtable->move(m_storage, source.m_storage);
+            m_vtable = source.m_vtable;
+            source.m_vtable = nullptr;
+        }
+    }
+
+private:
+    const VTable* m_vtable {nullptr};
+    //mutable : calling a const wrapper may still call a non const operator()
+    //on the stored callable, just like std::function.
+    alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+};
+
+//Copyable version, a drop in replacement for std::function
+template <typename Signature, size_t Capacity = 32>
+using inplace_function = basic_inplace_function<Signature, Capacity, true>;
+
+//Move only version. Can hold callables that own unique resources, like a
+//lambda capturing a std::unique_ptr.
+template <typename Signature, size_t Capacity = 32>
+using move_only_inplace_function = basic_inplace_function<Signature, Capacity, false>;
+
+#endif // INPLACE_FUNCTION_H
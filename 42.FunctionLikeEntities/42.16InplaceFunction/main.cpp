@@ -0,0 +1,150 @@
+#include <iostream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <chrono>
+#include "boxcontainer.h"
+#include "inplace_function.h"
+#include "function_ref.h"
+
+
+//Function pointer
+char encrypt(const char& param){
+    return static_cast<char> (param + 3);
+}
+
+//Functor
+class Decrypt
+{
+public:
+    char operator()( const char& param){
+         return static_cast<char> (param - 3);
+    }
+};
+
+
+//Same modify() as in the std::function lecture, but the callback is now
+//a non owning function_ref : no copy of the callable, no allocation.
+BoxContainer<std::string>& modify(BoxContainer<std::string>& sentence,
+                                  function_ref<char(const char&)> modifier){
+    for(size_t i{}; i < sentence.size() ; ++i){
+        for(size_t j{} ; j < sentence.get_item(i).size(); ++j){
+            sentence.get_item(i)[j] = modifier(sentence.get_item(i)[j]);
+        }
+    }
+    return sentence;
+}
+
+
+//Benchmark helpers : run the same per character loop through different kinds
+//of callback parameters. noinline keeps the compiler from seeing through the
+//call sites and specializing the loop for the callable.
+template <typename Callback>
+[[gnu::noinline]] void transform_string(std::string& str, const Callback& modifier){
+    for(size_t i{} ; i < str.size() ; ++i){
+        str[i] = modifier(str[i]);
+    }
+}
+
+template <typename Callback>
+void run_benchmark(const std::string& label, std::string& data, const Callback& modifier){
+    const size_t rounds {20};
+    auto start = std::chrono::steady_clock::now();
+    for(size_t r{}; r < rounds; ++r){
+        transform_string(data,modifier);
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << "  " << label << " : " << ns / (rounds * data.size())
+              << " ns/char" << std::endl;
+}
+
+
+int main(){
+
+    //inplace_function : same usage as std::function
+    inplace_function<char(const char&)> my_modifier;
+
+    my_modifier = encrypt; // Function pointer
+    std::cout << "A encrypted becomes : " << my_modifier('A') << std::endl; // D
+
+    Decrypt decrypt;
+    my_modifier = decrypt; // Functor
+    std::cout << "D decrypted becomes : " << my_modifier('D') << std::endl; // A
+
+    //Lambda function capturing 24 bytes of state : too big for the
+    //std::function small buffer in common standard libraries, but it fits in
+    //the 32 bytes of the inplace_function buffer.
+    long shift {3};
+    long unused1 {}, unused2 {};
+    auto big_lambda = [shift,unused1,unused2](const char& param){
+        return static_cast<char> (param + shift + unused1 + unused2);
+    };
+    my_modifier = big_lambda;
+    std::cout << "A encrypted becomes : " << my_modifier('A') << std::endl; // D
+    std::cout << "sizeof(inplace_function<char(const char&)>) : "
+              << sizeof(my_modifier) << std::endl;
+
+    //Doesn't compile : the callable doesn't fit in 8 bytes.
+    //inplace_function<char(const char&),8> too_small = big_lambda;
+
+
+    std::cout << "--------" << std::endl;
+
+    //move_only_inplace_function : can hold callables that can't be copied
+    auto key = std::make_unique<int>(3);
+    move_only_inplace_function<char(const char&)> owning_modifier =
+        [key = std::move(key)](const char& param){
+            return static_cast<char> (param + *key);
+        };
+    std::cout << "A encrypted by move only wrapper : " << owning_modifier('A') << std::endl;
+    auto other_owner = std::move(owning_modifier);
+    std::cout << "moved from wrapper is empty : " << std::boolalpha
+              << !owning_modifier << std::endl;
+    std::cout << "A encrypted by new owner : " << other_owner('A') << std::endl;
+
+
+    std::cout << "--------" << std::endl;
+
+    //function_ref as callback
+    std::cout << std::endl;
+    std::cout << "Modifying the quote : " << std::endl;
+    BoxContainer<std::string> quote;
+    quote.add("The");
+    quote.add("sky");
+    quote.add("is");
+    quote.add("blue");
+    quote.add("my");
+    quote.add("friend");
+    std::cout << "Initial : " <<  quote << std::endl;
+    std::cout << "Encrypted : " << modify(quote,encrypt) << std::endl;
+    std::cout << "Decrypted : " << modify(quote,decrypt) << std::endl;
+    std::cout << "Encrypted : " << modify(quote,big_lambda) << std::endl;
+
+
+    std::cout << "--------" << std::endl;
+
+    //Benchmark : per element callback loop over a 16MB string
+    std::cout << std::endl;
+    std::cout << "Per character callback cost : " << std::endl;
+    std::string data(16 * 1024 * 1024, 'a');
+
+    char (*f_ptr) (const char&) = encrypt;
+    std::function<char(const char&)> std_small {encrypt};
+    std::function<char(const char&)> std_big {big_lambda}; // Heap allocated
+    inplace_function<char(const char&)> inplace_big {big_lambda};
+    move_only_inplace_function<char(const char&)> move_only_big {big_lambda};
+    function_ref<char(const char&)> ref_big {big_lambda};
+
+    run_benchmark("raw function pointer         ", data, f_ptr);
+    run_benchmark("std::function (function ptr) ", data, std_small);
+    run_benchmark("std::function (24B lambda)   ", data, std_big);
+    run_benchmark("inplace_function (24B lambda)", data, inplace_big);
+    run_benchmark("move_only_inplace_function   ", data, move_only_big);
+    run_benchmark("function_ref (24B lambda)    ", data, ref_big);
+    run_benchmark("lambda, no type erasure      ", data, big_lambda);
+
+    std::cout << "checksum : " << static_cast<int>(data[0]) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef DECRYPT_H
+#define DECRYPT_H
+
+//Functor or function object
+
+class Decrypt
+{
+public:
+    //constexpr : lets transform_bytes() evaluate the functor at compile time
+    constexpr char operator()( const char& param) const{
+         return static_cast<char> (param - 3);
+    }
+};
+
+#endif // DECRYPT_H
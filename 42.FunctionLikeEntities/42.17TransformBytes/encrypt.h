@@ -0,0 +1,13 @@
+#ifndef ENCRYPT_H
+#define ENCRYPT_H
+
+class Encrypt
+{
+public:
+    //constexpr : lets transform_bytes() evaluate the functor at compile time
+    constexpr char operator()( const char& param) const{
+         return static_cast<char> (param + 3);
+    }
+};
+
+#endif // ENCRYPT_H
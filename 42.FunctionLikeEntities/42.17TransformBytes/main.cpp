@@ -0,0 +1,175 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cctype>
+#include "encrypt.h"
+#include "decrypt.h"
+#include "transform_bytes.h"
+
+
+//Per character modify from the functors lecture, kept as the reference
+template <typename Modifier>
+std::string & modify(std::string& str_param, Modifier modifier)
+{
+     for(size_t i{} ; i < str_param.size() ; ++i){
+        str_param[i] = modifier(str_param[i]);
+     }
+     return str_param;
+}
+
+//Not affine : ends up as a lookup table
+class ToUpper
+{
+public:
+    constexpr char operator()(const char& param) const{
+        return (param >= 'a' && param <= 'z') ? static_cast<char>(param - 'a' + 'A') : param;
+    }
+};
+
+//Affine with a multiplier
+class Scramble
+{
+public:
+    constexpr char operator()(const char& param) const{
+        return static_cast<char>(param * 5 + 7);
+    }
+};
+
+//The shift is only known at run time : the compiler can't evaluate this one
+class Shift
+{
+public:
+    explicit Shift(int amount) : m_amount(amount){}
+    char operator()(const char& param) const{
+        return static_cast<char>(param + m_amount);
+    }
+private:
+    int m_amount;
+};
+
+//constexpr, but with state : must not be mistaken for ShiftBy{}
+class ShiftBy
+{
+public:
+    constexpr ShiftBy() = default;
+    constexpr explicit ShiftBy(int amount) : m_amount(amount){}
+    constexpr char operator()(const char& param) const{
+        return static_cast<char>(param + m_amount);
+    }
+private:
+    int m_amount {3};
+};
+
+
+//Check every kernel against the scalar reference, with sizes that exercise
+//the vector loops and their tails.
+bool check_kernels(){
+    const ByteTable upper_table = byte_table_for<ToUpper>;
+    for(size_t size : {0, 1, 15, 16, 31, 33, 63, 64, 65, 257, 1000}){
+        std::string input(size, '\0');
+        for(size_t i{}; i < size; ++i)
+            input[i] = static_cast<char>(i * 37 + 11);
+
+        std::string affine_ref {input};
+        modify(affine_ref, Scramble{});
+        std::string table_ref {input};
+        modify(table_ref, ToUpper{});
+
+        for(SimdLevel level : {SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512}){
+            if(static_cast<int>(level) > static_cast<int>(detected_simd_level()))
+                continue;
+            std::string affine {input};
+            transform_bytes_affine(affine, 5, 7, level);
+            std::string table {input};
+            transform_bytes_table(table, upper_table, level);
+            if(affine != affine_ref || table != table_ref){
+                std::cout << "Mismatch at level " << to_string(level) << ", size " << size << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Function>
+double ns_per_byte(std::string& data, Function function){
+    const size_t rounds {10};
+    auto start = std::chrono::steady_clock::now();
+    for(size_t r{}; r < rounds; ++r)
+        function(data);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (rounds * data.size());
+}
+
+
+int main(){
+
+    std::string str {"Hello World"};
+
+    std::cout << "Transforming strings in bulk : " << std::endl;
+    std::cout << "Initial : " << str << std::endl;
+    transform_bytes(str, Encrypt{});
+    std::cout << "Encrypted : " << str << std::endl;
+    transform_bytes(str, Decrypt{});
+    std::cout << "Decrypted : " << str << std::endl;
+    transform_bytes(str, ToUpper{});
+    std::cout << "Upper case : " << str << std::endl;
+    transform_bytes(str, Shift{1}); // Short string : the plain loop
+    std::cout << "Shifted by 1 : " << str << std::endl;
+    transform_bytes(str, make_byte_table(Shift{-1})); // Runtime table, affine again
+    std::cout << "Shifted back : " << str << std::endl;
+
+    //What the compiler figured out about each functor
+    static_assert(classify_byte_table(byte_table_for<Encrypt>).kind == ByteTransformShape::Kind::affine);
+    static_assert(classify_byte_table(byte_table_for<Encrypt>).add == 3);
+    static_assert(classify_byte_table(byte_table_for<Scramble>).mul == 5);
+    static_assert(classify_byte_table(byte_table_for<ToUpper>).kind == ByteTransformShape::Kind::table);
+    static_assert(!ConstexprByteFunctor<Shift>);
+    static_assert(!ConstexprByteFunctor<ShiftBy>); // Has state
+
+    //A big buffer and a stateful functor promised pure : table built at run
+    //time from ShiftBy{1}
+    std::string big(RUNTIME_TABLE_MIN_SIZE, 'a');
+    transform_bytes(big, pure_byte_function{ShiftBy{1}});
+    std::cout << "ShiftBy{1} on " << big.size() << " 'a' : "
+              << (big == std::string(big.size(), 'b') ? "all 'b'" : "WRONG") << std::endl;
+
+    //Without the promise, called once per byte whatever the size : a functor
+    //with a side effect sees every byte
+    size_t calls {};
+    transform_bytes(big, [&calls](char c){ ++calls; return c; });
+    std::cout << "Counting functor on " << big.size() << " bytes : " << calls << " calls" << std::endl;
+
+    std::cout << "------" << std::endl;
+
+    std::cout << "Detected SIMD level : " << to_string(detected_simd_level()) << std::endl;
+    std::cout << "Kernels agree with the scalar reference : " << std::boolalpha
+              << check_kernels() << std::endl;
+
+    std::cout << "------" << std::endl;
+
+    //Benchmark on 64MB of text
+    std::cout << std::endl;
+    std::cout << "Throughput (ns/byte) : " << std::endl;
+    std::string data(64 * 1024 * 1024, 'x');
+
+    std::cout << "  modify(Encrypt) per character : "
+              << ns_per_byte(data, [](std::string& d){ modify(d, Encrypt{}); }) << std::endl;
+    std::cout << "  modify(ToUpper) per character : "
+              << ns_per_byte(data, [](std::string& d){ modify(d, ToUpper{}); }) << std::endl;
+
+    const ByteTable upper_table = byte_table_for<ToUpper>;
+    for(SimdLevel level : {SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512}){
+        if(static_cast<int>(level) > static_cast<int>(detected_simd_level()))
+            continue;
+        std::cout << "  " << to_string(level) << " affine : "
+                  << ns_per_byte(data, [level](std::string& d){ transform_bytes_affine(d, 1, 3, level); })
+                  << ", table : "
+                  << ns_per_byte(data, [&](std::string& d){ transform_bytes_table(d, upper_table, level); })
+                  << std::endl;
+    }
+
+    std::cout << "checksum : " << static_cast<int>(data[0]) << std::endl;
+
+    return 0;
+}
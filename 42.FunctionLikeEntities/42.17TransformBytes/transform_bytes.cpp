@@ -0,0 +1,212 @@
+#include "transform_bytes.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TRANSFORM_BYTES_X86 1
+#include <immintrin.h>
+#endif
+
+namespace{
+
+//Scalar kernels, also used for the tails the vector loops leave behind.
+void affine_scalar(unsigned char* data, size_t size, std::uint8_t mul, std::uint8_t add){
+    for(size_t i{}; i < size; ++i){
+        data[i] = static_cast<unsigned char>(data[i] * mul + add);
+    }
+}
+
+void table_scalar(unsigned char* data, size_t size, const ByteTable& table){
+    for(size_t i{}; i < size; ++i){
+        data[i] = table[data[i]];
+    }
+}
+
+#ifdef TRANSFORM_BYTES_X86
+
+//There is no byte multiply in SSE/AVX. We multiply the even and the odd
+//bytes separately as 16 bit lanes and keep the low byte of each product.
+
+__attribute__((target("sse2")))
+void affine_sse2(unsigned char* data, size_t size, std::uint8_t mul, std::uint8_t add){
+    const __m128i vmul = _mm_set1_epi16(mul);
+    const __m128i vadd = _mm_set1_epi8(static_cast<char>(add));
+    const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+    size_t i{};
+    for(; i + 16 <= size; i += 16){
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if(mul != 1){
+            __m128i even = _mm_and_si128(_mm_mullo_epi16(v, vmul), low_bytes);
+            __m128i odd = _mm_slli_epi16(_mm_mullo_epi16(_mm_srli_epi16(v, 8), vmul), 8);
+            v = _mm_or_si128(even, odd);
+        }
+        v = _mm_add_epi8(v, vadd);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), v);
+    }
+    affine_scalar(data + i, size - i, mul, add);
+}
+
+__attribute__((target("avx2")))
+void affine_avx2(unsigned char* data, size_t size, std::uint8_t mul, std::uint8_t add){
+    const __m256i vmul = _mm256_set1_epi16(mul);
+    const __m256i vadd = _mm256_set1_epi8(static_cast<char>(add));
+    const __m256i low_bytes = _mm256_set1_epi16(0x00FF);
+    size_t i{};
+    for(; i + 32 <= size; i += 32){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        if(mul != 1){
+            __m256i even = _mm256_and_si256(_mm256_mullo_epi16(v, vmul), low_bytes);
+            __m256i odd = _mm256_slli_epi16(
+                _mm256_mullo_epi16(_mm256_srli_epi16(v, 8), vmul), 8);
+            v = _mm256_or_si256(even, odd);
+        }
+        v = _mm256_add_epi8(v, vadd);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), v);
+    }
+    affine_scalar(data + i, size - i, mul, add);
+}
+
+__attribute__((target("avx512f,avx512bw,bmi2")))
+void affine_avx512(unsigned char* data, size_t size, std::uint8_t mul, std::uint8_t add){
+    const __m512i vmul = _mm512_set1_epi16(mul);
+    const __m512i vadd = _mm512_set1_epi8(static_cast<char>(add));
+    const __mmask64 odd_bytes = 0xAAAAAAAAAAAAAAAAull;
+    size_t i{};
+    for(; i + 64 <= size; i += 64){
+        __m512i v = _mm512_loadu_si512(data + i);
+        if(mul != 1){
+            __m512i even = _mm512_mullo_epi16(v, vmul);
+            __m512i odd = _mm512_slli_epi16(_mm512_mullo_epi16(_mm512_srli_epi16(v, 8), vmul), 8);
+            v = _mm512_mask_blend_epi8(odd_bytes, even, odd);
+        }
+        v = _mm512_add_epi8(v, vadd);
+        _mm512_storeu_si512(data + i, v);
+    }
+    //Masked load/store handle the tail without a scalar loop
+    if(i < size){
+        __mmask64 tail = _bzhi_u64(~0ull, static_cast<unsigned>(size - i));
+        __m512i v = _mm512_maskz_loadu_epi8(tail, data + i);
+        if(mul != 1){
+            __m512i even = _mm512_mullo_epi16(v, vmul);
+            __m512i odd = _mm512_slli_epi16(_mm512_mullo_epi16(_mm512_srli_epi16(v, 8), vmul), 8);
+            v = _mm512_mask_blend_epi8(odd_bytes, even, odd);
+        }
+        v = _mm512_add_epi8(v, vadd);
+        _mm512_mask_storeu_epi8(data + i, tail, v);
+    }
+}
+
+//No AVX2 table kernel : emulating a 256 entry lookup with 16 entry vpshufb
+//lookups takes 16 shuffles per 32 bytes, which measured slower than the
+//scalar loop. AVX2 and SSE2 lookups stay scalar.
+
+//Table lookup with AVX-512 VBMI : vpermi2b looks up a 128 entry table held
+//in two registers. Two of those cover the whole table, the top bit of each
+//byte picks which half to keep.
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+inline __m512i lookup_avx512(const __m512i (&quarters)[4], __m512i v){
+    __m512i low_half = _mm512_permutex2var_epi8(quarters[0], v, quarters[1]);
+    __m512i high_half = _mm512_permutex2var_epi8(quarters[2], v, quarters[3]);
+    return _mm512_mask_blend_epi8(_mm512_movepi8_mask(v), low_half, high_half);
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi,bmi2")))
+void table_avx512(unsigned char* data, size_t size, const ByteTable& table){
+    const __m512i quarters[4] {
+        _mm512_loadu_si512(table.data()),
+        _mm512_loadu_si512(table.data() + 64),
+        _mm512_loadu_si512(table.data() + 128),
+        _mm512_loadu_si512(table.data() + 192)
+    };
+    size_t i{};
+    for(; i + 64 <= size; i += 64){
+        __m512i v = _mm512_loadu_si512(data + i);
+        _mm512_storeu_si512(data + i, lookup_avx512(quarters, v));
+    }
+    if(i < size){
+        __mmask64 tail = _bzhi_u64(~0ull, static_cast<unsigned>(size - i));
+        __m512i v = _mm512_maskz_loadu_epi8(tail, data + i);
+        _mm512_mask_storeu_epi8(data + i, tail, lookup_avx512(quarters, v));
+    }
+}
+
+//The table kernel needs VBMI on top of what the avx512 level guarantees
+bool has_avx512vbmi(){
+    static const bool supported = []{
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512vbmi") != 0;
+    }();
+    return supported;
+}
+
+#endif // TRANSFORM_BYTES_X86
+
+} // namespace
+
+
+SimdLevel detected_simd_level(){
+#ifdef TRANSFORM_BYTES_X86
+    static const SimdLevel level = []{
+        __builtin_cpu_init();
+        //What the affine kernel uses. The table kernel checks VBMI itself.
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+           __builtin_cpu_supports("bmi2"))
+            return SimdLevel::avx512;
+        if(__builtin_cpu_supports("avx2"))
+            return SimdLevel::avx2;
+        if(__builtin_cpu_supports("sse2"))
+            return SimdLevel::sse2;
+        return SimdLevel::scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+const char* to_string(SimdLevel level){
+    switch(level){
+        case SimdLevel::scalar : return "scalar";
+        case SimdLevel::sse2 : return "SSE2";
+        case SimdLevel::avx2 : return "AVX2";
+        case SimdLevel::avx512 : return "AVX-512";
+    }
+    return "unknown";
+}
+
+void transform_bytes_affine(std::span<char> bytes, std::uint8_t mul, std::uint8_t add,
+                                SimdLevel level){
+    auto data = reinterpret_cast<unsigned char*>(bytes.data());
+    size_t size = bytes.size();
+#ifdef TRANSFORM_BYTES_X86
+    switch(level){
+        case SimdLevel::avx512 : affine_avx512(data, size, mul, add); return;
+        case SimdLevel::avx2 : affine_avx2(data, size, mul, add); return;
+        case SimdLevel::sse2 : affine_sse2(data, size, mul, add); return;
+        case SimdLevel::scalar : break;
+    }
+#else
+    (void)level;
+#endif
+    affine_scalar(data, size, mul, add);
+}
+
+void transform_bytes_table(std::span<char> bytes, const ByteTable& table, SimdLevel level){
+    auto data = reinterpret_cast<unsigned char*>(bytes.data());
+    size_t size = bytes.size();
+#ifdef TRANSFORM_BYTES_X86
+    switch(level){
+        case SimdLevel::avx512 :
+            if(has_avx512vbmi()){
+                table_avx512(data, size, table);
+                return;
+            }
+            break;
+        //See above : a scalar table lookup beats what these can do
+        case SimdLevel::avx2 :
+        case SimdLevel::sse2 :
+        case SimdLevel::scalar : break;
+    }
+#else
+    (void)level;
+#endif
+    table_scalar(data, size, table);
+}
@@ -0,0 +1,152 @@
+#ifndef TRANSFORM_BYTES_H
+#define TRANSFORM_BYTES_H
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//Bulk version of modify() : applies a per character functor to a whole span
+//of characters. When the functor can be evaluated at compile time, its
+//effect on all 256 possible byte values is computed by the compiler and
+//the loop is replaced by a SIMD kernel :
+//  - affine transforms ( c * mul + add, like Encrypt/Decrypt ) use byte
+//    arithmetic on 16/32/64 bytes at a time.
+//  - anything else goes through a 256 entry lookup table, done with byte
+//    permutes when the CPU has AVX-512 VBMI, with a scalar loop otherwise.
+//Any other functor is called on every byte : it may count, log or change as
+//it goes. Wrap it in pure_byte_function to promise it doesn't, and large
+//spans get its table built at run time instead.
+
+//Which instruction set the kernels use. Picked once at run time from what
+//the CPU supports, but can be forced for testing and benchmarking.
+enum class SimdLevel { scalar, sse2, avx2, avx512 };
+
+SimdLevel detected_simd_level();
+const char* to_string(SimdLevel level);
+
+using ByteTable = std::array<std::uint8_t, 256>;
+
+//Description of a byte transform worked out from its table
+struct ByteTransformShape
+{
+    enum class Kind { identity, affine, table };
+    Kind kind;
+    std::uint8_t mul; // Only meaningful for affine transforms
+    std::uint8_t add;
+};
+
+constexpr ByteTransformShape classify_byte_table(const ByteTable& table){
+    //If the transform is c * mul + add (mod 256), f(0) gives add and
+    //f(1) gives mul + add. Check the guess against the whole table.
+    std::uint8_t add = table[0];
+    std::uint8_t mul = static_cast<std::uint8_t>(table[1] - add);
+    for(size_t i{}; i < table.size(); ++i){
+        if(table[i] != static_cast<std::uint8_t>(i * mul + add))
+            return {ByteTransformShape::Kind::table, 0, 0};
+    }
+    if(mul == 1 && add == 0)
+        return {ByteTransformShape::Kind::identity, 1, 0};
+    return {ByteTransformShape::Kind::affine, mul, add};
+}
+
+//Runs the functor on every byte value. Usable at compile time for constexpr
+//functors, and at run time for any pure functor.
+template <typename Functor>
+constexpr ByteTable make_byte_table(Functor functor){
+    ByteTable table{};
+    for(size_t i{}; i < table.size(); ++i){
+        table[i] = static_cast<std::uint8_t>(functor(static_cast<char>(i)));
+    }
+    return table;
+}
+
+//A functor we can construct and call in a constant expression. It must also
+//be stateless : the table is built from Functor{}, so a functor with data
+//members, like ShiftBy{1}, would be evaluated with their default values
+//instead of the ones of the object passed in. Wrap those in
+//pure_byte_function.
+template <typename Functor>
+concept ConstexprByteFunctor = std::is_empty_v<Functor> && std::default_initializable<Functor> &&
+    requires { typename std::integral_constant<char, Functor{}(char{})>; };
+
+//Promise that the result only depends on the byte passed in : no side
+//effects, no state changing between calls. transform_bytes() may then call
+//it 256 times to build a table instead of once per byte :
+//    transform_bytes(data, pure_byte_function{ShiftBy{amount}});
+template <typename Functor>
+struct pure_byte_function
+{
+    Functor functor;
+
+    constexpr char operator()(char c) const{
+        return static_cast<char>(functor(c));
+    }
+};
+
+template <typename Functor>
+pure_byte_function(Functor) -> pure_byte_function<Functor>;
+
+template <typename Functor>
+inline constexpr bool is_pure_byte_function = false;
+
+template <typename Functor>
+inline constexpr bool is_pure_byte_function<pure_byte_function<Functor>> = true;
+
+//Below this size, building a table at run time ( 256 calls ) costs more
+//than it saves
+inline constexpr size_t RUNTIME_TABLE_MIN_SIZE {4096};
+
+template <ConstexprByteFunctor Functor>
+inline constexpr ByteTable byte_table_for = make_byte_table(Functor{});
+
+//The kernels. They work on raw bytes, defined in transform_bytes.cpp
+void transform_bytes_affine(std::span<char> bytes, std::uint8_t mul, std::uint8_t add,
+                                SimdLevel level = detected_simd_level());
+void transform_bytes_table(std::span<char> bytes, const ByteTable& table,
+                                SimdLevel level = detected_simd_level());
+
+
+//Runtime known mapping, for example built with make_byte_table() from a
+//functor whose behavior depends on its data members.
+inline void transform_bytes(std::span<char> bytes, const ByteTable& table){
+    ByteTransformShape shape = classify_byte_table(table);
+    if(shape.kind == ByteTransformShape::Kind::affine)
+        transform_bytes_affine(bytes, shape.mul, shape.add);
+    else if(shape.kind == ByteTransformShape::Kind::table)
+        transform_bytes_table(bytes, table);
+}
+
+template <typename Functor>
+void transform_bytes(std::span<char> bytes, Functor functor){
+    if constexpr (ConstexprByteFunctor<Functor>){
+        constexpr ByteTransformShape shape = classify_byte_table(byte_table_for<Functor>);
+        if constexpr (shape.kind == ByteTransformShape::Kind::identity){
+            return;
+        }else if constexpr (shape.kind == ByteTransformShape::Kind::affine){
+            transform_bytes_affine(bytes, shape.mul, shape.add);
+        }else{
+            transform_bytes_table(bytes, byte_table_for<Functor>);
+        }
+    }else if constexpr (is_pure_byte_function<Functor>){
+        //Promised pure : its table is built at run time, from this very object.
+        //Same result either way, only the speed changes with the size.
+        if(bytes.size() >= RUNTIME_TABLE_MIN_SIZE){
+            transform_bytes(bytes, make_byte_table<const Functor&>(functor));
+            return;
+        }
+        for(char& c : bytes){
+            c = functor(c);
+        }
+    }else{
+        //No promise : even a const call operator may have side effects, so
+        //call it on every byte, in order
+        for(char& c : bytes){
+            c = functor(c);
+        }
+    }
+}
+
+#endif // TRANSFORM_BYTES_H
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <forward_list>
+#include <list>
+#include <set>
+#include <map>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include "pool_allocator.h"
+
+
+template <typename T>
+void print_collection(const T& collection){
+    std::cout << " Collection [";
+    for(const auto& elt : collection){
+        std::cout << " " << elt ;
+    }
+    std::cout << "]" << std::endl;
+}
+
+//Time a piece of code, in milliseconds
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+//Insert, iterate, erase half, insert again : the same workload for a
+//container with the default allocator and with the pool.
+template <typename Container, typename Insert>
+void benchmark(const std::string& label, Container container,
+                    const std::vector<int>& keys, Insert insert){
+    long long sum {};
+    double insert_ms = time_ms([&]{
+        for(int key : keys)
+            insert(container, key);
+    });
+    double iterate_ms = time_ms([&]{
+        for(int round{}; round < 5; ++round){
+            for(const auto& elt : container){
+                if constexpr (requires { elt.first; })
+                    sum += elt.first;
+                else
+                    sum += elt;
+            }
+        }
+    });
+    double erase_ms = time_ms([&]{
+        //Erase every other element, then insert as many back
+        bool erase {true};
+        for(auto it = container.begin(); it != container.end(); ){
+            if constexpr (requires { container.erase_after(container.before_begin()); }){
+                it = (erase && std::next(it) != container.end()) ? container.erase_after(it) : std::next(it);
+            }else{
+                it = erase ? container.erase(it) : std::next(it);
+            }
+            erase = !erase;
+        }
+        for(size_t i{}; i < keys.size() / 2; ++i)
+            insert(container, keys[i]);
+    });
+    std::cout << "  " << label << " insert : " << insert_ms << " ms, iterate x5 : "
+              << iterate_ms << " ms, erase/reinsert : " << erase_ms << " ms (sum "
+              << sum << ")" << std::endl;
+}
+
+
+//Static : destroyed after main returns, and after the thread_locals of the
+//main thread. Its nodes still go back to a live pool.
+std::list<int, PoolAllocator<int>> history {1,2,3};
+
+
+int main(){
+
+    //The containers from the previous lectures, with the pool as allocator
+    std::forward_list<int, PoolAllocator<int>> numbers_fl {5,4,3,2,1};
+    std::list<int, PoolAllocator<int>> numbers_list {1,2,3,4,5};
+    std::set<int, std::less<int>, PoolAllocator<int>> numbers_set {5,1,4,2,3};
+    std::map<int, std::string, std::less<int>,
+                PoolAllocator<std::pair<const int, std::string>>> map {{1,"Moria"},{2,"Ruth"}};
+    std::multiset<int, std::less<int>, PoolAllocator<int>> numbers_multiset {1,1,2,2,3};
+
+    print_collection(numbers_fl);
+    print_collection(numbers_list);
+    print_collection(numbers_set);
+    print_collection(numbers_multiset);
+    history.push_back(4);
+    print_collection(history);
+    for(const auto& [key, value] : map){
+        std::cout << " [" << key << "," << value << "]";
+    }
+    std::cout << std::endl;
+
+    //Consecutive insertions land next to each other in memory
+    std::cout << "Distance between list nodes : ";
+    const int* previous {nullptr};
+    for(const int& value : numbers_list){
+        if(previous)
+            std::cout << (reinterpret_cast<const char*>(&value) -
+                          reinterpret_cast<const char*>(previous)) << " ";
+        previous = &value;
+    }
+    std::cout << "bytes" << std::endl;
+
+
+    std::cout << "----------" << std::endl;
+
+    //An explicit resource : all its slabs go away in one shot when it dies
+    {
+        PoolResource pool;
+        PoolAllocator<int> allocator {&pool};
+        std::list<int, PoolAllocator<int>> scratch(allocator);
+        for(int i{}; i < 10'000; ++i)
+            scratch.push_back(i);
+        std::cout << "Scratch list size : " << scratch.size() << std::endl;
+        //scratch is destroyed before pool : order of declaration matters.
+    }
+
+    //Asking for more elements than fit in memory throws, like new int[n]
+    try{
+        PoolAllocator<long long>{}.allocate(static_cast<size_t>(-1) / 4);
+    }catch(const std::bad_array_new_length&){
+        std::cout << "Huge allocate : std::bad_array_new_length" << std::endl;
+    }
+
+
+    std::cout << "----------" << std::endl;
+
+    //Benchmark : keys in random order, so tree nodes get inserted all over
+    //the tree and iteration order differs from allocation order.
+    const size_t count {1'000'000};
+    std::vector<int> keys(count);
+    for(size_t i{}; i < count; ++i)
+        keys[i] = static_cast<int>(i);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+
+    auto push_front = [](auto& c, int key){ c.push_front(key); };
+    auto push_back = [](auto& c, int key){ c.push_back(key); };
+    auto insert_key = [](auto& c, int key){ c.insert(key); };
+    auto insert_pair = [](auto& c, int key){ c.emplace(key, key); };
+
+    std::cout << std::endl;
+    std::cout << "forward_list : " << std::endl;
+    benchmark("default", std::forward_list<int>{}, keys, push_front);
+    benchmark("pool   ", std::forward_list<int, PoolAllocator<int>>{}, keys, push_front);
+
+    std::cout << "list : " << std::endl;
+    benchmark("default", std::list<int>{}, keys, push_back);
+    benchmark("pool   ", std::list<int, PoolAllocator<int>>{}, keys, push_back);
+
+    std::cout << "set : " << std::endl;
+    benchmark("default", std::set<int>{}, keys, insert_key);
+    benchmark("pool   ", std::set<int, std::less<int>, PoolAllocator<int>>{}, keys, insert_key);
+
+    std::cout << "map : " << std::endl;
+    benchmark("default", std::map<int, int>{}, keys, insert_pair);
+    benchmark("pool   ", std::map<int, int, std::less<int>,
+                        PoolAllocator<std::pair<const int, int>>>{}, keys, insert_pair);
+
+    std::cout << "multimap : " << std::endl;
+    benchmark("default", std::multimap<int, int>{}, keys, insert_pair);
+    benchmark("pool   ", std::multimap<int, int, std::less<int>,
+                        PoolAllocator<std::pair<const int, int>>>{}, keys, insert_pair);
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include "pool_resource.h"
+
+//Standard allocator interface on top of a PoolResource. Plug it in as the
+//Allocator argument of a container :
+//    std::list<int, PoolAllocator<int>> numbers;               // Thread's pool
+//    std::map<int, int, std::less<int>,
+//             PoolAllocator<std::pair<const int, int>>> m(PoolAllocator<...>(&pool));
+//The container rebinds it to its node type, so the pool sees node sized requests.
+//A default constructed PoolAllocator uses the calling thread's pool. Such a
+//container may be static or global, the pool outlives it, but must not be
+//used from two threads at the same time.
+template <typename T>
+class PoolAllocator
+{
+    template <typename U> friend class PoolAllocator;
+
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept
+        : m_resource(&PoolResource::thread_instance())
+    {
+    }
+
+    explicit PoolAllocator(PoolResource* resource) noexcept
+        : m_resource(resource)
+    {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : m_resource(other.m_resource)
+    {
+    }
+
+    T* allocate(size_t n){
+        //Same check as new T[n] does
+        if(n > static_cast<size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n) noexcept{
+        m_resource->deallocate(pointer, n * sizeof(T), alignof(T));
+    }
+
+    PoolResource* resource() const { return m_resource; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept{
+        return m_resource == other.m_resource;
+    }
+
+private:
+    PoolResource* m_resource;
+};
+
+#endif // POOL_ALLOCATOR_H
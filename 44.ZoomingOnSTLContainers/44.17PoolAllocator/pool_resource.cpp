@@ -0,0 +1,117 @@
+#include "pool_resource.h"
+#include <new>
+#include <utility>
+#include <iterator>
+
+FixedBlockPool::FixedBlockPool(size_t block_size, size_t blocks_per_slab)
+    : m_block_size(block_size < sizeof(FreeBlock) ? sizeof(FreeBlock) : block_size),
+      m_blocks_per_slab(blocks_per_slab)
+{
+}
+
+FixedBlockPool::FixedBlockPool(FixedBlockPool&& source) noexcept
+    : m_block_size(source.m_block_size),
+      m_blocks_per_slab(source.m_blocks_per_slab),
+      m_slabs(std::move(source.m_slabs)),
+      m_bump(std::exchange(source.m_bump, nullptr)),
+      m_bump_end(std::exchange(source.m_bump_end, nullptr)),
+      m_free_list(std::exchange(source.m_free_list, nullptr))
+{
+    source.m_slabs.clear();
+}
+
+FixedBlockPool& FixedBlockPool::operator=(FixedBlockPool&& source) noexcept
+{
+    if(this != &source){
+        release();
+        m_block_size = source.m_block_size;
+        m_blocks_per_slab = source.m_blocks_per_slab;
+        m_slabs = std::move(source.m_slabs);
+        source.m_slabs.clear();
+        m_bump = std::exchange(source.m_bump, nullptr);
+        m_bump_end = std::exchange(source.m_bump_end, nullptr);
+        m_free_list = std::exchange(source.m_free_list, nullptr);
+    }
+    return *this;
+}
+
+FixedBlockPool::~FixedBlockPool()
+{
+    release();
+}
+
+void FixedBlockPool::add_slab()
+{
+    //operator new hands back memory aligned for any fundamental type, and
+    //block sizes are multiples of PoolResource::GRANULARITY, so every block
+    //in the slab stays aligned as well.
+    size_t slab_size = m_block_size * m_blocks_per_slab;
+    m_slabs.reserve(m_slabs.size() + 1); // Don't leak the slab if push_back throws
+    auto slab = static_cast<std::byte*>(::operator new(slab_size));
+    m_slabs.push_back(slab);
+    m_bump = slab;
+    m_bump_end = slab + slab_size;
+}
+
+void FixedBlockPool::release()
+{
+    for(std::byte* slab : m_slabs){
+        ::operator delete(slab);
+    }
+    m_slabs.clear();
+    m_bump = m_bump_end = nullptr;
+    m_free_list = nullptr;
+}
+
+
+PoolResource::PoolResource(size_t blocks_per_slab)
+{
+    for(size_t i{}; i < std::size(m_pools); ++i){
+        m_pools[i] = FixedBlockPool((i + 1) * GRANULARITY, blocks_per_slab);
+    }
+}
+
+void* PoolResource::allocate(size_t size, size_t alignment)
+{
+    if(!pooled(size, alignment))
+        return ::operator new(size, std::align_val_t(alignment));
+    void* block = m_pools[size_class(size)].allocate();
+    ++m_live_blocks;
+    return block;
+}
+
+void PoolResource::deallocate(void* pointer, size_t size, size_t alignment)
+{
+    if(!pooled(size, alignment)){
+        ::operator delete(pointer, size, std::align_val_t(alignment));
+        return;
+    }
+    m_pools[size_class(size)].deallocate(pointer);
+    --m_live_blocks;
+}
+
+void PoolResource::release()
+{
+    for(FixedBlockPool& pool : m_pools){
+        pool.release();
+    }
+    m_live_blocks = 0;
+}
+
+PoolResource& PoolResource::thread_instance()
+{
+    //A plain thread_local PoolResource would die before the static objects
+    //of the main thread : a static std::list<int, PoolAllocator<int>> would
+    //then give its nodes back to a destroyed resource. Keep it on the heap
+    //and only delete it when nothing points into its slabs any more.
+    struct Holder
+    {
+        PoolResource* resource {new PoolResource};
+        ~Holder(){
+            if(resource->m_live_blocks == 0)
+                delete resource;
+        }
+    };
+    thread_local Holder holder;
+    return *holder.resource;
+}
@@ -0,0 +1,109 @@
+#ifndef POOL_RESOURCE_H
+#define POOL_RESOURCE_H
+
+#include <cstddef>
+#include <vector>
+
+//Memory for node based containers ( forward_list, list, set, map, ...).
+//Those containers allocate one small node per element. Instead of going to
+//the global heap each time, we carve the nodes out of big slabs :
+//  - nodes inserted one after the other sit next to each other in memory,
+//    so walking the container touches far fewer cache lines.
+//  - freed nodes go on a free list and are reused by the next insertions.
+//  - all slabs are released at once, when the resource dies or on release().
+//A PoolResource is not thread safe : use one per thread. thread_instance()
+//gives each thread its own.
+
+//A pool of equally sized blocks
+class FixedBlockPool
+{
+public:
+    FixedBlockPool() = default;
+    explicit FixedBlockPool(size_t block_size, size_t blocks_per_slab = 1024);
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+    FixedBlockPool(FixedBlockPool&& source) noexcept;
+    FixedBlockPool& operator=(FixedBlockPool&& source) noexcept;
+    ~FixedBlockPool();
+
+    void* allocate(){
+        if(m_free_list){
+            FreeBlock* block = m_free_list;
+            m_free_list = block->next;
+            return block;
+        }
+        if(m_bump == m_bump_end)
+            add_slab();
+        void* block = m_bump;
+        m_bump += m_block_size;
+        return block;
+    }
+
+    void deallocate(void* block){
+        auto free_block = static_cast<FreeBlock*>(block);
+        free_block->next = m_free_list;
+        m_free_list = free_block;
+    }
+
+    //Gives all slabs back to the heap. Every block handed out becomes invalid.
+    void release();
+
+    size_t block_size() const { return m_block_size; }
+    size_t slab_count() const { return m_slabs.size(); }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    void add_slab();
+
+private:
+    size_t m_block_size {};
+    size_t m_blocks_per_slab {};
+    std::vector<std::byte*> m_slabs;
+    std::byte* m_bump {nullptr};     // Next never used block in the newest slab
+    std::byte* m_bump_end {nullptr};
+    FreeBlock* m_free_list {nullptr};
+};
+
+
+//A set of pools, one per size class. Requests bigger than the largest class
+//go straight to the global heap.
+class PoolResource
+{
+public:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t MAX_BLOCK_SIZE = 256;
+
+    explicit PoolResource(size_t blocks_per_slab = 1024);
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+    void deallocate(void* pointer, size_t size, size_t alignment);
+
+    //Frees every slab of every size class
+    void release();
+
+    //One resource per thread, used by default constructed PoolAllocators.
+    //It outlives the thread's other thread_locals and the static objects :
+    //when the thread ends it is freed only if no block is still handed out,
+    //otherwise it is left alive for the containers that still hold them.
+    static PoolResource& thread_instance();
+
+private:
+    static bool pooled(size_t size, size_t alignment){
+        return size <= MAX_BLOCK_SIZE && alignment <= GRANULARITY;
+    }
+    static size_t size_class(size_t size){
+        return size == 0 ? 0 : (size - 1) / GRANULARITY;
+    }
+
+private:
+    FixedBlockPool m_pools[MAX_BLOCK_SIZE / GRANULARITY];
+    size_t m_live_blocks {};         // Pooled blocks handed out and not given back
+};
+
+#endif // POOL_RESOURCE_H
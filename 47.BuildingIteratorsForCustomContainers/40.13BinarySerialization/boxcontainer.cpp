@@ -0,0 +1,4 @@
+#include "boxcontainer.h"
+
+
+
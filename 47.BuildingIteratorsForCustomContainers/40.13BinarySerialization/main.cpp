@@ -0,0 +1,215 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include "boxcontainer.h"
+#include "serialization.h"
+
+//Trivially copyable, no pointers : stored as its 16 bytes
+class Point
+{
+	friend std::ostream& operator<<(std::ostream& os, const Point& p);
+	
+public:
+	Point() = default;
+	Point(double x, double y) : 
+		m_x(x), m_y(y){
+	}
+
+	bool operator==(const Point&) const = default;
+	double x() const { return m_x; }
+	double y() const { return m_y; }
+
+private : 
+	double m_x{}; 
+	double m_y{}; 
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Point& p){
+	os << "Point [ x : " << p.m_x << ", y : " << p.m_y << "]";	
+	return os;
+}
+
+//Private members : reflection can't check them, say it is plain data
+template <>
+inline constexpr bool enable_raw_serialization<Point> = true;
+
+//Aggregate : its fields are found by reflect.h
+struct Student{
+    friend std::ostream& operator<<(std::ostream& out, const Student& s){
+        out << "Student [ name : " << s.m_name << ", age : " << s.m_age << "]";
+        return out;
+    }
+    auto operator <=>(const Student& s) const= default;
+    std::string m_name;
+    unsigned int m_age;
+};
+
+//Private data and a constructor : says how it is stored itself
+class Book{
+    friend std::ostream& operator<< (std::ostream& out, const Book& operand);
+public : 
+    Book() = default;
+    Book(int year, std::string title) 
+        : m_year(year),m_title(title)
+        {
+        }
+
+    bool operator==(const Book&) const = default;
+
+    void serialize(BinaryWriter& writer) const{
+        ::serialize(writer, m_year);
+        ::serialize(writer, m_title);
+    }
+    static Book deserialize(BinaryReader& reader){
+        int year = ::deserialize<int>(reader);
+        return Book(year, ::deserialize<std::string>(reader));
+    }
+    
+private : 
+    int m_year{};
+    std::string m_title;
+};
+
+std::ostream& operator<< (std::ostream& out, const Book& operand){
+    out << "Book [" << operand.m_year << ", " << operand.m_title << "]";
+    return out;
+}
+
+
+template <typename T>
+bool same_items(const BoxContainer<T>& left, const BoxContainer<T>& right){
+    if(left.size() != right.size())
+        return false;
+    for(size_t i{}; i < left.size(); ++i){
+        if(!(left.data()[i] == right.data()[i]))
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+void check_round_trip(const char* name, const BoxContainer<T>& box){
+    std::vector<std::byte> bytes = to_bytes(box);
+    BoxContainer<T> copy = from_bytes<BoxContainer<T>>(bytes);
+    std::cout << name << " : " << bytes.size() << " bytes, round trip "
+              << (same_items(box, copy) ? "ok" : "FAILED") << std::endl;
+    std::cout << "    " << copy << std::endl;
+}
+
+template <typename Function>
+double time_ms(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+int main(int argc, char** argv){
+
+    BoxContainer<Point> points(3);
+    points.add(Point(1.5, 2));
+    points.add(Point(-3, 0.1));
+    points.add(Point(1e300, 4));
+    check_round_trip("BoxContainer<Point>", points);
+
+    BoxContainer<Student> students(3);
+    students.add(Student{"Daniel", 21});
+    students.add(Student{"Eva", 19});
+    students.add(Student{"", 30});
+    check_round_trip("BoxContainer<Student>", students);
+
+    BoxContainer<Book> books(2);
+    books.add(Book(1967, "One Hundred Years of Solitude"));
+    books.add(Book(1949, "1984"));
+    check_round_trip("BoxContainer<Book>", books);
+
+    //Corrupt data fails cleanly, it doesn't read out of bounds
+    std::vector<std::byte> bytes = to_bytes(students);
+    try{
+        bytes.resize(bytes.size() - 3);
+        from_bytes<BoxContainer<Student>>(bytes);
+    }catch(const serialization_error& error){
+        std::cout << "Truncated data : " << error.what() << std::endl;
+    }
+    try{
+        bytes[0] = std::byte{0xFF}; // Item count : huge
+        from_bytes<BoxContainer<Student>>(bytes);
+    }catch(const serialization_error& error){
+        std::cout << "Corrupt count : " << error.what() << std::endl;
+    }
+
+    //Don't compile : pointers have no meaning in a file, and these hold some
+    //to_bytes(BoxContainer<int*>());
+    //to_bytes(BoxContainer<std::string_view>());
+    //struct Named { const char* name; int id; };
+    //to_bytes(BoxContainer<Named>());
+
+    std::cout << "----------" << std::endl;
+
+    //Throughput : a big box of points, through text and through the binary format
+    size_t count = (argc > 1) ? std::stoul(argv[1]) : 10'000'000;
+    const std::string directory = std::filesystem::temp_directory_path().string();
+    const std::string text_path = directory + "/points.txt";
+    const std::string binary_path = directory + "/points.bin";
+
+    BoxContainer<Point> box(count);
+    for(size_t i{}; i < count; ++i)
+        box.add(Point(static_cast<double>(i) * 0.25, static_cast<double>(i % 1000) - 0.5));
+
+    auto report = [&](const char* name, double ms, const std::string& path){
+        double megabytes = static_cast<double>(std::filesystem::file_size(path)) / 1e6;
+        std::cout << name << " : " << ms << " ms, " << megabytes << " MB, "
+                  << megabytes / ms * 1000.0 << " MB/s" << std::endl;
+    };
+
+    //Text : full precision, so that it reads back the same
+    report("text save     ", time_ms([&]{
+        std::ofstream out(text_path);
+        out.precision(17);
+        out << box.size() << '\n';
+        for(size_t i{}; i < box.size(); ++i)
+            out << box.data()[i].x() << ' ' << box.data()[i].y() << '\n';
+    }), text_path);
+
+    bool text_ok {};
+    report("text load     ", time_ms([&]{
+        std::ifstream in(text_path);
+        size_t size {};
+        in >> size;
+        BoxContainer<Point> loaded(size);
+        double x, y;
+        for(size_t i{}; i < size && in >> x >> y; ++i)
+            loaded.add(Point(x, y));
+        text_ok = same_items(box, loaded);
+    }), text_path);
+
+    report("binary save   ", time_ms([&]{
+        save(binary_path, box);
+    }), binary_path);
+
+    bool binary_ok {};
+    report("binary load   ", time_ms([&]{
+        BoxContainer<Point> loaded = load<BoxContainer<Point>>(binary_path);
+        binary_ok = same_items(box, loaded);
+    }), binary_path);
+
+    //No load at all : the items are read in place, as the loop reaches them
+    double sum {};
+    report("mapped, sum x ", time_ms([&]{
+        MappedBox<Point> view(binary_path);
+        for(const Point& point : view)
+            sum += point.x();
+    }), binary_path);
+    std::cout << "Round trips equal : text " << std::boolalpha << text_ok
+              << ", binary " << binary_ok << " (checksum " << sum << ")" << std::endl;
+
+    std::filesystem::remove(text_path);
+    std::filesystem::remove(binary_path);
+
+    return 0;
+}
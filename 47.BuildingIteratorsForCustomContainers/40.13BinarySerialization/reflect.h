@@ -0,0 +1,120 @@
+#ifndef REFLECT_H
+#define REFLECT_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+//Just enough compile time reflection to walk the fields of an aggregate,
+//like Student { std::string m_name; unsigned int m_age; }, without writing
+//anything for it :
+//    for_each_field(student, [](auto& field){ ... });
+//The field count is found by trying to brace initialize T with more and more
+//arguments that convert to anything. The fields are then reached with a
+//structured binding of that size. Aggregates of up to 8 fields, without
+//base classes or array members ( their elements would be counted as fields ).
+
+//Converts to any type : stands in for one initializer of a field
+struct any_field
+{
+    template <typename T>
+    constexpr operator T() const;  // Never defined, only used unevaluated
+};
+
+template <typename T, typename... Fields>
+constexpr size_t count_fields(){
+    if constexpr (sizeof...(Fields) > 8)
+        return 0;
+    else if constexpr (requires { T{Fields{}..., any_field{}}; })
+        return count_fields<T, Fields..., any_field>();
+    else
+        return sizeof...(Fields);
+}
+
+template <typename T>
+inline constexpr size_t field_count = count_fields<T>();
+
+template <typename T>
+concept Reflectable = std::is_aggregate_v<T> && !std::is_array_v<T>
+                      && field_count<T> > 0 && field_count<T> <= 8;
+
+template <Reflectable T, typename Function>
+void for_each_field(T& object, Function&& function){
+    constexpr size_t count = field_count<std::remove_const_t<T>>;
+    if constexpr (count == 1){
+        auto& [a] = object;
+        function(a);
+    }else if constexpr (count == 2){
+        auto& [a, b] = object;
+        function(a); function(b);
+    }else if constexpr (count == 3){
+        auto& [a, b, c] = object;
+        function(a); function(b); function(c);
+    }else if constexpr (count == 4){
+        auto& [a, b, c, d] = object;
+        function(a); function(b); function(c); function(d);
+    }else if constexpr (count == 5){
+        auto& [a, b, c, d, e] = object;
+        function(a); function(b); function(c); function(d); function(e);
+    }else if constexpr (count == 6){
+        auto& [a, b, c, d, e, f] = object;
+        function(a); function(b); function(c); function(d); function(e); function(f);
+    }else if constexpr (count == 7){
+        auto& [a, b, c, d, e, f, g] = object;
+        function(a); function(b); function(c); function(d); function(e); function(f); function(g);
+    }else{
+        auto& [a, b, c, d, e, f, g, h] = object;
+        function(a); function(b); function(c); function(d); function(e); function(f); function(g); function(h);
+    }
+}
+
+//The types of the fields, without reference or const :
+//    decltype(field_types<Student>())  is  type_list<std::string, unsigned int>
+//Only meant for decltype : never called.
+template <typename... Types>
+struct type_list {};
+
+template <Reflectable T>
+auto field_types(){
+    constexpr size_t count = field_count<T>;
+    T& object = *static_cast<T*>(nullptr);
+    if constexpr (count == 1){
+        auto& [a] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>>{};
+    }else if constexpr (count == 2){
+        auto& [a, b] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>, std::remove_cvref_t<decltype(b)>>{};
+    }else if constexpr (count == 3){
+        auto& [a, b, c] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>, std::remove_cvref_t<decltype(b)>,
+                         std::remove_cvref_t<decltype(c)>>{};
+    }else if constexpr (count == 4){
+        auto& [a, b, c, d] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>, std::remove_cvref_t<decltype(b)>,
+                         std::remove_cvref_t<decltype(c)>, std::remove_cvref_t<decltype(d)>>{};
+    }else if constexpr (count == 5){
+        auto& [a, b, c, d, e] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>, std::remove_cvref_t<decltype(b)>,
+                         std::remove_cvref_t<decltype(c)>, std::remove_cvref_t<decltype(d)>,
+                         std::remove_cvref_t<decltype(e)>>{};
+    }else if constexpr (count == 6){
+        auto& [a, b, c, d, e, f] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>, std::remove_cvref_t<decltype(b)>,
+                         std::remove_cvref_t<decltype(c)>, std::remove_cvref_t<decltype(d)>,
+                         std::remove_cvref_t<decltype(e)>, std::remove_cvref_t<decltype(f)>>{};
+    }else if constexpr (count == 7){
+        auto& [a, b, c, d, e, f, g] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>, std::remove_cvref_t<decltype(b)>,
+                         std::remove_cvref_t<decltype(c)>, std::remove_cvref_t<decltype(d)>,
+                         std::remove_cvref_t<decltype(e)>, std::remove_cvref_t<decltype(f)>,
+                         std::remove_cvref_t<decltype(g)>>{};
+    }else{
+        auto& [a, b, c, d, e, f, g, h] = object;
+        return type_list<std::remove_cvref_t<decltype(a)>, std::remove_cvref_t<decltype(b)>,
+                         std::remove_cvref_t<decltype(c)>, std::remove_cvref_t<decltype(d)>,
+                         std::remove_cvref_t<decltype(e)>, std::remove_cvref_t<decltype(f)>,
+                         std::remove_cvref_t<decltype(g)>, std::remove_cvref_t<decltype(h)>>{};
+    }
+}
+
+#endif // REFLECT_H
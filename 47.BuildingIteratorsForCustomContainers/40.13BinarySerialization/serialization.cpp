@@ -0,0 +1,114 @@
+#include "serialization.h"
+#include <fstream>
+#include <iterator>
+
+#if defined(__linux__)
+#define SERIALIZATION_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace{
+
+constexpr size_t WRITER_BUFFER_SIZE {1 << 20};
+
+} // namespace
+
+
+BinaryWriter::BinaryWriter(std::FILE* file)
+    : m_file(file)
+{
+    m_buffer.reserve(WRITER_BUFFER_SIZE);
+}
+
+BinaryWriter::~BinaryWriter(){
+    flush();
+}
+
+void BinaryWriter::write_bytes(const void* data, size_t size){
+    m_position += size;
+    if(m_file && m_buffer.size() + size > WRITER_BUFFER_SIZE){
+        flush();
+        if(size >= WRITER_BUFFER_SIZE){
+            //A big block, like the items of a box : straight to the file
+            std::fwrite(data, 1, size, m_file);
+            return;
+        }
+    }
+    const std::byte* bytes = static_cast<const std::byte*>(data);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+}
+
+void BinaryWriter::align(size_t alignment){
+    static constexpr std::byte zeros[64] {};
+    size_t padding = (alignment - m_position % alignment) % alignment;
+    //alignas(128) and up need more than 64 bytes of padding
+    while(padding > 0){
+        size_t chunk = padding < sizeof(zeros) ? padding : sizeof(zeros);
+        write_bytes(zeros, chunk);
+        padding -= chunk;
+    }
+}
+
+void BinaryWriter::flush(){
+    if(m_file && !m_buffer.empty()){
+        std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_buffer.clear();
+    }
+}
+
+
+void write_header(BinaryWriter& writer){
+    serialize(writer, FileHeader{});
+}
+
+void read_header(BinaryReader& reader){
+    FileHeader expected;
+    FileHeader header = deserialize<FileHeader>(reader);
+    if(std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0)
+        throw serialization_error("not a serialized file");
+    if(header.byte_order != expected.byte_order)
+        throw serialization_error("file written on a machine of the other byte order");
+    if(header.version != expected.version)
+        throw serialization_error("unsupported file version");
+}
+
+
+MappedFile::MappedFile(const std::string& path)
+{
+#ifdef SERIALIZATION_MMAP
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if(descriptor < 0)
+        throw serialization_error("can't open " + path);
+    struct stat status {};
+    if(::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0){
+        m_size = static_cast<size_t>(status.st_size);
+        void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if(address != MAP_FAILED){
+            m_data = static_cast<const std::byte*>(address);
+            m_mapped = true;
+        }
+    }
+    ::close(descriptor);
+    if(m_mapped)
+        return;
+    m_size = 0;
+#endif
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+        throw serialization_error("can't open " + path);
+    std::vector<char> text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    m_buffer.resize(text.size());
+    std::memcpy(m_buffer.data(), text.data(), text.size());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+MappedFile::~MappedFile(){
+#ifdef SERIALIZATION_MMAP
+    if(m_mapped)
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+}
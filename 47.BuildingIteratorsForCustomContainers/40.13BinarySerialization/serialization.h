@@ -0,0 +1,366 @@
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "reflect.h"
+#include "boxcontainer.h"
+
+//A binary format, in place of the text operator<< : numbers are stored as
+//their bytes, so writing and reading them is a memcpy, not a conversion.
+//    save("box.bin", box);
+//    auto copy = load<BoxContainer<Point>>("box.bin");
+//    MappedBox<Point> view("box.bin");   // No copy at all, see below
+//What a type is written as is picked at compile time :
+//  - plain data ( numbers, structs of those, opted in types like Point ) :
+//    their bytes
+//  - std::string : a 64 bit length, then the characters
+//  - aggregates like Student : their fields, one after the other ( reflect.h )
+//  - classes with private data like Book : their own serialize member and
+//    static deserialize function
+//  - BoxContainer<T> : a 64 bit count, then the items. Trivially copyable
+//    items are stored as one block, aligned for T in the file, which is what
+//    lets MappedBox use them in place.
+//Types that fit none of these don't compile.
+//The bytes are those of this machine : a file records the byte order it
+//was written with, and loading it on a machine of the other order fails.
+
+class serialization_error : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+class BinaryWriter;
+class BinaryReader;
+
+//Opt in for trivially copyable classes that reflection can't look into,
+//like a Point with private members. Only for types holding no pointers :
+//    template <> inline constexpr bool enable_raw_serialization<Point> = true;
+template <typename T>
+inline constexpr bool enable_raw_serialization = false;
+
+template <typename T>
+concept CustomSerializable = requires (const T& object, BinaryWriter& writer, BinaryReader& reader){
+    object.serialize(writer);
+    { T::deserialize(reader) } -> std::same_as<T>;
+};
+
+template <typename T> struct is_box_container : std::false_type {};
+template <typename T> struct is_box_container<BoxContainer<T>> : std::true_type { using item_type = T; };
+
+//Written as raw bytes : numbers, enums, arrays of those, aggregates made
+//only of those, and opted in types. Being trivially copyable isn't enough :
+//std::string_view, std::span or a struct with a const char* member are
+//trivially copyable too, and their bytes are addresses, meaningless in a file.
+template <typename T>
+constexpr bool is_plain_data();
+
+template <typename... Fields>
+constexpr bool all_plain_data(type_list<Fields...>){
+    return (is_plain_data<Fields>() && ...);
+}
+
+template <typename T>
+constexpr bool is_plain_data(){
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        return true;
+    else if constexpr (std::is_array_v<T>)
+        return is_plain_data<std::remove_all_extents_t<T>>();
+    else if constexpr (enable_raw_serialization<T>)
+        return std::is_trivially_copyable_v<T>;
+    else if constexpr (Reflectable<T> && std::is_trivially_copyable_v<T>)
+        return all_plain_data(decltype(field_types<T>()){});
+    else
+        return false;
+}
+
+template <typename T>
+concept TriviallySerializable = is_plain_data<T>();
+
+//Everything serialize() knows how to write, checked all the way down : a
+//BoxContainer<std::string_view> or a Student with a const char* name
+//doesn't compile.
+template <typename T>
+constexpr bool is_serializable();
+
+template <typename... Fields>
+constexpr bool all_serializable(type_list<Fields...>){
+    return (is_serializable<Fields>() && ...);
+}
+
+template <typename T>
+constexpr bool is_serializable(){
+    if constexpr (TriviallySerializable<T> || CustomSerializable<T> || std::is_same_v<T, std::string>)
+        return true;
+    else if constexpr (is_box_container<T>::value)
+        return is_serializable<typename is_box_container<T>::item_type>();
+    else if constexpr (Reflectable<T>)
+        return all_serializable(decltype(field_types<T>()){});
+    else
+        return false;
+}
+
+template <typename T>
+concept Serializable = is_serializable<T>();
+
+
+//Appends to a byte vector, or streams to a file through a 1 MB buffer
+class BinaryWriter
+{
+public:
+    BinaryWriter() = default;                   // Into bytes()
+    explicit BinaryWriter(std::FILE* file);     // Into file, which must stay open
+    ~BinaryWriter();
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+    void write_bytes(const void* data, size_t size);
+    //Zero bytes up to the next multiple of alignment
+    void align(size_t alignment);
+
+    size_t position() const { return m_position; }
+    const std::vector<std::byte>& bytes() const { return m_buffer; }
+    void flush();
+
+private:
+    std::FILE* m_file {nullptr};
+    std::vector<std::byte> m_buffer;
+    size_t m_position {}; // Bytes written since the start
+};
+
+//Reads from bytes in memory : a buffer, or a mapped file. Throws
+//serialization_error instead of reading past the end.
+class BinaryReader
+{
+public:
+    explicit BinaryReader(std::span<const std::byte> bytes) : m_bytes(bytes) {}
+
+    //The next size bytes, in place
+    const std::byte* read_bytes(size_t size){
+        if(size > remaining())
+            throw serialization_error("unexpected end of data");
+        const std::byte* data = m_bytes.data() + m_position;
+        m_position += size;
+        return data;
+    }
+    void align(size_t alignment){
+        read_bytes((alignment - m_position % alignment) % alignment);
+    }
+
+    size_t position() const { return m_position; }
+    size_t remaining() const { return m_bytes.size() - m_position; }
+
+private:
+    std::span<const std::byte> m_bytes;
+    size_t m_position {};
+};
+
+
+template <Serializable T> void serialize(BinaryWriter& writer, const T& value);
+template <Serializable T> T deserialize(BinaryReader& reader);
+
+//The bytes of an array of count T, and count. Aligned for T in the data,
+//which may not make them aligned in memory.
+template <TriviallySerializable T>
+std::pair<const std::byte*, size_t> read_array_bytes(BinaryReader& reader){
+    std::uint64_t count = deserialize<std::uint64_t>(reader);
+    reader.align(alignof(T));
+    if(count > reader.remaining() / sizeof(T))
+        throw serialization_error("array longer than the data");
+    return {reader.read_bytes(static_cast<size_t>(count) * sizeof(T)), static_cast<size_t>(count)};
+}
+
+//The array, in place : the bytes must be aligned for T in memory too, as in
+//a mapped file. Used by MappedBox.
+template <TriviallySerializable T>
+std::span<const T> read_array_view(BinaryReader& reader){
+    auto [data, count] = read_array_bytes<T>(reader);
+    if(reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0)
+        throw serialization_error("array not aligned in memory");
+    //The bytes were written from T objects : they are T objects again
+    return {reinterpret_cast<const T*>(data), count};
+}
+
+template <Serializable T>
+void serialize(BinaryWriter& writer, const T& value){
+    if constexpr (TriviallySerializable<T>){
+        writer.write_bytes(&value, sizeof(T));
+    }else if constexpr (CustomSerializable<T>){
+        value.serialize(writer);
+    }else if constexpr (std::is_same_v<T, std::string>){
+        serialize(writer, static_cast<std::uint64_t>(value.size()));
+        writer.write_bytes(value.data(), value.size());
+    }else if constexpr (is_box_container<T>::value){
+        using Item = std::remove_cvref_t<decltype(*value.data())>;
+        serialize(writer, static_cast<std::uint64_t>(value.size()));
+        if constexpr (TriviallySerializable<Item>){
+            writer.align(alignof(Item));
+            writer.write_bytes(value.data(), value.size() * sizeof(Item));
+        }else{
+            for(size_t i{}; i < value.size(); ++i)
+                serialize(writer, value.data()[i]);
+        }
+    }else{
+        for_each_field(value, [&](const auto& field){
+            serialize(writer, field);
+        });
+    }
+}
+
+template <Serializable T>
+T deserialize(BinaryReader& reader){
+    if constexpr (TriviallySerializable<T>){
+        T value;
+        std::memcpy(&value, reader.read_bytes(sizeof(T)), sizeof(T));
+        return value;
+    }else if constexpr (CustomSerializable<T>){
+        return T::deserialize(reader);
+    }else if constexpr (std::is_same_v<T, std::string>){
+        std::uint64_t size = deserialize<std::uint64_t>(reader);
+        //Checked before allocating : a corrupt length can't ask for gigabytes
+        if(size > reader.remaining())
+            throw serialization_error("string longer than the data");
+        const std::byte* data = reader.read_bytes(static_cast<size_t>(size));
+        return std::string(reinterpret_cast<const char*>(data), static_cast<size_t>(size));
+    }else if constexpr (is_box_container<T>::value){
+        using Item = std::remove_cvref_t<decltype(*std::declval<const T&>().data())>;
+        if constexpr (TriviallySerializable<Item>){
+            //Copied out item by item : works whatever the alignment of the
+            //buffer in memory, unlike read_array_view
+            auto [data, count] = read_array_bytes<Item>(reader);
+            T box(count); // Exact capacity : add never expands
+            for(size_t i{}; i < count; ++i){
+                Item item;
+                std::memcpy(&item, data + i * sizeof(Item), sizeof(Item));
+                box.add(item);
+            }
+            return box;
+        }else{
+            std::uint64_t count = deserialize<std::uint64_t>(reader);
+            if(count > reader.remaining()) // Every item takes at least a byte
+                throw serialization_error("box longer than the data");
+            T box(static_cast<size_t>(count));
+            for(std::uint64_t i{}; i < count; ++i)
+                box.add(deserialize<Item>(reader));
+            return box;
+        }
+    }else{
+        T value {};
+        for_each_field(value, [&](auto& field){
+            field = deserialize<std::remove_cvref_t<decltype(field)>>(reader);
+        });
+        return value;
+    }
+}
+
+//Round trip through memory
+template <Serializable T>
+std::vector<std::byte> to_bytes(const T& value){
+    BinaryWriter writer;
+    serialize(writer, value);
+    return writer.bytes();
+}
+
+template <Serializable T>
+T from_bytes(std::span<const std::byte> bytes){
+    BinaryReader reader(bytes);
+    return deserialize<T>(reader);
+}
+
+
+//Files start with this header
+struct FileHeader
+{
+    char magic[4] {'B', 'O', 'X', 'B'};
+    std::uint32_t version {1};
+    std::uint32_t byte_order {0x01020304}; // Reads back as 0x04030201 on the other order
+    std::uint32_t reserved {};
+};
+
+//Has an array member, which reflection can't handle
+template <>
+inline constexpr bool enable_raw_serialization<FileHeader> = true;
+
+void write_header(BinaryWriter& writer);
+void read_header(BinaryReader& reader); // Throws serialization_error if it doesn't fit
+
+//A whole file in memory, mapped on Linux, read into a buffer elsewhere.
+//Throws serialization_error if the file can't be read.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const std::byte> bytes() const { return {m_data, m_size}; }
+
+private:
+    const std::byte* m_data {nullptr};
+    size_t m_size {};
+    bool m_mapped {false};
+    std::vector<std::byte> m_buffer;
+};
+
+template <Serializable T>
+void save(const std::string& path, const T& value){
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if(!file)
+        throw serialization_error("can't create " + path);
+    {
+        BinaryWriter writer(file);
+        write_header(writer);
+        serialize(writer, value);
+    }
+    bool failed = std::ferror(file) != 0;
+    if(std::fclose(file) != 0 || failed)
+        throw serialization_error("can't write " + path);
+}
+
+template <Serializable T>
+T load(const std::string& path){
+    MappedFile file(path);
+    BinaryReader reader(file.bytes());
+    read_header(reader);
+    return deserialize<T>(reader);
+}
+
+//A box of trivially copyable items saved with save(), used straight from
+//the mapped file : opening it reads nothing but the header, and items are
+//brought in from the disk as they are touched.
+template <TriviallySerializable T>
+class MappedBox
+{
+public:
+    explicit MappedBox(const std::string& path)
+        : m_file(path)
+    {
+        BinaryReader reader(m_file.bytes());
+        read_header(reader);
+        m_items = read_array_view<T>(reader);
+    }
+
+    size_t size() const { return m_items.size(); }
+    const T& operator[](size_t index) const { return m_items[index]; }
+    const T* begin() const { return m_items.data(); }
+    const T* end() const { return m_items.data() + m_items.size(); }
+    std::span<const T> items() const { return m_items; }
+
+private:
+    MappedFile m_file;
+    std::span<const T> m_items;
+};
+
+#endif // SERIALIZATION_H